@@ -35,7 +35,7 @@
 #
 ##########################################################################
 
-import os, sys, traceback
+import os, sys, ast, traceback
 
 import imath
 
@@ -60,6 +60,13 @@ class execute( Gaffer.Application ) :
 			```
 			gaffer execute -script comp.gfr -nodes ImageWriter -frames 1-10
 			```
+
+			When run with `-worker`, the script is loaded once and then
+			execution requests are read from stdin, one per line, with the
+			exit status of each being written to stdout. This allows a
+			dispatcher to execute many tasks without the cost of starting a
+			new process and loading the script for each, and with the compute
+			cache preserved between tasks.
 			"""
 		)
 
@@ -109,6 +116,18 @@ class execute( Gaffer.Application ) :
 					},
 				),
 
+				IECore.BoolParameter(
+					name = "worker",
+					description = "Runs as a persistent worker process. Rather than "
+						"executing immediately, requests are read from stdin, one per "
+						"line, each being the repr() of a dictionary with optional "
+						"\"nodes\", \"frames\" and \"context\" entries with the same "
+						"meaning as the equivalent parameters. The exit status of each "
+						"request is written to stdout on a line of its own, and the "
+						"worker exits when stdin is closed.",
+					defaultValue = False,
+				),
+
 			]
 
 		)
@@ -131,9 +150,45 @@ class execute( Gaffer.Application ) :
 
 		self.root()["scripts"].addChild( scriptNode )
 
+		if args["worker"].value :
+			return self.__runWorker( scriptNode )
+
+		frames = self.parameters()["frames"].getFrameListValue().asList()
+		return self.__execute( scriptNode, list( args["nodes"] ), frames, list( args["context"] ) )
+
+	def __runWorker( self, scriptNode ) :
+
+		# Output from the tasks themselves must not be confused with
+		# our responses, so we keep the original stdout for ourselves
+		# and redirect everything else to stderr.
+		sys.stdout.flush()
+		responses = os.fdopen( os.dup( sys.stdout.fileno() ), "w" )
+		os.dup2( sys.stderr.fileno(), sys.stdout.fileno() )
+
+		while True :
+
+			line = sys.stdin.readline()
+			if not line :
+				return 0
+
+			try :
+				request = ast.literal_eval( line )
+				frames = IECore.FrameList.parse( request.get( "frames", "" ) ).asList()
+				result = self.__execute( scriptNode, request.get( "nodes", [] ), frames, request.get( "context", [] ) )
+			except Exception as exception :
+				IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Invalid request : %s" % exception )
+				result = 1
+
+			sys.stdout.flush()
+			sys.stderr.flush()
+			responses.write( "%d\n" % result )
+			responses.flush()
+
+	def __execute( self, scriptNode, nodeNames, frames, contextArgs ) :
+
 		nodes = []
-		if len( args["nodes"] ) :
-			for nodeName in args["nodes"] :
+		if len( nodeNames ) :
+			for nodeName in nodeNames :
 				node = scriptNode.descendant( nodeName )
 				if node is None :
 					IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Node \"%s\" does not exist" % nodeName )
@@ -150,16 +205,15 @@ class execute( Gaffer.Application ) :
 				IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Script has no executable nodes" )
 				return 1
 
-		if len(args["context"]) % 2 :
+		if len( contextArgs ) % 2 :
 			IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Context parameter must have matching entry/value pairs" )
 			return 1
 
 		context = Gaffer.Context( scriptNode.context() )
-		for i in range( 0, len(args["context"]), 2 ) :
-			entry = args["context"][i].lstrip( "-" )
-			context[entry] = eval( args["context"][i+1] )
+		for i in range( 0, len( contextArgs ), 2 ) :
+			entry = contextArgs[i].lstrip( "-" )
+			context[entry] = eval( contextArgs[i+1] )
 
-		frames = self.parameters()["frames"].getFrameListValue().asList()
 		if not frames :
 			frames = [ scriptNode.context().getFrame() ]
 
@@ -219,6 +219,10 @@ class GAFFER_API Expression : public ComputeNode
 		void plugSet( const Plug *plug );
 
 		EnginePtr m_engine;
+		// Executes Python expressions natively where possible,
+		// to avoid contention for the GIL. Null if the expression
+		// must be executed by `m_engine`.
+		EnginePtr m_nativeEngine;
 		std::vector<IECore::InternedString> m_contextNames;
 
 		ExpressionChangedSignal m_expressionChangedSignal;
@@ -281,14 +281,21 @@ class GAFFER_API GraphComponent : public IECore::RunTimeTyped, public boost::sig
 		void addChildInternal( GraphComponentPtr child, size_t index );
 		void removeChildInternal( GraphComponentPtr child, bool emitParentChanged );
 		size_t index() const;
+		const GraphComponent *indexedChild( const IECore::InternedString &name ) const;
 
 		struct Signals;
 		Signals *signals();
 
+		// Auxiliary index used to accelerate lookups
+		// by name when there are many children. Null
+		// until the number of children warrants it.
+		struct ChildNameIndex;
+
 		std::unique_ptr<Signals> m_signals;
 		IECore::InternedString m_name;
 		GraphComponent *m_parent;
 		ChildContainer m_children;
+		std::unique_ptr<ChildNameIndex> m_childNameIndex;
 
 };
 
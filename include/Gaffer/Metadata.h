@@ -47,6 +47,7 @@
 #include "boost/signals.hpp"
 
 #include <functional>
+#include <vector>
 
 namespace Gaffer
 {
@@ -124,6 +125,13 @@ class GAFFER_API Metadata
 		template<typename T=IECore::Data>
 		static typename T::ConstPtr value( const GraphComponent *target, IECore::InternedString key, bool instanceOnly = false );
 
+		typedef std::vector<std::pair<const Plug *, IECore::ConstDataPtr>> PlugValues;
+		/// Retrieves the values for all plug descendants of `root` in a single call,
+		/// omitting plugs without a value. This is significantly quicker than calling
+		/// `value()` for each plug in turn, because the lookups for their ancestors
+		/// are shared.
+		static PlugValues plugValues( const GraphComponent *root, IECore::InternedString key, bool instanceOnly = false );
+
 		/// Value deregistration
 		/// ====================
 
@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_PRIVATE_NATIVEEXPRESSIONENGINE_H
+#define GAFFER_PRIVATE_NATIVEEXPRESSIONENGINE_H
+
+#include "Gaffer/Expression.h"
+
+namespace Gaffer
+{
+
+namespace Private
+{
+
+/// Returns an Engine which executes a Python `expression` natively,
+/// without acquiring the GIL, or null if the expression uses features
+/// of Python that are not supported. Supported expressions consist of
+/// plug and local variable assignments using literals, arithmetic, string
+/// formatting, comparisons and conditionals, context access, and simple
+/// builtin and `math` functions, acting on Int, Float, Bool and String
+/// plugs.
+///
+/// The `inputs` and `outputs` must be the plugs returned by the
+/// Python engine's `parse()` method, as they define the order of the
+/// `proxyInputs` passed to `execute()` and the order of its results.
+///
+/// Where the engine encounters values it cannot process with exactly
+/// Python's semantics (for instance, integer overflow or division by
+/// zero), `execute()` returns null and the expression must be executed
+/// by the Python engine instead.
+GAFFER_API Expression::EnginePtr createNativeExpressionEngine( const Expression *node, const std::string &expression, const std::vector<ValuePlug *> &inputs, const std::vector<ValuePlug *> &outputs );
+
+} // namespace Private
+
+} // namespace Gaffer
+
+#endif // GAFFER_PRIVATE_NATIVEEXPRESSIONENGINE_H
@@ -41,6 +41,8 @@
 #include "Gaffer/NumericPlug.h"
 #include "Gaffer/TypedObjectPlug.h"
 
+#include <atomic>
+
 namespace Gaffer
 {
 
@@ -206,6 +208,32 @@ class GAFFER_API Spreadsheet : public ComputeNode
 		IntPlug *rowIndexPlug();
 		const IntPlug *rowIndexPlug() const;
 
+		// Lookup structure used to accelerate the computation of
+		// `rowIndexPlug()`. Computed from the row names alone, so
+		// it is shared by all values of the selector.
+		CompoundObjectPlug *rowsMapPlug();
+		const CompoundObjectPlug *rowsMapPlug() const;
+
+		// Return the hash and value of `rowsMapPlug()`. When the rows
+		// don't depend on the context, these are evaluated in a fixed
+		// context, so that the per-selector cost doesn't depend on the
+		// number of rows.
+		IECore::MurmurHash rowsMapHash() const;
+		IECore::ConstCompoundObjectPtr rowsMap() const;
+		bool rowsAreContextIndependent() const;
+
+		void plugDirtied( const Plug *plug );
+
+		// Caches the result of `rowsAreContextIndependent()`, and is
+		// reset by `plugDirtied()`.
+		enum class RowsContextDependency
+		{
+			Unknown,
+			Independent,
+			Dependent
+		};
+		mutable std::atomic<RowsContextDependency> m_rowsContextDependency;
+
 		const ValuePlug *correspondingInput( const Plug *output, size_t rowIndex ) const;
 
 		static size_t g_firstPlugIndex;
@@ -42,6 +42,7 @@
 
 #include "Gaffer/CatchingSignalCombiner.h"
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
 
 #include "IECore/CompoundData.h"
 #include "IECore/FrameList.h"
@@ -177,6 +178,21 @@ class GAFFERDISPATCH_API Dispatcher : public Gaffer::Node
 		const std::string jobDirectory() const;
 		//@}
 
+		//! @name Incremental dispatch
+		/// Dispatchers may skip tasks which have been executed by a previous
+		/// dispatch and whose results are still up to date. Each executed task
+		/// is recorded in a manifest stored alongside the job directories, keyed
+		/// by the task's hash and the node it belongs to. A task is skipped if
+		/// its hash matches a record, the files named by its `dispatcher.outputFiles`
+		/// plug are unchanged since it was recorded, and all its preTasks are
+		/// being skipped too.
+		//////////////////////////////////////////////////////////////////////////
+		//@{
+		/// Turns on incremental dispatch.
+		Gaffer::BoolPlug *skipUpToDateTasksPlug();
+		const Gaffer::BoolPlug *skipUpToDateTasksPlug() const;
+		//@}
+
 		/// A function which creates a Dispatcher.
 		typedef std::function<DispatcherPtr ()> Creator;
 		/// SetupPlugsFn may be registered along with a Dispatcher Creator. It will be called by setupPlugs,
@@ -211,6 +227,7 @@ class GAFFERDISPATCH_API Dispatcher : public Gaffer::Node
 	protected :
 
 		friend class TaskNode;
+		friend class TaskNode::TaskPlug;
 
 		IE_CORE_FORWARDDECLARE( TaskBatch )
 
@@ -283,6 +300,10 @@ class GAFFERDISPATCH_API Dispatcher : public Gaffer::Node
 
 		void executeAndPruneImmediateBatches( TaskBatch *batch, bool immediate = false ) const;
 
+		// Called by TaskPlug after successful execution, to record the task
+		// for the current context in the manifest, if one is in use.
+		static void recordExecutedTask( const TaskNode::TaskPlug *plug );
+
 		typedef std::map<std::string, std::pair<Creator, SetupPlugsFn> > CreatorMap;
 		static CreatorMap &creators();
 
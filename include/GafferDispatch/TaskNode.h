@@ -224,6 +224,13 @@ class GAFFERDISPATCH_API TaskNode : public Gaffer::DependencyNode
 		/// \todo Add `const TaskPlug *plug, const Context *context` arguments.
 		virtual bool requiresSequenceExecution() const;
 
+		/// Utility which may be used to implement `executeSequence()` for nodes
+		/// whose frames are independent of one another, and whose `execute()`
+		/// method is threadsafe. Calls `execute()` for up to `maxFramesInFlight`
+		/// frames concurrently, allowing any frame-invariant upstream computes
+		/// to be shared via the cache.
+		void executeSequenceInParallel( const std::vector<float> &frames, size_t maxFramesInFlight ) const;
+
 	private :
 
 		// Friendship for the bindings.
@@ -82,6 +82,13 @@ class GAFFERIMAGE_API ChannelDataProcessor : public ImageProcessor
 		/// @param outData The tile where the result of the operation should be written. It is initialized with the coresponding tile data from inPlug() which should be used as the input data.
 		virtual void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, IECore::FloatVectorDataPtr outData ) const = 0;
 
+		/// May be implemented to return true by derived classes whose processChannelData()
+		/// treats every pixel independently and identically. When the input tile is an
+		/// `ImagePlug::uniformTile()`, processChannelData() will then be called with
+		/// a single pixel of data and a uniform tile will be output. The default
+		/// implementation returns false.
+		virtual bool processesUniformTiles() const;
+
 		void hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 
 	private :
@@ -196,6 +196,18 @@ class GAFFERIMAGE_API ImagePlug : public Gaffer::ValuePlug
 		static const IECore::FloatVectorData *emptyTile();
 		static const IECore::FloatVectorData *blackTile();
 		static const IECore::FloatVectorData *whiteTile();
+		/// Returns a shared tile with every pixel set to `value`. Nodes which
+		/// know their output is uniform should return this rather than allocate
+		/// a tile of their own, so that downstream nodes can use `uniformTileValue()`
+		/// to process the tile as a single value. `uniformTile( 0 )` is `blackTile()`
+		/// and `uniformTile( 1 )` is `whiteTile()`.
+		static IECore::ConstFloatVectorDataPtr uniformTile( float value );
+		/// Returns true if `tile` was returned by `uniformTile()`, filling `value`
+		/// with the value of its pixels. This is a constant time lookup, so false
+		/// does not guarantee that a tile isn't uniform, only that it isn't known to be.
+		/// Only a limited number of recently used values are tracked, so tiles for
+		/// values which have since been evicted are no longer recognised.
+		static bool uniformTileValue( const IECore::FloatVectorData *tile, float &value );
 
 		inline static int tileSize() { return 1 << tileSizeLog2(); };
 		inline static int tilePixels() { return tileSize() * tileSize(); };
@@ -43,6 +43,7 @@
 #include "Gaffer/BoxPlug.h"
 #include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/ComputeNode.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 namespace GafferImage
 {
@@ -87,6 +88,9 @@ class GAFFERIMAGE_API ImageStats : public Gaffer::ComputeNode
 		/// Computes the min, max and average plugs by analyzing the input ImagePlug.
 		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
 
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
+		Gaffer::ValuePlug::CachePolicy hashCachePolicy( const Gaffer::ValuePlug *output ) const override;
+
 	private :
 
 		// Input plug to receive the flattened image from the internal
@@ -98,6 +102,19 @@ class GAFFERIMAGE_API ImageStats : public Gaffer::ComputeNode
 		GafferImage::DeepState *deepState();
 		const GafferImage::DeepState *deepState() const;
 
+		// Min, max and sum for the pixels of a single tile within the
+		// data window, computed in a context with a channel name and tile
+		// origin. These are independent of the area, so are reused when
+		// the area changes.
+		Gaffer::ObjectPlug *tileStatsPlug();
+		const Gaffer::ObjectPlug *tileStatsPlug() const;
+
+		// Min, max and average for a whole channel, computed in a context
+		// with a channel name. All outputs are computed from this in a
+		// single pass over the image.
+		Gaffer::ObjectPlug *allStatsPlug();
+		const Gaffer::ObjectPlug *allStatsPlug() const;
+
 		std::string channelName( int colorIndex ) const;
 
 		static size_t g_firstPlugIndex;
@@ -42,6 +42,8 @@
 
 #include "GafferDispatch/TaskNode.h"
 
+#include "Gaffer/NumericPlug.h"
+
 #include "IECore/CompoundData.h"
 
 #include <functional>
@@ -89,12 +91,18 @@ class GAFFERIMAGE_API ImageWriter : public GafferDispatch::TaskNode
 		Gaffer::StringPlug *colorSpacePlug();
 		const Gaffer::StringPlug *colorSpacePlug() const;
 
+		/// The maximum number of frames to write concurrently when
+		/// a batch of several frames is executed.
+		Gaffer::IntPlug *framesInParallelPlug();
+		const Gaffer::IntPlug *framesInParallelPlug() const;
+
 		Gaffer::ValuePlug *fileFormatSettingsPlug( const std::string &fileFormat );
 		const Gaffer::ValuePlug *fileFormatSettingsPlug( const std::string &fileFormat ) const;
 
 		IECore::MurmurHash hash( const Gaffer::Context *context ) const override;
 
 		void execute() const override;
+		void executeSequence( const std::vector<float> &frames ) const override;
 
 		const std::string currentFileFormat() const;
 
@@ -53,9 +53,6 @@ namespace GafferImage
 ///   of all input windows, rather than the union.
 /// - For some operations (add for instance) we could entirely skip invalid input tiles, and tiles
 ///   where channelData == ImagePlug::blackTile().
-/// - For some operations we do not need to track the intermediate alpha values at all.
-/// - We could improve our masking of invalid pixels with special cases for wholly valid tiles,
-///   wholly invalid tiles, and by chunking the work on the valid sections.
 class GAFFERIMAGE_API Merge : public FlatImageProcessor
 {
 
@@ -105,9 +102,11 @@ class GAFFERIMAGE_API Merge : public FlatImageProcessor
 
 	private :
 
-		// Performs the merge operation using the functor 'F'.
-		template<typename F>
-		IECore::ConstFloatVectorDataPtr merge( F f, const std::string &channelName, const Imath::V2i &tileOrigin ) const;
+		// Performs the merge operation using the function 'F'. Taking the
+		// function as a template parameter gives us a dedicated kernel for
+		// each operation.
+		template<float (*F)( float A, float B, float a, float b )>
+		IECore::ConstFloatVectorDataPtr merge( Operation operation, const std::string &channelName, const Imath::V2i &tileOrigin ) const;
 
 		static size_t g_firstPlugIndex;
 
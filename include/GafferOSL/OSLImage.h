@@ -93,14 +93,14 @@ class GAFFEROSL_API OSLImage : public GafferImage::ImageProcessor
 		// computeChannelData() is called for individual channels at a time, but when we run a
 		// shader we get all the outputs at once. we therefore use this plug to compute (and
 		// automatically cache) the shading and then access it from computeChannelData(), which
-		// simply extracts the right part of the data.
-		/// \todo Investigate turning off caching for the channelData plug, since we're currently
-		/// caching once there and once in the shadingPlug.
+		// simply extracts the right part of the data. To give the ShadingEngine more work per
+		// call, the shading is computed for a horizontal batch of tiles at once, with the
+		// results for each output stored as an ObjectVector of per-tile FloatVectorData.
 		Gaffer::ObjectPlug *shadingPlug();
 		const Gaffer::ObjectPlug *shadingPlug() const;
 
 		void hashShading( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
-		IECore::ConstCompoundDataPtr computeShading( const Gaffer::Context *context ) const;
+		IECore::ConstCompoundObjectPtr computeShading( const Gaffer::Context *context ) const;
 
 		GafferOSL::OSLCode *oslCode();
 		const GafferOSL::OSLCode *oslCode() const;
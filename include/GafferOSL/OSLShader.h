@@ -42,6 +42,16 @@
 
 #include "GafferScene/Shader.h"
 
+#include <memory>
+
+namespace Gaffer
+{
+
+class BackgroundTask;
+class ScriptNode;
+
+} // namespace Gaffer
+
 namespace GafferOSL
 {
 
@@ -67,6 +77,13 @@ class GAFFEROSL_API OSLShader : public GafferScene::Shader
 		void reloadShader() override;
 
 		ConstShadingEnginePtr shadingEngine() const;
+		/// Launches a BackgroundTask which constructs the ShadingEngines used
+		/// by all the OSLObject and OSLImage nodes in `script`, in parallel and
+		/// using the script's context. Optimising and compiling a large shader
+		/// group can take several seconds, so this may be called after loading
+		/// a script to avoid paying that cost when the network is first used.
+		/// Errors are ignored, since they are reported when the network is used.
+		static std::unique_ptr<Gaffer::BackgroundTask> prewarmShadingEngines( const Gaffer::ScriptNode *script );
 
 		/// Returns an OSL metadata item from the shader.
 		const IECore::Data *shaderMetadata( const IECore::InternedString &name ) const;
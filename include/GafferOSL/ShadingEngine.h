@@ -91,6 +91,9 @@ class GAFFEROSL_API ShadingEngine : public IECore::RefCounted
 	private :
 
 		void queryShaderGroup();
+		// Returns true if the shader reads any of the `points` data which
+		// varies from point to point.
+		bool varyingInputsNeeded( const IECore::CompoundData *points ) const;
 
 		const IECore::MurmurHash m_hash;
 
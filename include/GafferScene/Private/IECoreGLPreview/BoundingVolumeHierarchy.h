@@ -0,0 +1,168 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECOREGLPREVIEW_BOUNDINGVOLUMEHIERARCHY_H
+#define IECOREGLPREVIEW_BOUNDINGVOLUMEHIERARCHY_H
+
+#include "GafferScene/Export.h"
+
+#include "OpenEXR/ImathBox.h"
+#include "OpenEXR/ImathMatrix.h"
+#include "OpenEXR/ImathPlane.h"
+
+#include <vector>
+
+namespace IECoreGLPreview
+{
+
+/// Spatial index for a set of items with bounds, identified by
+/// integer ids. Used by the OpenGL renderer to cull objects outside the
+/// viewing frustum, but has no dependency on OpenGL itself.
+///
+/// Edits are applied incrementally : changing the bound of an item
+/// refits only its ancestors in the tree. Added and removed items are
+/// accumulated until the next query, which rebuilds the tree if there
+/// are enough of them to make it worthwhile.
+class GAFFERSCENE_API BoundingVolumeHierarchy
+{
+
+	public :
+
+		BoundingVolumeHierarchy();
+		~BoundingVolumeHierarchy();
+
+		/// Sets the bound for the item with the specified id, adding the
+		/// item if necessary. Items with empty bounds cannot be culled, and
+		/// are returned by every query.
+		void set( size_t id, const Imath::Box3f &bound );
+		void remove( size_t id );
+		void clear();
+
+		/// Returns the number of items.
+		size_t size() const;
+
+		/// Planes bounding a convex volume, with normals pointing
+		/// inwards.
+		typedef std::vector<Imath::Plane3f> Planes;
+
+		/// Returns the planes bounding the portion of the viewing volume
+		/// defined by `worldToClip` which projects into `region`. The region
+		/// is specified in normalised device coordinates, so the default
+		/// provides the whole volume, and a smaller region can be used to
+		/// find candidates for selection within a box or below a pixel.
+		static Planes frustumPlanes( const Imath::M44f &worldToClip, const Imath::Box2f &region = Imath::Box2f( Imath::V2f( -1 ), Imath::V2f( 1 ) ) );
+
+		struct Statistics
+		{
+			Statistics();
+			/// The total number of items.
+			size_t items;
+			/// The number of items returned by the query.
+			size_t itemsReturned;
+			/// The number of items whose bounds were tested individually.
+			size_t itemsTested;
+			/// The number of tree nodes whose bounds were tested.
+			size_t nodesTested;
+		};
+
+		/// Fills `ids` with the items which may intersect the volume bounded
+		/// by `planes`, in ascending order. Items are only excluded if they
+		/// are certain to be outside the volume.
+		void query( const Planes &planes, std::vector<size_t> &ids, Statistics *statistics = nullptr );
+
+	private :
+
+		enum class State : unsigned char
+		{
+			Absent,
+			Tree,
+			Pending,
+			Unbounded
+		};
+
+		struct Item
+		{
+			Item();
+			Imath::Box3f bound;
+			size_t leaf;
+			State state;
+			bool pendingListed;
+			bool unboundedListed;
+		};
+
+		// Nodes are stored depth first, so the first child of an
+		// internal node immediately follows it.
+		struct Node
+		{
+			Imath::Box3f bound;
+			size_t parent;
+			// For leaves, the start of the range of item ids in
+			// `m_leafItems`. For internal nodes, the index of the
+			// second child.
+			size_t first;
+			// The number of items in a leaf, or 0 for internal nodes.
+			size_t count;
+		};
+
+		struct BuildItem
+		{
+			Imath::Box3f bound;
+			Imath::V3f centroid;
+			size_t id;
+		};
+
+		void update();
+		void build();
+		size_t buildWalk( std::vector<BuildItem>::iterator begin, std::vector<BuildItem>::iterator end, size_t parent );
+		void removeFromTree( size_t id );
+		void refit( size_t leaf );
+		void queryWalk( const Planes &planes, std::vector<size_t> &ids, Statistics &statistics ) const;
+
+		std::vector<Item> m_items;
+		std::vector<Node> m_nodes;
+		std::vector<size_t> m_leafItems;
+		// Items added since the tree was built.
+		std::vector<size_t> m_pending;
+		std::vector<size_t> m_unbounded;
+		size_t m_size;
+		size_t m_treeSize;
+		size_t m_staleLeafItems;
+
+};
+
+} // namespace IECoreGLPreview
+
+#endif // IECOREGLPREVIEW_BOUNDINGVOLUMEHIERARCHY_H
@@ -104,6 +104,10 @@ class IECORESCENE_API CapturingRenderer : public Renderer
 				int numAttributeEdits() const;
 				int numLinkEdits( const IECore::InternedString &type ) const;
 
+				/// Objects are given increasing ids in the order they
+				/// are created, so the order of output can be tested.
+				size_t id() const;
+
 				/// Renderer interface
 				/// ==================
 
@@ -120,6 +124,7 @@ class IECORESCENE_API CapturingRenderer : public Renderer
 
 				CapturingRenderer *m_renderer;
 				const std::string m_name;
+				const size_t m_id;
 				const std::vector<IECore::ConstObjectPtr> m_capturedSamples;
 				const std::vector<float> m_capturedSampleTimes;
 				ConstCapturedAttributesPtr m_capturedAttributes;
@@ -152,6 +157,7 @@ class IECORESCENE_API CapturingRenderer : public Renderer
 		void checkPaused() const;
 
 		std::atomic_bool m_rendering;
+		std::atomic<size_t> m_nextObjectId;
 		using ObjectMap = tbb::concurrent_hash_map<std::string, const CapturedObject *>;
 		ObjectMap m_capturedObjects;
 
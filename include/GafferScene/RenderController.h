@@ -74,6 +74,16 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 		void setMinimumExpansionDepth( size_t depth );
 		size_t getMinimumExpansionDepth() const;
 
+		/// Specifies a view used to prioritise background updates, so that
+		/// locations visible in it are updated before the rest of the scene,
+		/// nearest first. `worldToClip` is the combined view and projection
+		/// matrix, mapping the visible region to the [-1, 1] clip volume as
+		/// in OpenGL. Changing the view doesn't cancel an update in progress,
+		/// but is used by subsequent updates.
+		void setPriorityView( const Imath::M44f &worldToClip );
+		/// Removes the view specified by `setPriorityView()`.
+		void clearPriorityView();
+
 		typedef boost::signal<void (RenderController &)> UpdateRequiredSignal;
 		UpdateRequiredSignal &updateRequiredSignal();
 
@@ -104,7 +114,7 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 		void dirtyGlobals( unsigned components );
 		void dirtySceneGraphs( unsigned components );
 
-		void updateInternal( const ProgressCallback &callback = ProgressCallback(), const IECore::PathMatcher *pathsToUpdate = nullptr );
+		void updateInternal( const ProgressCallback &callback = ProgressCallback(), const IECore::PathMatcher *pathsToUpdate = nullptr, const Imath::M44f *priorityView = nullptr );
 		void updateDefaultCamera();
 		void cancelBackgroundTask();
 
@@ -117,6 +127,8 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 
 		IECore::PathMatcher m_expandedPaths;
 		size_t m_minimumExpansionDepth;
+		bool m_priorityViewEnabled;
+		Imath::M44f m_priorityView;
 
 		boost::signals::scoped_connection m_plugDirtiedConnection;
 		boost::signals::scoped_connection m_contextChangedConnection;
@@ -39,10 +39,15 @@
 
 #include "GafferTest/Export.h"
 
+#include "Gaffer/GraphComponent.h"
+
 namespace GafferTest
 {
 
 GAFFERTEST_API void testMetadataThreading();
+/// Queries `key` for every plug below `root`, either one plug at a time
+/// or using `Metadata::plugValues()`, returning the number of values found.
+GAFFERTEST_API size_t testMetadataValuePerformance( const Gaffer::GraphComponent *root, IECore::InternedString key, bool bulk );
 
 } // namespace GafferTest
 
@@ -39,6 +39,8 @@
 
 #include "IECore/Canceller.h"
 
+#include <atomic>
+
 namespace GafferVDB
 {
 
@@ -60,20 +62,11 @@ class Interrupter {
 		{
 		}
 
+		// May be called concurrently, so a single Interrupter can
+		// be shared by all the threads of a parallel operation.
 		bool wasInterrupted( int percent = -1 )
 		{
-			if ( m_interrupted )
-			{
-				return true;
-			}
-
-			// todo this a a problem installing a exception handler
-			// per a call to this function.
-			try
-			{
-				IECore::Canceller::check( m_canceller );
-			}
-			catch( const IECore::Cancelled& )
+			if( !m_interrupted && m_canceller && m_canceller->cancelled() )
 			{
 				m_interrupted = true;
 			}
@@ -82,7 +75,7 @@ class Interrupter {
 		}
 	private:
 		const IECore::Canceller* m_canceller;
-		bool m_interrupted;
+		std::atomic_bool m_interrupted;
 
 };
 
@@ -42,6 +42,7 @@
 
 #include "GafferScene/SceneElementProcessor.h"
 
+#include "Gaffer/BoxPlug.h"
 #include "Gaffer/NumericPlug.h"
 #include "Gaffer/StringPlug.h"
 
@@ -67,6 +68,12 @@ class GAFFERVDB_API LevelSetToMesh : public GafferScene::SceneElementProcessor
 		Gaffer::FloatPlug *adaptivityPlug();
 		const Gaffer::FloatPlug *adaptivityPlug() const;
 
+		Gaffer::BoolPlug *clipPlug();
+		const Gaffer::BoolPlug *clipPlug() const;
+
+		Gaffer::Box3fPlug *clipBoundPlug();
+		const Gaffer::Box3fPlug *clipBoundPlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 	protected :
@@ -43,6 +43,7 @@
 #include "GafferScene/SceneElementProcessor.h"
 
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
 
 namespace Gaffer
 {
@@ -74,6 +75,9 @@ class GAFFERVDB_API MeshToLevelSet : public GafferScene::SceneElementProcessor
 		Gaffer::FloatPlug *interiorBandwidthPlug();
 		const Gaffer::FloatPlug *interiorBandwidthPlug() const;
 
+		Gaffer::BoolPlug *mergeDescendantsPlug();
+		const Gaffer::BoolPlug *mergeDescendantsPlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 	protected :
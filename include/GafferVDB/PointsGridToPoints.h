@@ -42,6 +42,7 @@
 
 #include "GafferScene/SceneElementProcessor.h"
 
+#include "Gaffer/BoxPlug.h"
 #include "Gaffer/NumericPlug.h"
 
 namespace Gaffer
@@ -71,6 +72,12 @@ class GAFFERVDB_API PointsGridToPoints : public GafferScene::SceneElementProcess
 		Gaffer::BoolPlug *invertNamesPlug();
 		const Gaffer::BoolPlug *invertNamesPlug() const;
 
+		Gaffer::BoolPlug *clipPlug();
+		const Gaffer::BoolPlug *clipPlug() const;
+
+		Gaffer::Box3fPlug *clipBoundPlug();
+		const Gaffer::Box3fPlug *clipBoundPlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 	protected :
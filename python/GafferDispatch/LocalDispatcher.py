@@ -36,6 +36,7 @@
 
 import os
 import errno
+import Queue
 import signal
 import shlex
 import subprocess32 as subprocess
@@ -57,6 +58,8 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 		self["executeInBackground"] = Gaffer.BoolPlug( defaultValue = False )
 		self["ignoreScriptLoadErrors"] = Gaffer.BoolPlug( defaultValue = False )
 		self["environmentCommand"] = Gaffer.StringPlug()
+		self["maxConcurrentTasks"] = Gaffer.IntPlug( defaultValue = 1, minValue = 1 )
+		self["reuseProcesses"] = Gaffer.BoolPlug( defaultValue = False )
 
 		self.__jobPool = jobPool if jobPool else LocalDispatcher.defaultJobPool()
 
@@ -93,9 +96,19 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				dispatcher["environmentCommand"].getValue()
 			)
 
+			self.__maxConcurrentTasks = dispatcher["maxConcurrentTasks"].getValue()
+			self.__reuseProcesses = dispatcher["reuseProcesses"].getValue()
+			self.__workers = []
+			self.__idleWorkers = []
+			self.__busyWorkers = {}
+			# Used to wake the background dispatch when processes
+			# complete or the job is killed.
+			self.__events = Queue.Queue()
+
 			self.__messageHandler = IECore.CapturingMessageHandler()
 			self.__messageTitle = "%s : Job %s %s" % ( self.__dispatcher.getName(), self.__name, self.__id )
 
+			self.__batches = []
 			self.__initBatchWalk( batch )
 
 		def name( self ) :
@@ -112,35 +125,40 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 		def description( self ) :
 
-			batch = self.__currentBatch()
-			if batch is None or batch.plug() is None :
+			batches = [ b for b in self.__runningBatches() if b.plug() is not None ]
+			if not batches :
 				return "N/A"
 
-			frames = str( IECore.frameListFromList( [ int(x) for x in batch.frames() ] ) )
-
-			return "Executing " + batch.blindData()["nodeName"].value + " on frames " + frames
+			return "Executing " + ", ".join(
+				"{} on frames {}".format(
+					b.blindData()["nodeName"].value,
+					IECore.frameListFromList( [ int(x) for x in b.frames() ] )
+				)
+				for b in batches
+			)
 
 		def statistics( self ) :
 
-			batch = self.__currentBatch()
-			if batch is None or "pid" not in batch.blindData().keys() :
+			pids = { str( b.blindData()["pid"].value ) for b in self.__runningBatches() if "pid" in b.blindData() }
+			if not pids :
 				return {}
 
 			rss = 0
 			pcpu = 0.0
-			pid = batch.blindData().get( "pid" )
 
 			try :
-				stats = subprocess.Popen( ( "ps -Ao pid,ppid,pgid,sess,pcpu,rss" ).split( " " ), stdout=subprocess.PIPE, stderr=subprocess.PIPE ).communicate()[0].split()
+				stats = subprocess.Popen( ( "ps -Ao pid,ppid,pgid,sess,pcpu,rss" ).split( " " ), stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True ).communicate()[0].split()
 				for i in range( 0, len(stats), 6 ) :
-					if str(pid) in stats[i:i+4] :
+					# Count each process once, even if it is related
+					# to more than one of our batches.
+					if pids.intersection( stats[i:i+4] ) :
 						pcpu += float(stats[i+4])
 						rss += float(stats[i+5])
 			except :
 				return {}
 
 			return {
-				"pid" : pid,
+				"pids" : sorted( int( p ) for p in pids ),
 				"pcpu" : pcpu,
 				"rss" : rss,
 			}
@@ -166,6 +184,7 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 			if not self.failed() :
 				self.__killBatchWalk( self.__batch )
+				self.__events.put( None )
 
 		def killed( self ) :
 
@@ -228,34 +247,164 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 		def __doBackgroundDispatch( self, batch ) :
 
-			if self.__getStatus( batch ) == LocalDispatcher.Job.Status.Complete :
-				return True
+			try :
+				return self.__scheduleBatches( batch )
+			finally :
+				for worker in self.__workers :
+					worker.close()
+
+		def __scheduleBatches( self, batch ) :
+
+			# We schedule the batches ourselves rather than walking the graph
+			# recursively, so that independent batches may execute concurrently,
+			# up to the limit set by `maxConcurrentTasks`. Each batch counts
+			# as `dispatcher.local.weight` tasks towards that limit.
+
+			numBatches = len( self.__batches )
+			dependents = [ [] for i in range( 0, numBatches ) ]
+			numPending = [ 0 ] * numBatches
+			for i, b in enumerate( self.__batches ) :
+				for upstreamIndex in set( self.__batchIndex( u ) for u in b.preTasks() ) :
+					dependents[upstreamIndex].append( i )
+					numPending[i] += 1
+
+			priority = self.__criticalPathLengths( dependents )
+
+			ready = [ i for i in range( 0, numBatches ) if numPending[i] == 0 ]
+			running = {}
+			runningWeight = 0
+			failedBatch = None
+
+			while True :
+
+				if self.__batch.blindData().get( "killed" ) :
+					for i, process in running.items() :
+						os.killpg( process.pid, signal.SIGTERM )
+						self.__setStatus( self.__batches[i], LocalDispatcher.Job.Status.Killed )
+					self.__reportKilled( batch )
+					return False
 
-			for upstreamBatch in batch.preTasks() :
-				if not self.__doBackgroundDispatch( upstreamBatch ) :
+				# Start as many ready batches as we can, most critical first.
+				# Batches that don't need a process complete immediately, and
+				# may make their dependents ready, so we loop until nothing changes.
+
+				startedOrCompleted = True
+				while startedOrCompleted and failedBatch is None :
+
+					startedOrCompleted = False
+					ready.sort( key = lambda i : priority[i] )
+					for i in reversed( ready ) :
+
+						b = self.__batches[i]
+						if not b.plug() :
+							self.__reportCompleted( b )
+							return True
+
+						if len( b.frames() ) == 0 :
+							# This case occurs for nodes like TaskList and TaskContextProcessors,
+							# because they don't do anything in execute (they have empty hashes).
+							# Their batches exist only to depend on upstream batches. We don't need
+							# to do any work here, but we still signal completion for the task to
+							# provide progress feedback to the user.
+							self.__setStatus( b, LocalDispatcher.Job.Status.Complete )
+							IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Finished " + b.blindData()["nodeName"].value )
+						else :
+							weight = min( b.blindData()["weight"].value, self.__maxConcurrentTasks )
+							if running and runningWeight + weight > self.__maxConcurrentTasks :
+								# A lighter batch may still fit.
+								continue
+							running[i] = self.__launch( i )
+							runningWeight += weight
+
+						ready.remove( i )
+						startedOrCompleted = True
+						if len( b.frames() ) == 0 :
+							ready.extend( self.__release( i, dependents, numPending ) )
+						break
+
+				if not running :
+					# Nothing is running, and nothing more can be started.
+					# This can only be because we stopped after a failure.
+					assert( failedBatch is not None )
+					self.__reportFailed( failedBatch )
 					return False
 
-			if batch.blindData().get( "killed" ) :
-				self.__reportKilled( batch )
-				return False
+				event = self.__events.get()
+				if event is None :
+					# Woken by `kill()`.
+					continue
 
-			if not batch.plug() :
-				self.__reportCompleted( batch )
-				return True
+				i, returnCode = event
+				running.pop( i )
+				if i in self.__busyWorkers :
+					self.__idleWorkers.append( self.__busyWorkers.pop( i ) )
+				runningWeight -= min( self.__batches[i].blindData()["weight"].value, self.__maxConcurrentTasks )
 
-			if len( batch.frames() ) == 0 :
-				# This case occurs for nodes like TaskList and TaskContextProcessors,
-				# because they don't do anything in execute (they have empty hashes).
-				# Their batches exist only to depend on upstream batches. We don't need
-				# to do any work here, but we still signal completion for the task to
-				# provide progress feedback to the user.
-				self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
-				IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Finished " + batch.blindData()["nodeName"].value )
-				return True
+				if returnCode :
+					# Don't start anything new, but let the other
+					# running batches finish before reporting.
+					if failedBatch is None :
+						failedBatch = self.__batches[i]
+					continue
+
+				self.__setStatus( self.__batches[i], LocalDispatcher.Job.Status.Complete )
+				ready.extend( self.__release( i, dependents, numPending ) )
+
+		def __batchIndex( self, batch ) :
+
+			return batch.blindData()["batchIndex"].value
+
+		# Returns the indices of batches which become ready now
+		# that batch `i` has completed.
+		def __release( self, i, dependents, numPending ) :
+
+			result = []
+			for d in dependents[i] :
+				numPending[d] -= 1
+				if numPending[d] == 0 :
+					result.append( d )
+
+			return result
+
+		# Returns the number of frames on the longest path from each batch to
+		# the root batch. Executing the batches with the longest paths first
+		# tends to minimise the overall time taken by the job.
+		def __criticalPathLengths( self, dependents ) :
+
+			numBatches = len( self.__batches )
+			numUnvisitedDependents = [ len( d ) for d in dependents ]
+			result = [ 0 ] * numBatches
+
+			# Visit batches in topological order from the root,
+			# so that all dependents are visited before each batch.
+			toVisit = [ i for i in range( 0, numBatches ) if numUnvisitedDependents[i] == 0 ]
+			while toVisit :
+				i = toVisit.pop()
+				result[i] = len( self.__batches[i].frames() ) + max( [ result[d] for d in dependents[i] ] + [ 0 ] )
+				for upstreamIndex in set( self.__batchIndex( u ) for u in self.__batches[i].preTasks() ) :
+					numUnvisitedDependents[upstreamIndex] -= 1
+					if numUnvisitedDependents[upstreamIndex] == 0 :
+						toVisit.append( upstreamIndex )
+
+			return result
+
+		def __launch( self, i ) :
+
+			batch = self.__batches[i]
 
 			taskContext = batch.context()
 			frames = str( IECore.frameListFromList( [ int(x) for x in batch.frames() ] ) )
 
+			contextArgs = []
+			for entry in [ k for k in taskContext.keys() if k != "frame" and not k.startswith( "ui:" ) ] :
+				if entry not in self.__context.keys() or taskContext[entry] != self.__context[entry] :
+					contextArgs.extend( [ "-" + entry, IECore.repr( taskContext[entry] ) ] )
+
+			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
+
+			if self.__reuseProcesses :
+				return self.__launchInWorker( i, frames, contextArgs )
+
 			args = [
 				"gaffer", "execute",
 				"-script", self.__scriptFile,
@@ -268,35 +417,56 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			if self.__ignoreScriptLoadErrors :
 				args.append( "-ignoreScriptLoadErrors" )
 
-			contextArgs = []
-			for entry in [ k for k in taskContext.keys() if k != "frame" and not k.startswith( "ui:" ) ] :
-				if entry not in self.__context.keys() or taskContext[entry] != self.__context[entry] :
-					contextArgs.extend( [ "-" + entry, IECore.repr( taskContext[entry] ) ] )
-
 			if contextArgs :
 				args.extend( [ "-context" ] + contextArgs )
 
-			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, " ".join( args ) )
 			process = subprocess.Popen( args, start_new_session=True )
 			batch.blindData()["pid"] = IECore.IntData( process.pid )
 
-			while process.poll() is None :
+			# Wait for the process on a separate thread, so that the
+			# dispatch is woken as soon as it completes, without polling.
+			threading.Thread( target = self.__waitForProcess, args = ( process, i ) ).start()
 
-				if batch.blindData().get( "killed" ) :
-					os.killpg( process.pid, signal.SIGTERM )
-					self.__reportKilled( batch )
-					return False
+			return process
 
-				time.sleep( 0.01 )
+		def __waitForProcess( self, process, i ) :
 
-			if process.returncode :
-				self.__reportFailed( batch )
-				return False
+			process.wait()
+			self.__events.put( ( i, process.returncode ) )
 
-			self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
+		def __launchInWorker( self, i, frames, contextArgs ) :
 
-			return True
+			batch = self.__batches[i]
+
+			if self.__idleWorkers :
+				worker = self.__idleWorkers.pop()
+			else :
+				args = [
+					"gaffer", "execute",
+					"-script", self.__scriptFile,
+					"-worker",
+				]
+				args = shlex.split( self.__environmentCommand ) + args
+				if self.__ignoreScriptLoadErrors :
+					args.append( "-ignoreScriptLoadErrors" )
+
+				IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, " ".join( args ) )
+				worker = LocalDispatcher._Worker( args, self.__events )
+				self.__workers.append( worker )
+
+			request = {
+				"nodes" : [ batch.blindData()["nodeName"].value ],
+				"frames" : frames,
+				"context" : contextArgs,
+			}
+
+			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Worker %d : %s" % ( worker.process.pid, repr( request ) ) )
+			worker.execute( i, request )
+			self.__busyWorkers[i] = worker
+			batch.blindData()["pid"] = IECore.IntData( worker.process.pid )
+
+			return worker.process
 
 		def __getStatus( self, batch ) :
 
@@ -325,28 +495,9 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			self.__dispatcher.jobPool()._remove( self )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Killed " + self.name() )
 
-		def __currentBatch( self ) :
-
-			## \todo Consider just storing the current batch, rather
-			# than searching each time it is requested.
-			return self.__currentBatchWalk( self.__batch, set() )
-
-		def __currentBatchWalk( self, batch, visited ) :
-
-			if batch in visited :
-				return None
+		def __runningBatches( self ) :
 
-			visited.add( batch )
-
-			if self.__getStatus( batch ) == LocalDispatcher.Job.Status.Running :
-				return batch
-
-			for upstreamBatch in batch.preTasks() :
-				currentBatch = self.__currentBatchWalk( upstreamBatch, visited )
-				if currentBatch is not None :
-					return currentBatch
-
-			return None
+			return [ b for b in self.__batches if self.__getStatus( b ) == LocalDispatcher.Job.Status.Running ]
 
 		def __initBatchWalk( self, batch ) :
 
@@ -359,11 +510,85 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				nodeName = batch.plug().node().relativeName( batch.plug().node().scriptNode() )
 			batch.blindData()["nodeName"] = nodeName
 
+			# Copy the weight now, because nothing stops the user
+			# editing it during a background dispatch.
+			weight = 1
+			if batch.plug() is not None and "local" in batch.plug().node()["dispatcher"] :
+				with batch.context() :
+					weight = batch.plug().node()["dispatcher"]["local"]["weight"].getValue()
+			batch.blindData()["weight"] = IECore.IntData( weight )
+
+			batch.blindData()["batchIndex"] = IECore.IntData( len( self.__batches ) )
+			self.__batches.append( batch )
+
 			self.__setStatus( batch, LocalDispatcher.Job.Status.Waiting )
 
 			for upstreamBatch in batch.preTasks() :
 				self.__initBatchWalk( upstreamBatch )
 
+	# A long-lived `gaffer execute -worker` process, which loads the
+	# script once and then executes batches as they are requested.
+	# Used by Jobs when `reuseProcesses` is on.
+	class _Worker( object ) :
+
+		def __init__( self, args, events ) :
+
+			self.process = subprocess.Popen( args, stdin = subprocess.PIPE, stdout = subprocess.PIPE, start_new_session = True )
+
+			self.__events = events
+			self.__batchIndex = None
+			self.__exited = False
+			self.__lock = threading.Lock()
+
+			threading.Thread( target = self.__readResponses ).start()
+
+		def execute( self, batchIndex, request ) :
+
+			with self.__lock :
+				assert( self.__batchIndex is None )
+				if self.__exited :
+					# The worker died while idle, so there is no
+					# `__readResponses()` left to report on the batch.
+					self.__events.put( ( batchIndex, self.process.returncode or 1 ) )
+					return
+				self.__batchIndex = batchIndex
+
+			try :
+				self.process.stdin.write( repr( request ) + "\n" )
+				self.process.stdin.flush()
+			except IOError as e :
+				if e.errno != errno.EPIPE :
+					raise
+				# The worker died before receiving the request. We've
+				# already claimed the batch, so `__readResponses()` will
+				# report it as failed once the worker's output ends.
+
+		# Closes the worker's input, causing it to exit
+		# once any current request is complete.
+		def close( self ) :
+
+			try :
+				self.process.stdin.close()
+			except IOError :
+				# Already dead.
+				pass
+
+		def __readResponses( self ) :
+
+			for line in iter( self.process.stdout.readline, "" ) :
+				with self.__lock :
+					batchIndex, self.__batchIndex = self.__batchIndex, None
+				self.__events.put( ( batchIndex, int( line ) ) )
+
+			self.process.wait()
+			with self.__lock :
+				self.__exited = True
+				batchIndex, self.__batchIndex = self.__batchIndex, None
+
+			if batchIndex is not None :
+				# The worker died while executing a batch.
+				self.__events.put( ( batchIndex, self.process.returncode or 1 ) )
+
 	class JobPool( IECore.RunTimeTyped ) :
 
 		def __init__( self ) :
@@ -434,6 +659,15 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 		return self.__jobPool
 
+	@staticmethod
+	def _setupPlugs( parentPlug ) :
+
+		if "local" in parentPlug :
+			return
+
+		parentPlug["local"] = Gaffer.Plug()
+		parentPlug["local"]["weight"] = Gaffer.IntPlug( defaultValue = 1, minValue = 1 )
+
 	def _doDispatch( self, batch ) :
 
 		job = LocalDispatcher.Job(
@@ -448,4 +682,4 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 IECore.registerRunTimeTyped( LocalDispatcher, typeName = "GafferDispatch::LocalDispatcher" )
 IECore.registerRunTimeTyped( LocalDispatcher.JobPool, typeName = "GafferDispatch::LocalDispatcher::JobPool" )
 
-GafferDispatch.Dispatcher.registerDispatcher( "Local", LocalDispatcher )
+GafferDispatch.Dispatcher.registerDispatcher( "Local", LocalDispatcher, LocalDispatcher._setupPlugs )
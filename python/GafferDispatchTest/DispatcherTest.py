@@ -1761,5 +1761,95 @@ class DispatcherTest( GafferTest.TestCase ) :
 		with self.assertRaisesRegexp( RuntimeError, "TaskPlug \"ScriptNode.badNode.task\" has no TaskNode" ) :
 			dispatcher.dispatch( [ s["taskList"] ] )
 
+	def testSkipUpToDateTasks( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n1"] = GafferDispatchTest.LoggingTaskNode()
+		s["n2"] = GafferDispatchTest.LoggingTaskNode()
+		s["n2"]["value"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n2"]["preTasks"][0].setInput( s["n1"]["task"] )
+		s["n3"] = GafferDispatchTest.LoggingTaskNode()
+		s["n3"]["preTasks"][0].setInput( s["n2"]["task"] )
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher["skipUpToDateTasks"].setValue( True )
+
+		# Everything is executed the first time.
+
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ len( s[n].log ) for n in ( "n1", "n2", "n3" ) ], [ 1, 1, 1 ] )
+
+		# But nothing needs executing the second time.
+
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ len( s[n].log ) for n in ( "n1", "n2", "n3" ) ], [ 1, 1, 1 ] )
+
+		# Changing a task causes it to be executed again, along
+		# with everything downstream.
+
+		s["n2"]["value"].setValue( 1 )
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ len( s[n].log ) for n in ( "n1", "n2", "n3" ) ], [ 1, 2, 2 ] )
+
+		# And changing it back finds the previous records.
+
+		s["n2"]["value"].setValue( 0 )
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ len( s[n].log ) for n in ( "n1", "n2", "n3" ) ], [ 1, 2, 2 ] )
+
+		# Non-incremental dispatches execute everything.
+
+		dispatcher["skipUpToDateTasks"].setValue( False )
+		dispatcher.dispatch( [ s["n3"] ] )
+		self.assertEqual( [ len( s[n].log ) for n in ( "n1", "n2", "n3" ) ], [ 2, 3, 3 ] )
+
+		# And job directories are still numbered sequentially
+		# alongside the manifest.
+
+		self.assertEqual( dispatcher.jobDirectory(), self.temporaryDirectory() + "/000004" )
+		self.assertTrue( os.path.isdir( self.temporaryDirectory() + "/manifest" ) )
+
+	def testSkipUpToDateTasksChecksOutputFiles( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["w"] = GafferDispatchTest.TextWriter()
+		s["w"]["fileName"].setValue( self.temporaryDirectory() + "/w.####.txt" )
+		s["w"]["text"].setValue( "w" )
+		s["w"]["dispatcher"]["outputFiles"].setInput( s["w"]["fileName"] )
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher["framesMode"].setValue( GafferDispatch.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-3" )
+		dispatcher["skipUpToDateTasks"].setValue( True )
+		dispatcher.dispatch( [ s["w"] ] )
+
+		fileName = lambda frame : self.temporaryDirectory() + "/w.%04d.txt" % frame
+		for frame in ( 1, 2, 3 ) :
+			self.assertEqual( open( fileName( frame ) ).read(), "w" )
+
+		# Modify the outputs behind the dispatcher's back. Frame 1
+		# has a new modification time and frame 2 is deleted, so
+		# both should be executed again. Frame 3 has its original
+		# modification time, so it will be considered up to date.
+
+		with open( fileName( 1 ), "w" ) as f :
+			f.write( "modified" )
+		os.utime( fileName( 1 ), ( 0, 0 ) )
+
+		os.remove( fileName( 2 ) )
+
+		fileStat = os.stat( fileName( 3 ) )
+		with open( fileName( 3 ), "w" ) as f :
+			f.write( "modified" )
+		os.utime( fileName( 3 ), ( fileStat.st_atime, fileStat.st_mtime ) )
+
+		dispatcher.dispatch( [ s["w"] ] )
+
+		self.assertEqual( open( fileName( 1 ) ).read(), "w" )
+		self.assertEqual( open( fileName( 2 ) ).read(), "w" )
+		self.assertEqual( open( fileName( 3 ) ).read(), "modified" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -373,5 +373,56 @@ class ExecuteApplicationTest( GafferTest.TestCase ) :
 		validate( sequence = True )
 		validate( sequence = False )
 
+	def testWorker( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["write"] = GafferDispatchTest.TextWriter()
+		s["write"]["fileName"].setValue( self.__outputFileSeq.fileName )
+		s["write"]["text"].setValue( "${value}" )
+
+		s["fileName"].setValue( self.__scriptFileName )
+		s.save()
+
+		p = subprocess.Popen(
+			[ "gaffer", "execute", self.__scriptFileName, "-worker" ],
+			stdin = subprocess.PIPE,
+			stdout = subprocess.PIPE,
+		)
+
+		# Each request is executed in turn by the same process,
+		# with the result written to stdout.
+
+		p.stdin.write( repr( { "nodes" : [ "write" ], "frames" : "1-2", "context" : [ "-value", "'a'" ] } ) + "\n" )
+		p.stdin.flush()
+		self.assertEqual( p.stdout.readline(), "0\n" )
+
+		for f in ( 1, 2 ) :
+			with open( self.__outputFileSeq.fileNameForFrame( f ) ) as t :
+				self.assertEqual( t.read(), "a" )
+
+		p.stdin.write( repr( { "frames" : "3", "context" : [ "-value", "'b'" ] } ) + "\n" )
+		p.stdin.flush()
+		self.assertEqual( p.stdout.readline(), "0\n" )
+
+		with open( self.__outputFileSeq.fileNameForFrame( 3 ) ) as t :
+			self.assertEqual( t.read(), "b" )
+
+		# Failures are reported without terminating the worker.
+
+		p.stdin.write( repr( { "nodes" : [ "doesNotExist" ] } ) + "\n" )
+		p.stdin.flush()
+		self.assertEqual( p.stdout.readline(), "1\n" )
+
+		p.stdin.write( "notAValidRequest\n" )
+		p.stdin.flush()
+		self.assertEqual( p.stdout.readline(), "1\n" )
+
+		# And closing stdin shuts the worker down cleanly.
+
+		p.stdin.close()
+		p.wait()
+		self.assertEqual( p.returncode, 0 )
+
 if __name__ == "__main__":
 	unittest.main()
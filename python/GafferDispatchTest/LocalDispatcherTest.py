@@ -41,6 +41,7 @@ import unittest
 import time
 import inspect
 import functools
+import Queue
 
 import imath
 
@@ -853,5 +854,251 @@ class LocalDispatcherTest( GafferTest.TestCase ) :
 			open( self.temporaryDirectory() + "/outer.txt" ).readlines(),
 		)
 
+	def __timingTask( self, name, duration = 1 ) :
+
+		# A task which sleeps, recording when it started and finished.
+		result = GafferDispatch.PythonCommand( name )
+		result["command"].setValue( inspect.cleandoc(
+			"""
+			import time
+			start = time.time()
+			time.sleep( {duration} )
+			with open( "{fileName}", "w" ) as f :
+				f.write( "%f %f" % ( start, time.time() ) )
+			"""
+		).format( duration = duration, fileName = self.temporaryDirectory() + "/" + name + ".txt" ) )
+
+		return result
+
+	def __timings( self, name ) :
+
+		with open( self.temporaryDirectory() + "/" + name + ".txt" ) as f :
+			return [ float( x ) for x in f.read().split() ]
+
+	def __overlap( self, name1, name2 ) :
+
+		start1, end1 = self.__timings( name1 )
+		start2, end2 = self.__timings( name2 )
+		return start1 < end2 and start2 < end1
+
+	def testConcurrentTasks( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["taskList"] = GafferDispatch.TaskList()
+		for i in range( 0, 3 ) :
+			s.addChild( self.__timingTask( "independent%d" % i, duration = 2 ) )
+			s["taskList"]["preTasks"][i].setInput( s["independent%d" % i]["task"] )
+
+		s["downstream"] = self.__timingTask( "downstream", duration = 0 )
+		s["downstream"]["preTasks"][0].setInput( s["taskList"]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+
+		# By default, tasks are executed one at a time.
+
+		d.dispatch( [ s["downstream"] ] )
+		d.jobPool().waitForAll()
+
+		for i in range( 0, 3 ) :
+			for j in range( i + 1, 3 ) :
+				self.assertFalse( self.__overlap( "independent%d" % i, "independent%d" % j ) )
+
+		# But independent tasks may be executed concurrently.
+
+		d["maxConcurrentTasks"].setValue( 3 )
+		d.dispatch( [ s["downstream"] ] )
+		d.jobPool().waitForAll()
+		self.assertEqual( len( d.jobPool().failedJobs() ), 0 )
+
+		for i in range( 0, 3 ) :
+			for j in range( i + 1, 3 ) :
+				self.assertTrue( self.__overlap( "independent%d" % i, "independent%d" % j ) )
+			# Without breaking dependencies.
+			self.assertLessEqual( self.__timings( "independent%d" % i )[1], self.__timings( "downstream" )[0] )
+
+	def testWeight( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["light"] = self.__timingTask( "light", duration = 2 )
+		s["heavy"] = self.__timingTask( "heavy", duration = 2 )
+		s["heavy"]["dispatcher"]["local"]["weight"].setValue( 2 )
+		s["other"] = self.__timingTask( "other", duration = 2 )
+
+		s["taskList"] = GafferDispatch.TaskList()
+		s["taskList"]["preTasks"][0].setInput( s["light"]["task"] )
+		s["taskList"]["preTasks"][1].setInput( s["heavy"]["task"] )
+		s["taskList"]["preTasks"][2].setInput( s["other"]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 2 )
+		d.dispatch( [ s["taskList"] ] )
+		d.jobPool().waitForAll()
+
+		# The heavy task uses all the available slots,
+		# so can't overlap with anything else.
+		self.assertFalse( self.__overlap( "heavy", "light" ) )
+		self.assertFalse( self.__overlap( "heavy", "other" ) )
+		self.assertTrue( self.__overlap( "light", "other" ) )
+
+	def testConcurrentFailure( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["slow"] = self.__timingTask( "slow", duration = 2 )
+		s["failing"] = GafferDispatchTest.TextWriter()
+		s["failing"]["fileName"].setValue( "" )
+
+		s["taskList"] = GafferDispatch.TaskList()
+		s["taskList"]["preTasks"][0].setInput( s["slow"]["task"] )
+		s["taskList"]["preTasks"][1].setInput( s["failing"]["task"] )
+
+		s["downstream"] = self.__timingTask( "downstream", duration = 0 )
+		s["downstream"]["preTasks"][0].setInput( s["taskList"]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 2 )
+		d.dispatch( [ s["downstream"] ] )
+		d.jobPool().waitForAll()
+
+		# The failure is reported, but only after the slow
+		# task has been allowed to finish.
+		self.assertEqual( len( d.jobPool().failedJobs() ), 1 )
+		self.assertTrue( os.path.exists( self.temporaryDirectory() + "/slow.txt" ) )
+		self.assertFalse( os.path.exists( self.temporaryDirectory() + "/downstream.txt" ) )
+
+	def testConcurrentKill( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["taskList"] = GafferDispatch.TaskList()
+		for i in range( 0, 2 ) :
+			s.addChild( self.__timingTask( "task%d" % i, duration = 10 ) )
+			s["taskList"]["preTasks"][i].setInput( s["task%d" % i]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 2 )
+		d.dispatch( [ s["taskList"] ] )
+
+		t = time.time()
+		d.jobPool().jobs()[0].kill()
+		d.jobPool().waitForAll()
+		self.assertLess( time.time() - t, 5 )
+
+		for i in range( 0, 2 ) :
+			self.assertFalse( os.path.exists( self.temporaryDirectory() + "/task%d.txt" % i ) )
+
+	def testReuseProcesses( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["taskList"] = GafferDispatch.TaskList()
+		for i in range( 0, 4 ) :
+			s["task%d" % i] = GafferDispatch.PythonCommand()
+			s["task%d" % i]["command"].setValue( inspect.cleandoc(
+				"""
+				import os
+				with open( "{fileName}", "w" ) as f :
+					f.write( str( os.getpid() ) )
+				"""
+			).format( fileName = self.temporaryDirectory() + "/task%d.txt" % i ) )
+			s["taskList"]["preTasks"][i].setInput( s["task%d" % i]["task"] )
+
+		s["failing"] = GafferDispatchTest.TextWriter()
+		s["failing"]["fileName"].setValue( "" )
+		s["failing"]["preTasks"][0].setInput( s["taskList"]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+		d["reuseProcesses"].setValue( True )
+		d.dispatch( [ s["taskList"] ] )
+		d.jobPool().waitForAll()
+		self.assertEqual( len( d.jobPool().failedJobs() ), 0 )
+
+		# All tasks were executed by the same worker process.
+
+		pids = set()
+		for i in range( 0, 4 ) :
+			with open( self.temporaryDirectory() + "/task%d.txt" % i ) as f :
+				pids.add( int( f.read() ) )
+
+		self.assertEqual( len( pids ), 1 )
+		self.assertNotEqual( pids.pop(), os.getpid() )
+
+		# Failures are still reported.
+
+		d.dispatch( [ s["failing"] ] )
+		d.jobPool().waitForAll()
+		self.assertEqual( len( d.jobPool().failedJobs() ), 1 )
+
+	def testDeadWorkerFailsBatch( self ) :
+
+		# A worker which exits without reading any requests.
+		events = Queue.Queue()
+		worker = GafferDispatch.LocalDispatcher._Worker( [ "sh", "-c", "exit 2" ], events )
+		worker.process.wait()
+
+		# Sending it a request must report the batch as failed,
+		# rather than raising or leaving the dispatch waiting forever.
+		worker.execute( 3, { "nodes" : [ "n" ], "frames" : "1", "context" : [] } )
+		self.assertEqual( events.get( timeout = 10 ), ( 3, 2 ) )
+		self.assertTrue( events.empty() )
+
+	def testRunningBatchesReported( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["taskList"] = GafferDispatch.TaskList()
+		for i in range( 0, 2 ) :
+			s.addChild( self.__timingTask( "task%d" % i, duration = 4 ) )
+			s["taskList"]["preTasks"][i].setInput( s["task%d" % i]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 2 )
+		d.dispatch( [ s["taskList"] ] )
+
+		# Wait for both tasks to be running.
+
+		job = d.jobPool().jobs()[-1]
+		timeout = time.time() + 10
+		while len( job.statistics().get( "pids", [] ) ) < 2 and time.time() < timeout :
+			time.sleep( 0.1 )
+
+		# Everything that is running should be reported, not just
+		# the first running batch we find.
+
+		statistics = job.statistics()
+		self.assertEqual( len( statistics["pids"] ), 2 )
+		self.assertIn( "pcpu", statistics )
+		self.assertIn( "rss", statistics )
+
+		description = job.description()
+		self.assertIn( "task0 on frames 1", description )
+		self.assertIn( "task1 on frames 1", description )
+
+		d.jobPool().waitForAll()
+		self.assertEqual( len( d.jobPool().failedJobs() ), 0 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testMakespan( self ) :
+
+		# A graph of independent sleeping tasks, of the sort produced
+		# by a Wedge, where the makespan is dominated by scheduling.
+
+		s = Gaffer.ScriptNode()
+		s["taskList"] = GafferDispatch.TaskList()
+		for i in range( 0, 8 ) :
+			s.addChild( self.__timingTask( "task%d" % i, duration = 1 ) )
+			s["taskList"]["preTasks"][i].setInput( s["task%d" % i]["task"] )
+
+		d = self.__createLocalDispatcher()
+		d["executeInBackground"].setValue( True )
+		d["maxConcurrentTasks"].setValue( 8 )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			d.dispatch( [ s["taskList"] ] )
+			d.jobPool().waitForAll()
+
 if __name__ == "__main__":
 	unittest.main()
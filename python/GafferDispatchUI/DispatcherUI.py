@@ -118,6 +118,20 @@ Gaffer.Metadata.registerNode(
 
 		),
 
+		"skipUpToDateTasks" : (
+
+			"description",
+			"""
+			Skips tasks which were executed by a previous dispatch, and
+			whose results are still up to date. A task is up to date if
+			it would do exactly the same thing as before, the files listed
+			in its `dispatcher.outputFiles` plug haven't been modified since,
+			and all its upstream tasks are up to date too. Executed tasks are
+			recorded in a manifest directory alongside the job directories.
+			""",
+
+		),
+
 	}
 
 )
@@ -157,7 +171,22 @@ Gaffer.Metadata.registerNode(
 			considered to be immediate too, regardless of their settings.
 			"""
 
-		)
+		),
+
+		"dispatcher.outputFiles" : (
+
+			"description",
+			"""
+			A space separated list of the files written by this node.
+			These are checked by dispatchers using `skipUpToDateTasks`,
+			so that the node is executed again if its outputs have been
+			modified or deleted since it was last executed. Frame
+			numbers may be specified using `#` characters, and typically
+			this plug is connected to or shares an expression with the
+			node's own file name plug.
+			""",
+
+		),
 
 	}
 
@@ -97,6 +97,69 @@ Gaffer.Metadata.registerNode(
 
 		),
 
+		"maxConcurrentTasks" : (
+
+			"description",
+			"""
+			The maximum number of tasks to execute at once when executing
+			in the background. Tasks which don't depend on one another
+			are executed concurrently, prioritising those on the longest
+			chain of dependencies. Tasks which use many threads or lots
+			of memory may count as several tasks, using the
+			`dispatcher.local.weight` plug on each task node.
+			""",
+
+		),
+
+		"reuseProcesses" : (
+
+			"description",
+			"""
+			Executes tasks using long-lived worker processes when
+			executing in the background, rather than launching a new
+			process for every task. Each worker loads the script only
+			once, saving the startup cost for jobs with many small
+			tasks. Workers are shut down when the job completes.
+			""",
+
+		),
+
+	}
+
+)
+
+Gaffer.Metadata.registerNode(
+
+	GafferDispatch.TaskNode,
+
+	plugs = {
+
+		"dispatcher.local" : (
+
+			"description",
+			"""
+			Settings that control how tasks are
+			executed by the LocalDispatcher.
+			""",
+
+			"layout:section", "Local",
+			"plugValueWidget:type", "GafferUI.LayoutPlugValueWidget",
+
+		),
+
+		"dispatcher.local.weight" : (
+
+			"description",
+			"""
+			The number of tasks this task counts as when limiting
+			concurrent execution using the LocalDispatcher's
+			`maxConcurrentTasks` plug. Increase this for tasks
+			which use many threads or lots of memory, to avoid
+			oversubscribing the machine.
+			""",
+
+		),
+
 	}
 
 )
@@ -173,5 +173,43 @@ class ClampTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( i["out"]["metadata"].getValue(), c["out"]["metadata"].getValue() )
 		self.assertEqual( i["out"]["channelNames"].getValue(), c["out"]["channelNames"].getValue() )
 
+	def testUniformTiles( self ) :
+
+		# Clamp has a fast path for the uniform tiles output by Constant.
+		# Check that it matches the regular path, which we get by feeding
+		# in a Checkerboard with identical colours.
+
+		for color in [
+			imath.Color4f( 0.1, 0.2, 0.3, 0.4 ),
+			imath.Color4f( -0.5, 1.5, 0.25, 0 ),
+		] :
+
+			constant = GafferImage.Constant()
+			constant["color"].setValue( color )
+
+			checkerboard = GafferImage.Checkerboard()
+			checkerboard["format"].setInput( constant["format"] )
+			checkerboard["colorA"].setInput( constant["color"] )
+			checkerboard["colorB"].setInput( constant["color"] )
+
+			constantClamp = GafferImage.Clamp()
+			constantClamp["in"].setInput( constant["out"] )
+			constantClamp["channels"].setValue( "[RGBA]" )
+			constantClamp["min"].setValue( imath.Color4f( 0, 0.25, 0, 0.1 ) )
+			constantClamp["max"].setValue( imath.Color4f( 0.5, 1, 0.2, 1 ) )
+
+			checkerboardClamp = GafferImage.Clamp()
+			checkerboardClamp["in"].setInput( checkerboard["out"] )
+			for name in [ "channels", "min", "max", "processUnpremultiplied" ] :
+				checkerboardClamp[name].setInput( constantClamp[name] )
+
+			for processUnpremultiplied in [ False, True ] :
+
+				constantClamp["processUnpremultiplied"].setValue( processUnpremultiplied )
+
+				self.assertIsNotNone( GafferImage.ImagePlug.uniformTileValue( constantClamp["out"].channelData( "R", imath.V2i( 0 ) ) ) )
+				self.assertIsNone( GafferImage.ImagePlug.uniformTileValue( checkerboardClamp["out"].channelData( "R", imath.V2i( 0 ) ) ) )
+				self.assertImagesEqual( constantClamp["out"], checkerboardClamp["out"], maxDifference = 1e-6 )
+
 if __name__ == "__main__":
 	unittest.main()
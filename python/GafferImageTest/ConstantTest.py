@@ -205,5 +205,27 @@ class ConstantTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertTrue( c["out"]["channelNames"] in set( [ x[0] for x in cs ] ) )
 
+	def testTilesAreShared( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 256, 256 ) )
+		c["color"].setValue( imath.Color4f( 0.25, 0.5, 0.25, 1 ) )
+
+		def tile( channelName, tileOrigin ) :
+			return c["out"].channelData( channelName, tileOrigin, _copy = False )
+
+		self.assertTrue( tile( "R", imath.V2i( 0 ) ).isSame( tile( "R", imath.V2i( 128 ) ) ) )
+		self.assertTrue( tile( "R", imath.V2i( 0 ) ).isSame( tile( "B", imath.V2i( 64 ) ) ) )
+		self.assertFalse( tile( "R", imath.V2i( 0 ) ).isSame( tile( "G", imath.V2i( 0 ) ) ) )
+		self.assertTrue( tile( "A", imath.V2i( 0 ) ).isSame( GafferImage.ImagePlug.whiteTile( _copy = False ) ) )
+
+		self.assertEqual( GafferImage.ImagePlug.uniformTileValue( tile( "G", imath.V2i( 0 ) ) ), 0.5 )
+		self.assertEqual( GafferImage.ImagePlug.uniformTileValue( tile( "G", imath.V2i( 0 ) ).copy() ), None )
+
+		self.assertEqual(
+			c["out"].channelData( "G", imath.V2i( 0 ) ),
+			IECore.FloatVectorData( [ 0.5 ] * GafferImage.ImagePlug.tileSize() ** 2 )
+		)
+
 if __name__ == "__main__":
 	unittest.main()
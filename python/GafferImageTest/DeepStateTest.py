@@ -435,6 +435,74 @@ class DeepStateTest( GafferImageTest.ImageTestCase ) :
 					self.assertEqual( len( channelData ), expectedSampleCount, "State : {}, Channel : {}, Values : {}".format( deepState, channel, nodes["values"] ) )
 					self.assertSimilarList( channelData, expectedData, 0.00001,  "State : {}, Channel : {}, Values : {}".format( deepState, channel, nodes["values"] ) )
 
+	def testSortManySamples( self ) :
+
+		# Enough samples per pixel to exceed the threshold
+		# for the insertion sort used for small pixels.
+		for i in range( 5 ) :
+
+			nodes = self.__getMessy( randomValueCount = 40 )
+
+			st = GafferImage.DeepState()
+			st["in"].setInput( nodes["merge"]["out"] )
+			st["deepState"].setValue( GafferImage.DeepState.TargetState.Sorted )
+
+			tileSize = GafferImage.ImagePlug.tileSize()
+			expectedValues = self.__getSortedSamples( nodes["values"] )
+
+			for channel in [ "R", "G", "B", "A", "Z", "ZBack" ] :
+				expectedData = IECore.FloatVectorData( [ v[channel] for v in expectedValues ] * tileSize * tileSize )
+				self.assertSimilarList( st["out"].channelData( channel, imath.V2i( 0 ) ), expectedData, 0.00001 )
+
+	def __getManySamples( self, numSamples ) :
+
+		random.seed( 0 )
+
+		nodes = {}
+		nodes["merge"] = GafferImage.DeepMerge()
+		nodes["constants"] = []
+
+		for i in range( numSamples ) :
+
+			z = random.uniform( 0.0, 100.0 )
+			c, d = self.__getConstant(
+				random.uniform( 0.0, 1.0 ), random.uniform( 0.0, 1.0 ), random.uniform( 0.0, 1.0 ),
+				random.uniform( 0.0, 0.1 ), z, z + random.choice( [ 0.0, random.uniform( 0.0, 5.0 ) ] ),
+				dim = imath.V2i( 256 )
+			)
+			nodes["constants"].extend( [ c, d ] )
+			nodes["merge"]["in"][i].setInput( d["out"] )
+
+		return nodes
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSortPerformance( self ) :
+
+		nodes = self.__getManySamples( 200 )
+
+		st = GafferImage.DeepState()
+		st["in"].setInput( nodes["merge"]["out"] )
+		st["deepState"].setValue( GafferImage.DeepState.TargetState.Sorted )
+
+		GafferImageTest.processTiles( nodes["merge"]["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( st["out"] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testFlattenPerformance( self ) :
+
+		nodes = self.__getManySamples( 200 )
+
+		st = GafferImage.DeepState()
+		st["in"].setInput( nodes["merge"]["out"] )
+		st["deepState"].setValue( GafferImage.DeepState.TargetState.Flat )
+
+		GafferImageTest.processTiles( nodes["merge"]["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( st["out"] )
+
 	def assertSimilarList( self, actual, expected, tolerance, msg = None ) :
 		self.assertEqual( len( actual ), len( expected ) )
 		for i in range( len( actual ) ) :
@@ -309,3 +309,41 @@ class GradeTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertImagesEqual( unpremultipliedGrade["out"], defaultGrade["out"] )
 
+	def testUniformTiles( self ) :
+
+		# Grade has a fast path for the uniform tiles output by Constant.
+		# Check that it matches the regular path, which we get by feeding
+		# in a Checkerboard with identical colours.
+
+		for color in [
+			imath.Color4f( 0.1, 0.2, 0.3, 0.4 ),
+			imath.Color4f( 0.5, 1.5, 0.25, 0 ),
+		] :
+
+			constant = GafferImage.Constant()
+			constant["color"].setValue( color )
+
+			checkerboard = GafferImage.Checkerboard()
+			checkerboard["format"].setInput( constant["format"] )
+			checkerboard["colorA"].setInput( constant["color"] )
+			checkerboard["colorB"].setInput( constant["color"] )
+
+			constantGrade = GafferImage.Grade()
+			constantGrade["in"].setInput( constant["out"] )
+			constantGrade["channels"].setValue( "[RGBA]" )
+			constantGrade["gamma"].setValue( imath.Color4f( 2, 0.5, 1, 1 ) )
+			constantGrade["multiply"].setValue( imath.Color4f( 0.5, 2, 1, 0.5 ) )
+			constantGrade["offset"].setValue( imath.Color4f( 0.1, 0, 0.2, 0.1 ) )
+
+			checkerboardGrade = GafferImage.Grade()
+			checkerboardGrade["in"].setInput( checkerboard["out"] )
+			for name in [ "channels", "gamma", "multiply", "offset", "processUnpremultiplied" ] :
+				checkerboardGrade[name].setInput( constantGrade[name] )
+
+			for processUnpremultiplied in [ False, True ] :
+
+				constantGrade["processUnpremultiplied"].setValue( processUnpremultiplied )
+
+				self.assertIsNotNone( GafferImage.ImagePlug.uniformTileValue( constantGrade["out"].channelData( "R", imath.V2i( 0 ) ) ) )
+				self.assertIsNone( GafferImage.ImagePlug.uniformTileValue( checkerboardGrade["out"].channelData( "R", imath.V2i( 0 ) ) ) )
+				self.assertImagesEqual( constantGrade["out"], checkerboardGrade["out"], maxDifference = 1e-6 )
@@ -187,6 +187,79 @@ class ImageStatsTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( s["min"].getValue(), imath.Color4f( 1 ) )
 		self.assertEqual( s["max"].getValue(), imath.Color4f( 1 ) )
 
+	def testNegativeValues( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( imath.Color4f( -1, -0.5, 0, 1 ) )
+		s = GafferImage.ImageStats()
+		s["in"].setInput( c["out"] )
+		s["area"].setValue( c["out"]["format"].getValue().getDisplayWindow() )
+
+		self.assertEqual( s["min"].getValue(), imath.Color4f( -1, -0.5, 0, 1 ) )
+		self.assertEqual( s["max"].getValue(), imath.Color4f( -1, -0.5, 0, 1 ) )
+		self.assertEqual( s["average"].getValue(), imath.Color4f( -1, -0.5, 0, 1 ) )
+
+	def testAreas( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( r["out"] )
+
+		dataWindow = r["out"]["dataWindow"].getValue()
+
+		def expectedStats( channelName, area ) :
+
+			values = []
+			for y in range( area.min().y, area.max().y ) :
+				for x in range( area.min().x, area.max().x ) :
+					p = imath.V2i( x, y )
+					if GafferImage.BufferAlgo.contains( dataWindow, p ) :
+						tileOrigin = GafferImage.ImagePlug.tileOrigin( p )
+						tile = r["out"].channelData( channelName, tileOrigin, _copy = False )
+						values.append( tile[GafferImage.ImagePlug.pixelIndex( p, tileOrigin )] )
+					else :
+						values.append( 0 )
+
+			return min( values ), max( values ), sum( values ) / len( values )
+
+		# Areas which cross tile boundaries and the edge of the data
+		# window, and areas which change only slightly, so that most
+		# tile statistics are reused from the previous area.
+		for area in [
+			imath.Box2i( imath.V2i( 0 ), imath.V2i( 100 ) ),
+			imath.Box2i( imath.V2i( 1 ), imath.V2i( 100 ) ),
+			imath.Box2i( imath.V2i( 1 ), imath.V2i( 99, 100 ) ),
+			imath.Box2i( imath.V2i( 10, 20 ), imath.V2i( 70, 90 ) ),
+			imath.Box2i( imath.V2i( -20, -10 ), imath.V2i( 130, 120 ) ),
+			imath.Box2i( imath.V2i( 60, 70 ), imath.V2i( 68, 75 ) ),
+			imath.Box2i( imath.V2i( 200 ), imath.V2i( 210 ) ),
+		] :
+			s["area"].setValue( area )
+			for i, channelName in enumerate( "RGBA" ) :
+				expectedMin, expectedMax, expectedAverage = expectedStats( channelName, area )
+				self.assertEqual( s["min"][i].getValue(), expectedMin )
+				self.assertEqual( s["max"][i].getValue(), expectedMax )
+				self.assertAlmostEqual( s["average"][i].getValue(), expectedAverage, places = 5 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		checker = GafferImage.Checkerboard()
+		checker["format"].setValue( GafferImage.Format( 7680, 4320 ) )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( checker["out"] )
+		s["area"].setValue( imath.Box2i( imath.V2i( 0 ), imath.V2i( 7680, 4320 ) ) )
+
+		GafferImageTest.processTiles( checker["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			s["average"].getValue()
+			s["min"].getValue()
+			s["max"].getValue()
+
 	def __assertColour( self, colour1, colour2 ) :
 		for i in range( 0, 4 ):
 			self.assertEqual( "%.4f" % colour2[i], "%.4f" % colour1[i] )
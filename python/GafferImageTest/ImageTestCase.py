@@ -138,6 +138,21 @@ class ImageTestCase( GafferTest.TestCase ) :
 
 		return emptyCrop
 
+	## Returns an image node with `numLayers` layers, each containing
+	# a copy of the RGBA channels of a Checkerboard. This is useful in
+	# testing the performance of nodes with many channels.
+	def multiLayerImage( self, numLayers = 10, format = GafferImage.Format( 1024, 1024 ) ) :
+
+		shuffle = GafferImage.Shuffle( "Shuffle" )
+		shuffle["Checkerboard"] = GafferImage.Checkerboard()
+		shuffle["Checkerboard"]["format"].setValue( format )
+		shuffle["in"].setInput( shuffle["Checkerboard"]["out"] )
+		for i in range( 0, numLayers ) :
+			for c in "RGBA" :
+				shuffle["channels"].addChild( shuffle.ChannelPlug( "layer{0}.{1}".format( i, c ), c ) )
+
+		return shuffle
+
 	def deepImage( self ):
 		return self.DeepImage()
 
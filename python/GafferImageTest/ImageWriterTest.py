@@ -1317,5 +1317,97 @@ class ImageWriterTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertFalse( os.path.exists( writer["fileName"].getValue() ) )
 
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testTiledWritePerformance( self ) :
+
+		image = self.multiLayerImage( format = GafferImage.Format( 4096, 2160 ) )
+		GafferImageTest.processTiles( image["out"] )
+
+		writer = GafferImage.ImageWriter()
+		writer["in"].setInput( image["out"] )
+		writer["fileName"].setValue( os.path.join( self.temporaryDirectory(), "tiled.exr" ) )
+		writer["openexr"]["mode"].setValue( GafferImage.ImageWriter.Mode.Tile )
+		writer["openexr"]["compression"].setValue( "zip" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			writer["task"].execute()
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testScanlineWritePerformance( self ) :
+
+		image = self.multiLayerImage( format = GafferImage.Format( 4096, 2160 ) )
+		GafferImageTest.processTiles( image["out"] )
+
+		writer = GafferImage.ImageWriter()
+		writer["in"].setInput( image["out"] )
+		writer["fileName"].setValue( os.path.join( self.temporaryDirectory(), "scanline.exr" ) )
+		writer["openexr"]["mode"].setValue( GafferImage.ImageWriter.Mode.Scanline )
+		writer["openexr"]["compression"].setValue( "zip" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			writer["task"].execute()
+
+	def __frameDependentImage( self ) :
+
+		# An image with an expensive frame-invariant
+		# part, and a cheap frame-dependent part.
+
+		checker = GafferImage.Checkerboard()
+		checker["format"].setValue( GafferImage.Format( 512, 512 ) )
+
+		blur = GafferImage.Blur()
+		blur["in"].setInput( checker["out"] )
+		blur["radius"].setValue( imath.V2f( 20 ) )
+
+		text = GafferImage.Text()
+		text["in"].setInput( blur["out"] )
+		text["text"].setValue( "${frame}" )
+
+		return checker, blur, text
+
+	def testFramesInParallel( self ) :
+
+		checker, blur, text = self.__frameDependentImage()
+
+		writer = GafferImage.ImageWriter()
+		writer["in"].setInput( text["out"] )
+
+		frames = range( 1, 11 )
+
+		writer["fileName"].setValue( os.path.join( self.temporaryDirectory(), "serial.####.exr" ) )
+		writer["task"].executeSequence( frames )
+
+		writer["framesInParallel"].setValue( 4 )
+		writer["fileName"].setValue( os.path.join( self.temporaryDirectory(), "parallel.####.exr" ) )
+		writer["task"].executeSequence( frames )
+
+		serialReader = GafferImage.ImageReader()
+		serialReader["fileName"].setValue( os.path.join( self.temporaryDirectory(), "serial.####.exr" ) )
+		parallelReader = GafferImage.ImageReader()
+		parallelReader["fileName"].setValue( os.path.join( self.temporaryDirectory(), "parallel.####.exr" ) )
+
+		for frame in frames :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				self.assertImagesEqual( parallelReader["out"], serialReader["out"], ignoreMetadata = True )
+				if frame > 1 :
+					c.setFrame( frame - 1 )
+					previous = parallelReader["out"].image()
+					c.setFrame( frame )
+					self.assertNotEqual( parallelReader["out"].image(), previous )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testFramesInParallelPerformance( self ) :
+
+		checker, blur, text = self.__frameDependentImage()
+
+		writer = GafferImage.ImageWriter()
+		writer["in"].setInput( text["out"] )
+		writer["fileName"].setValue( os.path.join( self.temporaryDirectory(), "parallel.####.exr" ) )
+		writer["framesInParallel"].setValue( 8 )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			writer["task"].executeSequence( range( 1, 101 ) )
+
 if __name__ == "__main__":
 	unittest.main()
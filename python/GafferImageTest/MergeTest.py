@@ -484,5 +484,136 @@ class MergeTest( GafferImageTest.ImageTestCase ) :
 		merge["in"][1].setInput( o["out"] )
 		GafferImage.ImageAlgo.image( merge["out"] )
 
+	def testManyInputsMatchesChainedMerges( self ) :
+
+		# Merging many layers with a single node should be equivalent to
+		# merging them one at a time, including where the layers have
+		# partially overlapping data windows.
+
+		script = Gaffer.ScriptNode()
+
+		script["merge"] = GafferImage.Merge()
+
+		previous = None
+		chainedMerges = []
+		for i in range( 0, 6 ) :
+
+			constant = GafferImage.Constant()
+			constant["format"].setValue( GafferImage.Format( 200, 150 ) )
+			constant["color"].setValue( imath.Color4f( 0.1 * i, 0.5, 1 - 0.1 * i, 0.2 + 0.1 * i ) )
+			script.addChild( constant )
+
+			crop = GafferImage.Crop()
+			crop["in"].setInput( constant["out"] )
+			crop["area"].setValue( imath.Box2i( imath.V2i( 13 * i, 7 * i ), imath.V2i( 100 + 17 * i, 70 + 11 * i ) ) )
+			script.addChild( crop )
+
+			script["merge"]["in"][i].setInput( crop["out"] )
+
+			if previous is None :
+				previous = crop["out"]
+			else :
+				chain = GafferImage.Merge()
+				chain["in"][0].setInput( previous )
+				chain["in"][1].setInput( crop["out"] )
+				script.addChild( chain )
+				chainedMerges.append( chain )
+				previous = chain["out"]
+
+		for operation in [
+			GafferImage.Merge.Operation.Add,
+			GafferImage.Merge.Operation.Atop,
+			GafferImage.Merge.Operation.In,
+			GafferImage.Merge.Operation.Out,
+			GafferImage.Merge.Operation.Mask,
+			GafferImage.Merge.Operation.Matte,
+			GafferImage.Merge.Operation.Multiply,
+			GafferImage.Merge.Operation.Over,
+			GafferImage.Merge.Operation.Subtract,
+			GafferImage.Merge.Operation.Difference,
+			GafferImage.Merge.Operation.Under,
+			GafferImage.Merge.Operation.Min,
+			GafferImage.Merge.Operation.Max,
+		] :
+
+			script["merge"]["operation"].setValue( operation )
+			for c in chainedMerges :
+				c["operation"].setValue( operation )
+
+			self.assertImagesEqual( script["merge"]["out"], previous, maxDifference = 1e-6 )
+
+	def testUniformTiles( self ) :
+
+		# Merge has a fast path for the uniform tiles output by Constant.
+		# Check that it matches the regular path, which we get by feeding
+		# in Checkerboards with identical colours.
+
+		constantMerge = GafferImage.Merge()
+		checkerboardMerge = GafferImage.Merge()
+
+		nodes = []
+		for i, color in enumerate( [
+			imath.Color4f( 0.1, 0.2, 0.3, 0.4 ),
+			imath.Color4f( 1, 0.3, 0.1, 0.2 ),
+			imath.Color4f( 0.5, 0.5, 0.25, 0.75 ),
+		] ) :
+
+			constant = GafferImage.Constant()
+			constant["color"].setValue( color )
+
+			checkerboard = GafferImage.Checkerboard()
+			checkerboard["format"].setInput( constant["format"] )
+			checkerboard["colorA"].setInput( constant["color"] )
+			checkerboard["colorB"].setInput( constant["color"] )
+
+			constantMerge["in"][i].setInput( constant["out"] )
+			checkerboardMerge["in"][i].setInput( checkerboard["out"] )
+			nodes.extend( [ constant, checkerboard ] )
+
+		checkerboardMerge["operation"].setInput( constantMerge["operation"] )
+
+		for operation in [
+			GafferImage.Merge.Operation.Add,
+			GafferImage.Merge.Operation.Atop,
+			GafferImage.Merge.Operation.Divide,
+			GafferImage.Merge.Operation.In,
+			GafferImage.Merge.Operation.Out,
+			GafferImage.Merge.Operation.Mask,
+			GafferImage.Merge.Operation.Matte,
+			GafferImage.Merge.Operation.Multiply,
+			GafferImage.Merge.Operation.Over,
+			GafferImage.Merge.Operation.Subtract,
+			GafferImage.Merge.Operation.Difference,
+			GafferImage.Merge.Operation.Under,
+			GafferImage.Merge.Operation.Min,
+			GafferImage.Merge.Operation.Max
+		] :
+
+			constantMerge["operation"].setValue( operation )
+			self.assertImagesEqual( constantMerge["out"], checkerboardMerge["out"] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testManyLayersPerformance( self ) :
+
+		# We use Checkerboards rather than Constants, because Constant outputs
+		# uniform tiles, which would only exercise Merge's uniform fast path.
+
+		checkerboards = []
+		merge = GafferImage.Merge()
+		merge["operation"].setValue( GafferImage.Merge.Operation.Over )
+
+		for i in range( 0, 32 ) :
+
+			checkerboard = GafferImage.Checkerboard()
+			checkerboard["format"].setValue( GafferImage.Format( 4096, 2160 ) )
+			checkerboard["colorA"].setValue( imath.Color4f( i / 32.0, 0.5, 0.25, 0.1 ) )
+			checkerboard["colorB"].setValue( imath.Color4f( 0.5, i / 32.0, 0.75, 0.2 ) )
+			checkerboards.append( checkerboard )
+
+			merge["in"][i].setInput( checkerboard["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( merge["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
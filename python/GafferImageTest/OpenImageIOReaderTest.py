@@ -615,6 +615,52 @@ class OpenImageIOReaderTest( GafferImageTest.ImageTestCase ) :
 		self.assertNotEqual( h2, h3 )
 		self.assertEqual( h1, h4 )
 
+	def __writeMultiLayerImage( self, fileName, mode, numLayers = 10, size = 1024 ) :
+
+		image = self.multiLayerImage( numLayers, GafferImage.Format( size, size ) )
+
+		writer = GafferImage.ImageWriter()
+		writer["in"].setInput( image["out"] )
+		writer["fileName"].setValue( fileName )
+		writer["openexr"]["mode"].setValue( mode )
+		writer["openexr"]["dataType"].setValue( "float" )
+		writer.execute()
+
+		return image
+
+	def testConcurrentTileBatchReads( self ) :
+
+		for mode in [ GafferImage.ImageWriter.Mode.Scanline, GafferImage.ImageWriter.Mode.Tile ] :
+
+			fileName = os.path.join( self.temporaryDirectory(), "multiLayer{0}.exr".format( mode ) )
+			source = self.__writeMultiLayerImage( fileName, mode, numLayers = 3, size = 600 )
+
+			reader = GafferImage.OpenImageIOReader()
+			reader["fileName"].setValue( fileName )
+
+			# Processing tiles in parallel reads multiple tile batches
+			# concurrently.
+			GafferImageTest.processTiles( reader["out"] )
+
+			# The file may store the channels in a different order,
+			# so we compare them individually.
+			readImage = GafferImage.ImageAlgo.image( reader["out"] )
+			sourceImage = GafferImage.ImageAlgo.image( source["out"] )
+			self.assertEqual( set( readImage.keys() ), set( sourceImage.keys() ) )
+			for channelName in sourceImage.keys() :
+				self.assertEqual( readImage[channelName].data, sourceImage[channelName].data, channelName )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testMultiLayerReadPerformance( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "multiLayer.exr" )
+		self.__writeMultiLayerImage( fileName, GafferImage.ImageWriter.Mode.Tile, size = 2048 )
+
+		reader = GafferImage.OpenImageIOReader()
+		reader["fileName"].setValue( fileName )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( reader["out"] )
 
 if __name__ == "__main__":
 	unittest.main()
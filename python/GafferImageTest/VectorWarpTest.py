@@ -178,5 +178,82 @@ class VectorWarpTest( GafferImageTest.ImageTestCase ) :
 		self.assertImagesEqual( vectorWarp["out"], expectedReader["out"], maxDifference = 0.0005, ignoreMetadata = True )
 
 
+	def __distortedMultiLayerImage( self, numLayers, size ) :
+
+		image = self.multiLayerImage( numLayers, GafferImage.Format( size, size ) )
+		image["Checkerboard"]["size"].setValue( imath.V2f( 13 ) )
+
+		# A vector image describing a smoothly varying distortion,
+		# as produced by lens distortion, where each pixel has a
+		# different filter footprint.
+
+		xRamp = GafferImage.Ramp()
+		xRamp["format"].setValue( GafferImage.Format( size, size ) )
+		xRamp["endPosition"].setValue( imath.V2f( size, 0 ) )
+		xRamp["ramp"]["p1"]["y"].setValue( imath.Color4f( 1.1, 0, 0, 1 ) )
+		yRamp = GafferImage.Ramp()
+		yRamp["format"].setValue( GafferImage.Format( size, size ) )
+		yRamp["endPosition"].setValue( imath.V2f( 0, size ) )
+		yRamp["ramp"]["p1"]["y"].setValue( imath.Color4f( 0, 0.9, 0, 1 ) )
+
+		merge = GafferImage.Merge()
+		merge["operation"].setValue( GafferImage.Merge.Operation.Add )
+		merge["in"][0].setInput( xRamp["out"] )
+		merge["in"][1].setInput( yRamp["out"] )
+
+		vectorWarp = GafferImage.VectorWarp()
+		vectorWarp["in"].setInput( image["out"] )
+		vectorWarp["vector"].setInput( merge["out"] )
+
+		return vectorWarp, [ image, xRamp, yRamp, merge ]
+
+	def testChannelsShareFilterWeights( self ) :
+
+		vectorWarp, nodes = self.__distortedMultiLayerImage( numLayers = 2, size = 200 )
+		tileOrigin = imath.V2i( GafferImage.ImagePlug.tileSize() )
+
+		for filter in [ "box", "cubic", "lanczos3", "disk" ] :
+
+			vectorWarp["filter"].setValue( filter )
+
+			with Gaffer.Context() as c :
+				c["image:channelName"] = "R"
+				c["image:tileOrigin"] = tileOrigin
+				sampleRegions = vectorWarp["__sampleRegions"].getValue()
+
+			# Separable filters should use the weights shared between channels,
+			# and non-separable ones should fall back to `FilterAlgo.sampleBox()`.
+			self.assertEqual( "pixelFilterWeights" in sampleRegions, filter != "disk" )
+
+			positions = sampleRegions["pixelInputPositions"]
+			derivatives = sampleRegions["pixelInputDerivatives"]
+
+			# Whichever path was taken, each channel must match a direct
+			# per-channel call to `FilterAlgo.sampleBox()`.
+			for channel in [ "R", "layer0.G", "layer1.A" ] :
+				sampler = GafferImage.Sampler(
+					vectorWarp["in"], channel, sampleRegions["tileInputBound"].value,
+					GafferImage.Sampler.BoundingMode.Black
+				)
+				channelData = vectorWarp["out"].channelData( channel, tileOrigin )
+				for i in range( 0, len( channelData ) ) :
+					self.assertAlmostEqual(
+						channelData[i],
+						GafferImage.FilterAlgo.sampleBox( sampler, positions[i], derivatives[i][0], derivatives[i][1], filter ),
+						places = 6
+					)
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testManyChannelsPerformance( self ) :
+
+		vectorWarp, nodes = self.__distortedMultiLayerImage( numLayers = 10, size = 2000 )
+
+		# Compute the vectors up front, so we measure
+		# only the warp itself.
+		GafferImageTest.processTiles( vectorWarp["vector"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( vectorWarp["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -114,6 +114,21 @@ Gaffer.Metadata.registerNode(
 			"plugValueWidget:type", "GafferUI.PresetsPlugValueWidget",
 		],
 
+		"framesInParallel" : [
+
+			"description",
+			"""
+			The maximum number of frames to write at once, when a
+			batch of several frames is executed in a single process.
+			Writing frames in parallel can make better use of the
+			available cores, particularly when the upstream network
+			contains computations which are the same for every frame.
+			The number of frames is limited automatically so that
+			they fit comfortably within the compute cache.
+			""",
+
+		],
+
 		"out" : [
 
 			"description",
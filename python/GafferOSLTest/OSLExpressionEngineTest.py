@@ -44,6 +44,7 @@ import re
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferDispatch
 import GafferDispatchTest
 import GafferOSL
@@ -696,5 +697,19 @@ class OSLExpressionEngineTest( GafferOSLTest.OSLTestCase ) :
 			self.assertAlmostEqual( s["dest%i"%i]["p"].getValue().y, 0.2 + 0.3 * i + 10 * i, places = 5 )
 			self.assertAlmostEqual( s["dest%i"%i]["p"].getValue().z, 0.3 + 0.3 * i + 10 * i, places = 5 )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		# Comparable to ExpressionTest.testNativeExpressionPerformance
+		# and ExpressionTest.testPythonExpressionPerformance.
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent.n.op1 = context( "iteration", 0 ) * 2 + 1;', "OSL" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferTest.parallelGetValue( s["n"]["sum"], 100000 )
+
 if __name__ == "__main__":
 	unittest.main()
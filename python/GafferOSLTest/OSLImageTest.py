@@ -593,5 +593,52 @@ class OSLImageTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( oslImage["out"]["format"].getValue().getDisplayWindow(), imath.Box2i( imath.V2i( 0 ), imath.V2i( 4, 4 ) ) )
 		self.assertEqual( GafferImage.ImageAlgo.image( oslImage["out"] )["G"], IECore.FloatVectorData( [0.6] * 16 ) )
 
+	def testBatchedShading( self ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( imath.Box2i( imath.V2i( -100, 0 ), imath.V2i( 2100, 70 ) ) ) )
+
+		globals = GafferOSL.OSLShader()
+		globals.loadShader( "Utility/Globals" )
+
+		outP = GafferOSL.OSLShader()
+		outP.loadShader( "ImageProcessing/OutLayer" )
+		outP["parameters"]["layerColor"].setInput( globals["out"]["globalP"] )
+
+		imageShader = GafferOSL.OSLShader()
+		imageShader.loadShader( "ImageProcessing/OutImage" )
+		imageShader["parameters"]["in0"].setInput( outP["out"]["layer"] )
+
+		image = GafferOSL.OSLImage()
+		image["in"].setInput( constant["out"] )
+		image["shader"].setInput( imageShader["out"]["out"] )
+
+		dataWindow = image["out"]["dataWindow"].getValue()
+		tileSize = GafferImage.ImagePlug.tileSize()
+
+		with Gaffer.PerformanceMonitor() as pm :
+
+			tileOrigin = GafferImage.ImagePlug.tileOrigin( dataWindow.min() )
+			while tileOrigin.y < dataWindow.max().y :
+				tileOrigin.x = GafferImage.ImagePlug.tileOrigin( dataWindow.min() ).x
+				while tileOrigin.x < dataWindow.max().x :
+					r = image["out"].channelData( "R", tileOrigin )
+					g = image["out"].channelData( "G", tileOrigin )
+					self.assertEqual( len( r ), GafferImage.ImagePlug.tilePixels() )
+					for i in ( 0, tileSize - 1, len( r ) - 1 ) :
+						x = tileOrigin.x + i % tileSize
+						y = tileOrigin.y + i // tileSize
+						self.assertEqual( r[i], x + 0.5, "Pixel {},{}".format( x, y ) )
+						self.assertEqual( g[i], y + 0.5, "Pixel {},{}".format( x, y ) )
+					tileOrigin.x += tileSize
+				tileOrigin.y += tileSize
+
+			# Tiles outside the data window are not shaded.
+			self.assertEqual( image["out"].channelData( "R", imath.V2i( -1024, 0 ) ), GafferImage.ImagePlug.blackTile() )
+
+		# The data window spans tiles -2 to 32 horizontally, which are
+		# shaded in 4 batches per row of tiles, and there are 2 rows.
+		self.assertEqual( pm.plugStatistics( image["__shading"] ).computeCount, 8 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -1080,5 +1080,65 @@ class OSLShaderTest( GafferOSLTest.OSLTestCase ) :
 
 		self.assertEqual( shaderAssignment["out"].attributes( "/plane" ).keys(), [ "osl:surface" ] )
 
+	def __prewarmScript( self, numShaders ) :
+
+		s = Gaffer.ScriptNode()
+		s["constant"] = GafferImage.Constant()
+
+		# Start the chain with a random value, so that the network
+		# isn't already in the ShadingEngine cache.
+		previous = None
+		for i in range( 0, numShaders ) :
+			add = GafferOSL.OSLShader( "add{}".format( i ) )
+			add.loadShader( "Maths/AddFloat" )
+			add["parameters"]["b"].setValue( random.random() if previous is None else 1 )
+			if previous is not None :
+				add["parameters"]["a"].setInput( previous["out"]["out"] )
+			s.addChild( add )
+			previous = add
+
+		s["outChannel"] = GafferOSL.OSLShader()
+		s["outChannel"].loadShader( "ImageProcessing/OutChannel" )
+		s["outChannel"]["parameters"]["channelName"].setValue( "R" )
+		s["outChannel"]["parameters"]["channelValue"].setInput( previous["out"]["out"] )
+
+		s["outImage"] = GafferOSL.OSLShader()
+		s["outImage"].loadShader( "ImageProcessing/OutImage" )
+		s["outImage"]["parameters"]["in0"].setInput( s["outChannel"]["out"]["channel"] )
+
+		s["image"] = GafferOSL.OSLImage()
+		s["image"]["in"].setInput( s["constant"]["out"] )
+		s["image"]["shader"].setInput( s["outImage"]["out"]["out"] )
+
+		return s
+
+	def testPrewarmShadingEngines( self ) :
+
+		s = self.__prewarmScript( 10 )
+
+		task = GafferOSL.OSLShader.prewarmShadingEngines( s )
+		task.wait()
+		self.assertEqual( task.status(), Gaffer.BackgroundTask.Status.Completed )
+
+		r = s["image"]["out"].channelData( "R", imath.V2i( 0 ) )
+		self.assertAlmostEqual( r[0], s["add0"]["parameters"]["b"].getValue() + 9, places = 5 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testFirstShadePerformance( self ) :
+
+		s = self.__prewarmScript( 500 )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			s["image"]["out"].channelData( "R", imath.V2i( 0 ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testFirstShadeAfterPrewarmPerformance( self ) :
+
+		s = self.__prewarmScript( 500 )
+		GafferOSL.OSLShader.prewarmShadingEngines( s ).wait()
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			s["image"]["out"].channelData( "R", imath.V2i( 0 ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -41,6 +41,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferOSL
 import GafferOSLTest
 
@@ -906,5 +907,72 @@ class ShadingEngineTest( GafferOSLTest.OSLTestCase ) :
 
 		self.assertFalse( e.hasDeformation() )
 
+	def testUniformInputs( self ) :
+
+		shader = self.compileShader( os.path.dirname( __file__ ) + "/shaders/attribute.osl" )
+
+		e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+			shaders = {
+				"output" : IECoreScene.Shader( shader, "osl:surface", { "name" : "floatUserData" } ),
+			},
+			output = "output"
+		) )
+
+		# Uniform attributes give the same result for every point.
+
+		points = self.rectanglePoints()
+		points["floatUserData"] = IECore.FloatData( 0.5 )
+
+		p = e.shade( points )
+		self.assertEqual( p["Ci"], IECore.Color3fVectorData( [ imath.Color3f( 0.5 ) ] * len( points["P"] ) ) )
+
+		# But varying attributes must still be shaded point by point.
+
+		points["floatUserData"] = IECore.FloatVectorData( [ float( i ) for i in range( 0, len( points["P"] ) ) ] )
+
+		p = e.shade( points )
+		self.assertEqual( p["Ci"], IECore.Color3fVectorData( [ imath.Color3f( i ) for i in range( 0, len( points["P"] ) ) ] ) )
+
+	def __planePoints( self, divisions ) :
+
+		plane = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), divisions )
+		return IECore.CompoundData( { "P" : plane["P"].data } )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testShadePerformance( self ) :
+
+		shader = self.compileShader( os.path.dirname( __file__ ) + "/shaders/globals.osl" )
+
+		e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+			shaders = {
+				"output" : IECoreScene.Shader( shader, "osl:surface", { "global" : "P" } )
+			},
+			output = "output"
+		) )
+
+		# 10M points
+		points = self.__planePoints( imath.V2i( 3161 ) )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			e.shade( points )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testShadeUniformPerformance( self ) :
+
+		shader = self.compileShader( os.path.dirname( __file__ ) + "/shaders/constant.osl" )
+
+		e = GafferOSL.ShadingEngine( IECoreScene.ShaderNetwork(
+			shaders = {
+				"output" : IECoreScene.Shader( shader, "osl:surface", { "Cs" : imath.Color3f( 1, 0.5, 0.25 ) } )
+			},
+			output = "output"
+		) )
+
+		# 10M points
+		points = self.__planePoints( imath.V2i( 3161 ) )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			e.shade( points )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -226,5 +226,146 @@ class RendererTest( GafferTest.TestCase ) :
 
 		del o
 
+	def testCullingStatistics( self ) :
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" )
+		renderer.output( "test", IECoreScene.Output( self.temporaryDirectory() + "/testCullingStatistics.exr", "exr", "rgba", {} ) )
+
+		attributes = renderer.attributes( IECore.CompoundObject() )
+
+		renderer.object(
+			"/visibleSphere",
+			IECoreScene.SpherePrimitive(),
+			attributes
+		).transform(
+			imath.M44f().translate( imath.V3f( 0, 0, -5 ) )
+		)
+
+		renderer.object(
+			"/offscreenSphere",
+			IECoreScene.SpherePrimitive(),
+			attributes
+		).transform(
+			imath.M44f().translate( imath.V3f( 1000, 0, -5 ) )
+		)
+
+		renderer.render()
+
+		statistics = renderer.command( "gl:queryCullingStatistics", {} )
+		self.assertEqual( statistics["objects"].value, 2 )
+		self.assertEqual( statistics["objectsRendered"].value, 1 )
+		self.assertEqual( statistics["objectsCulled"].value, 1 )
+
+	def testBatchStatistics( self ) :
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" )
+		renderer.output( "test", IECoreScene.Output( self.temporaryDirectory() + "/testBatchStatistics.exr", "exr", "rgba", {} ) )
+		renderer.option( "gl:selection", IECore.PathMatcherData( IECore.PathMatcher( [ "/sphere0" ] ) ) )
+
+		attributes = renderer.attributes( IECore.CompoundObject() )
+
+		# Spheres sharing a primitive and attributes are batched together,
+		# except for the selected one, which needs different state.
+
+		for i in range( 0, 10 ) :
+			renderer.object(
+				"/sphere{}".format( i ),
+				IECoreScene.SpherePrimitive(),
+				attributes
+			).transform(
+				imath.M44f().translate( imath.V3f( i * 0.1, 0, -5 ) )
+			)
+
+		# A different primitive gets a batch of its own.
+
+		renderer.object(
+			"/bigSphere",
+			IECoreScene.SpherePrimitive( 2 ),
+			attributes
+		).transform(
+			imath.M44f().translate( imath.V3f( 0, 0, -10 ) )
+		)
+
+		renderer.render()
+
+		statistics = renderer.command( "gl:queryBatchStatistics", {} )
+		self.assertEqual( statistics["batches"].value, 3 )
+		self.assertEqual( statistics["batchedObjects"].value, 11 )
+		self.assertEqual( statistics["boundingBoxObjects"].value, 0 )
+		# Spheres can't be instanced, so each needs its own draw call.
+		self.assertEqual( statistics["instancedObjects"].value, 0 )
+		self.assertEqual( statistics["drawCalls"].value, 11 )
+
+		# Batches above the threshold are drawn as bounding boxes,
+		# with a single draw call per batch.
+
+		renderer.option( "gl:batch:boundingBoxThreshold", IECore.IntData( 5 ) )
+		renderer.render()
+
+		statistics = renderer.command( "gl:queryBatchStatistics", {} )
+		self.assertEqual( statistics["batches"].value, 3 )
+		self.assertEqual( statistics["boundingBoxObjects"].value, 9 )
+		self.assertEqual( statistics["drawCalls"].value, 3 )
+
+		renderer.option( "gl:batch:boundingBoxThreshold", None )
+		renderer.render()
+
+		statistics = renderer.command( "gl:queryBatchStatistics", {} )
+		self.assertEqual( statistics["boundingBoxObjects"].value, 0 )
+		self.assertEqual( statistics["drawCalls"].value, 11 )
+
+	def testInstancedMeshes( self ) :
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" )
+		renderer.output( "test", IECoreScene.Output( self.temporaryDirectory() + "/testInstancedMeshes.exr", "exr", "rgba", {} ) )
+
+		attributes = renderer.attributes( IECore.CompoundObject() )
+		box = IECoreScene.MeshPrimitive.createBox( imath.Box3f( imath.V3f( -0.1 ), imath.V3f( 0.1 ) ) )
+
+		# Two boxes either side of the centre of the image. If the
+		# per-instance transforms weren't applied, they would both
+		# be drawn in the centre instead.
+
+		for i, x in enumerate( [ -0.5, 0.5 ] ) :
+			renderer.object(
+				"/box{}".format( i ),
+				box,
+				attributes
+			).transform(
+				imath.M44f().translate( imath.V3f( x, 0, -5 ) )
+			)
+
+		renderer.render()
+
+		statistics = renderer.command( "gl:queryBatchStatistics", {} )
+		self.assertEqual( statistics["batches"].value, 1 )
+		self.assertEqual( statistics["instancedObjects"].value, 2 )
+		self.assertEqual( statistics["drawCalls"].value, 1 )
+
+		image = IECore.Reader.create( self.temporaryDirectory() + "/testInstancedMeshes.exr" ).read()
+		dimensions = image.dataWindow.size() + imath.V2i( 1 )
+		row = dimensions.x * int( dimensions.y * 0.5 )
+
+		self.assertEqual( image["A"][row + int( dimensions.x * 0.5 )], 0 )
+		self.assertTrue( any( image["A"][row + x] > 0 for x in range( 0, int( dimensions.x * 0.5 ) ) ) )
+		self.assertTrue( any( image["A"][row + x] > 0 for x in range( int( dimensions.x * 0.5 ), dimensions.x ) ) )
+
+		# Many instances are still drawn with a single draw call.
+
+		for i in range( 2, 10 ) :
+			renderer.object(
+				"/box{}".format( i ),
+				box,
+				attributes
+			).transform(
+				imath.M44f().translate( imath.V3f( 0, i * 0.1, -5 ) )
+			)
+
+		renderer.render()
+
+		statistics = renderer.command( "gl:queryBatchStatistics", {} )
+		self.assertEqual( statistics["instancedObjects"].value, 10 )
+		self.assertEqual( statistics["drawCalls"].value, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 from RendererTest import RendererTest
+from BoundingVolumeHierarchyTest import BoundingVolumeHierarchyTest
 from VisualiserTest import VisualiserTest
 
 if __name__ == "__main__":
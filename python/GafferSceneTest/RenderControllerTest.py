@@ -34,6 +34,7 @@
 #
 ##########################################################################
 
+import time
 import unittest
 
 import imath
@@ -330,6 +331,114 @@ class RenderControllerTest( GafferSceneTest.SceneTestCase ) :
 		links = renderer.capturedObject( "/group/spheres/instances/sphere/0" ).capturedLinks( "lights" )
 		self.assertEqual( len( links ), numLights )
 
+	def __instancedSpheres( self, numSpheres ) :
+
+		# Spheres instanced in a line along the x axis,
+		# roughly two units apart and centred on the origin.
+
+		sphere = GafferScene.Sphere()
+
+		plane = GafferScene.Plane()
+		plane["name"].setValue( "points" )
+		plane["dimensions"].setValue( imath.V2f( numSpheres, 1 ) )
+		plane["divisions"].setValue( imath.V2i( numSpheres / 2 - 1, 1 ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["prototypes"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/points" )
+
+		return sphere, plane, instancer
+
+	def testPriorityView( self ) :
+
+		sphere, plane, instancer = self.__instancedSpheres( 1000 )
+
+		pointsFilter = GafferScene.PathFilter()
+		pointsFilter["paths"].setValue( IECore.StringVectorData( [ "/points" ] ) )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( instancer["out"] )
+		attributes["filter"].setInput( pointsFilter["out"] )
+		attributes["attributes"].addChild( Gaffer.NameValuePlug( "user:test", IECore.IntData( 1 ) ) )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( attributes["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 10 )
+
+		# The identity matrix is an orthographic view of the [-1, 1]
+		# cube around the origin, which contains only the central spheres.
+		controller.setPriorityView( imath.M44f() )
+
+		controller.updateInBackground().wait()
+
+		def capturedSphere( i ) :
+
+			return renderer.capturedObject( "/points/instances/sphere/{}".format( i ) )
+
+		# Locations outside the view must be updated too, but only
+		# after those inside it.
+
+		for i in ( 0, 250, 999 ) :
+			self.assertIsNotNone( capturedSphere( i ) )
+			self.assertEqual( capturedSphere( i ).capturedSamples()[0].radius(), 1 )
+
+		for i in ( 0, 999 ) :
+			self.assertLess( capturedSphere( 250 ).id(), capturedSphere( i ).id() )
+
+		# Locations inside the view must not be updated again by the
+		# update of the rest of the scene. The single attribute edit is
+		# the one made when the object was created.
+
+		for i in ( 0, 250, 999 ) :
+			self.assertEqual( capturedSphere( i ).numAttributeEdits(), 1 )
+
+		# Edits to ancestors must be applied exactly once to all descendants,
+		# whether they are inside the view or not.
+
+		attributes["attributes"][0]["value"].setValue( 2 )
+		controller.updateInBackground().wait()
+
+		for i in ( 0, 250, 999 ) :
+			self.assertEqual( capturedSphere( i ).numAttributeEdits(), 2 )
+			self.assertEqual( capturedSphere( i ).capturedAttributes().attributes()["user:test"], IECore.IntData( 2 ) )
+
+		# And to edits of the objects themselves.
+
+		sphere["radius"].setValue( 2 )
+		controller.updateInBackground().wait()
+
+		for i in ( 0, 250, 999 ) :
+			self.assertEqual( capturedSphere( i ).capturedSamples()[0].radius(), 2 )
+
+		# Clearing the view restores a regular update.
+
+		controller.clearPriorityView()
+		sphere["radius"].setValue( 3 )
+		controller.updateInBackground().wait()
+
+		for i in ( 0, 250, 999 ) :
+			self.assertEqual( capturedSphere( i ).capturedSamples()[0].radius(), 3 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testTimeToFirstVisibleObject( self ) :
+
+		sphere, plane, instancer = self.__instancedSpheres( 100000 )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( instancer["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 10 )
+		controller.setPriorityView( imath.M44f() )
+
+		# Sphere 25000 is at the origin, in the middle of the view.
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			task = controller.updateInBackground()
+			while renderer.capturedObject( "/points/instances/sphere/25000" ) is None :
+				time.sleep( 0.001 )
+
+		task.wait()
+
 	def testHideLinkedLight( self ) :
 
 		# One default light and one non-default light, which will
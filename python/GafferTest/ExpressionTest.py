@@ -1513,5 +1513,139 @@ class ExpressionTest( GafferTest.TestCase ) :
 			self.assertAlmostEqual( s["dest%i"%i]["p"].getValue().y, 0.2 + 0.3 * i + 10 * i, places = 5 )
 			self.assertAlmostEqual( s["dest%i"%i]["p"].getValue().z, 0.3 + 0.3 * i + 10 * i, places = 5 )
 
+	def testNativeExecutionMatchesPython( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		for name, plugType, value in [
+			( "i", Gaffer.IntPlug, 7 ),
+			( "f", Gaffer.FloatPlug, 2.5 ),
+			( "s", Gaffer.StringPlug, "hello" ),
+			( "b", Gaffer.BoolPlug, True ),
+		] :
+			s["n"]["user"][name + "In"] = plugType( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+			s["n"]["user"][name + "In"].setValue( value )
+			s["n"]["user"][name + "Out"] = plugType( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+
+		context = Gaffer.Context()
+		context.setFrame( 10.5 )
+		context["x"] = 3
+		context["name"] = "/a/b"
+
+		def evaluate( expression, plugName ) :
+
+			s["e"].setExpression( 'import math\nx = parent["n"]["user"]["iIn"]\nparent["n"]["user"]["%s"] = %s' % ( plugName, expression ) )
+			with context :
+				return s["n"]["user"][plugName].getValue()
+
+		for expression, plugName in [
+			( "x * 2 + 1", "iOut" ),
+			( "-7 / 2", "iOut" ),
+			( "-7 // 2 + 7 % -3", "iOut" ),
+			( "-7.5 // 2 + 7.5 % -2", "fOut" ),
+			( "2 ** 10", "iOut" ),
+			( "2 ** -1", "fOut" ),
+			( "parent['n']['user']['iIn'] * parent['n']['user']['fIn']", "fOut" ),
+			( "context.getFrame() / context.getFramesPerSecond()", "fOut" ),
+			( "context.getTime()", "fOut" ),
+			( 'context["frame"] * context.get( "x", 1 ) + context.get( "y", 2 )', "fOut" ),
+			( '"name" in context and "y" not in context', "bOut" ),
+			( 'parent["n"]["user"]["bIn"] and not parent["n"]["user"]["fIn"] > 2', "bOut" ),
+			( '0 or parent["n"]["user"]["fIn"]', "fOut" ),
+			( '"%s-%04d-%.2f-%s" % ( parent["n"]["user"]["sIn"], x, 3.14159, 0.1 + 0.2 )', "sOut" ),
+			( '"%d%%|%5s|%-5s|%g" % ( 2.7, "a", "b", 1e16 )', "sOut" ),
+			( 'str( 100.0 ) + str( True ) + str( 1e16 ) + str( 1 / 3.0 )', "sOut" ),
+			( 'context["name"] + "/" + parent["n"]["user"]["sIn"]', "sOut" ),
+			( '"a" if "/a" in context["name"] else "b"', "sOut" ),
+			( 'min( 3, 1.5, x ) + max( 1, 2 ) + abs( -3 )', "fOut" ),
+			( 'int( " 42 " ) + int( -3.9 ) + len( "abcd" )', "iOut" ),
+			( 'float( "1.5" ) + round( 2.5 ) + round( -2.5 )', "fOut" ),
+			( 'math.floor( 2.7 ) + math.sqrt( 16 ) + math.sin( math.pi / 2 ) + math.pow( 2, 3 )', "fOut" ),
+			( 'math.radians( parent["n"]["user"]["fIn"] ) + math.radians( 45 ) + math.radians( 123.456 )', "fOut" ),
+			( 'math.degrees( parent["n"]["user"]["fIn"] ) + math.degrees( math.pi / 3 ) + math.degrees( 0.1 )', "fOut" ),
+			( '1 < 2 and "b" > "a" and 1 != "a"', "bOut" ),
+			( '1.9', "iOut" ),
+			( 'True', "fOut" ),
+		] :
+			# `pass` isn't supported natively, so forces execution
+			# by the Python engine.
+			self.assertEqual(
+				evaluate( expression, plugName ),
+				evaluate( expression + "\npass", plugName ),
+				expression
+			)
+
+	def testNativeExecutionFallback( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["e"] = Gaffer.Expression()
+
+		# These expressions can be parsed by the native engine,
+		# but produce values which it can't handle with exactly
+		# Python's semantics, so must be executed by Python.
+
+		s["e"].setExpression( 'parent["n"]["op1"] = context.get( "x", 10 ) / context.get( "y", 1 )' )
+		self.assertEqual( s["n"]["sum"].getValue(), 10 )
+		with Gaffer.Context() as c :
+			c["y"] = 0
+			self.assertRaisesRegexp( RuntimeError, "ZeroDivisionError", s["n"]["sum"].getValue )
+
+		s["e"].setExpression( 'parent["n"]["op1"] = 1 if context.get( "x" ) else 2' )
+		self.assertEqual( s["n"]["sum"].getValue(), 2 )
+
+		s["e"].setExpression( 'parent["n"]["op1"] = len( str( 10 ** 20 ) )' )
+		self.assertEqual( s["n"]["sum"].getValue(), 21 )
+
+		s["e"].setExpression( 'parent["n"]["op1"] = 1 if 1 < "a" else 2' )
+		self.assertEqual( s["n"]["sum"].getValue(), 1 )
+
+		s["e"].setExpression( 'parent["n"]["op1"] = context["x"]' )
+		self.assertRaisesRegexp( RuntimeError, 'Context has no entry named "x"', s["n"]["sum"].getValue )
+		with Gaffer.Context() as c :
+			c["x"] = 3
+			self.assertEqual( s["n"]["sum"].getValue(), 3 )
+
+		# Values which Python can't apply to a plug must produce
+		# the same error when computed natively.
+
+		s["n"]["user"]["b"] = Gaffer.BoolPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		errors = []
+		for expression in [
+			'parent["n"]["user"]["b"] = 0.5',
+			# `pass` isn't supported natively, so forces execution
+			# by the Python engine.
+			'parent["n"]["user"]["b"] = 0.5\npass',
+		] :
+			s["e"].setExpression( expression )
+			with self.assertRaises( RuntimeError ) as cm :
+				s["n"]["user"]["b"].getValue()
+			errors.append( str( cm.exception ) )
+
+		self.assertEqual( errors[0], errors[1] )
+
+	def __testExpressionPerformance( self, expression, language = "python" ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( expression, language )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferTest.parallelGetValue( s["n"]["sum"], 100000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testNativeExpressionPerformance( self ) :
+
+		self.__testExpressionPerformance( 'parent["n"]["op1"] = context["iteration"] * 2 + 1' )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPythonExpressionPerformance( self ) :
+
+		self.__testExpressionPerformance( 'parent["n"]["op1"] = context["iteration"] * 2 + 1\npass' )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -988,6 +988,82 @@ class GraphComponentTest( GafferTest.TestCase ) :
 			c = s[n]
 			self.assertEqual( c.getName(), n )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testGetChildWithManyChildren( self ) :
+
+		GafferTest.testGraphComponentGetChildPerformance( 10000, 10 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testMakeNamesUniqueWithManyChildren( self ) :
+
+		GafferTest.testGraphComponentUniqueNamesPerformance( 10000 )
+
+	def testManyChildren( self ) :
+
+		# Enough children to exercise the accelerated
+		# lookups used for large numbers of children.
+
+		s = Gaffer.ScriptNode()
+		with Gaffer.UndoScope( s ) :
+			for i in range( 0, 200 ) :
+				s.addChild( Gaffer.Node( "n" ) )
+
+		def assertChildren( names ) :
+
+			self.assertEqual( [ c.getName() for c in s.children( Gaffer.Node ) ], names )
+			for n in names :
+				self.assertEqual( s[n].getName(), n )
+
+		assertChildren( [ "n" ] + [ "n%d" % i for i in range( 1, 200 ) ] )
+		self.assertNotIn( "n200", s )
+
+		# Undo
+
+		s.undo()
+		assertChildren( [] )
+		for i in range( 0, 200 ) :
+			self.assertNotIn( "n%d" % i, s )
+
+		s.redo()
+		assertChildren( [ "n" ] + [ "n%d" % i for i in range( 1, 200 ) ] )
+
+		# Renaming
+
+		n10 = s["n10"]
+		self.assertEqual( n10.setName( "x" ), "x" )
+		self.assertNotIn( "n10", s )
+		self.assertTrue( s["x"].isSame( n10 ) )
+
+		self.assertEqual( n10.setName( "n5" ), "n200" )
+		self.assertTrue( s["n200"].isSame( n10 ) )
+		self.assertNotIn( "x", s )
+
+		# The renamed child's own suffix is not considered
+		# when making its new name unique.
+
+		self.assertEqual( n10.setName( "n199" ), "n200" )
+		self.assertTrue( s["n200"].isSame( n10 ) )
+
+		# Removing
+
+		n199 = s["n199"]
+		s.removeChild( n199 )
+		self.assertNotIn( "n199", s )
+
+		s.addChild( n199 )
+		self.assertTrue( s["n199"].isSame( n199 ) )
+
+		s.removeChild( n10 )
+		s.removeChild( n199 )
+		n = Gaffer.Node( "n" )
+		s.addChild( n )
+		self.assertEqual( n.getName(), "n199" )
+
+		# Descendant lookups
+
+		s["n150"]["user"]["p"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		self.assertTrue( s.descendant( "n150.user.p" ).isSame( s["n150"]["user"]["p"] ) )
+
 	def testNoneIsNotAGraphComponent( self ) :
 
 		g = Gaffer.GraphComponent()
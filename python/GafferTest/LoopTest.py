@@ -221,5 +221,45 @@ class LoopTest( GafferTest.TestCase ) :
 		self.assertIsInstance( s2["c"]["previous"], Gaffer.IntPlug )
 		self.assertIsInstance( s2["c"]["next"], Gaffer.IntPlug )
 
+	def testManyIterations( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n"] = self.intLoop()
+		s["a"] = GafferTest.AddNode()
+
+		s["n"]["in"].setValue( 0 )
+		s["n"]["next"].setInput( s["a"]["sum"] )
+		s["a"]["op1"].setInput( s["n"]["previous"] )
+		s["a"]["op2"].setValue( 1 )
+
+		# Iterations are evaluated in turn rather than recursively, so
+		# we can exceed the Python recursion limit, even though each
+		# iteration calls into Python.
+
+		s["n"]["iterations"].setValue( 5000 )
+		self.assertEqual( s["n"]["out"].getValue(), 5000 )
+
+		s["n"]["iterations"].setValue( 5001 )
+		self.assertEqual( s["n"]["out"].getValue(), 5001 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testIterationsPerformance( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n"] = self.intLoop()
+		s["m"] = GafferTest.MultiplyNode()
+
+		s["n"]["in"].setValue( 1 )
+		s["n"]["next"].setInput( s["m"]["product"] )
+		s["m"]["op1"].setInput( s["n"]["previous"] )
+		s["m"]["op2"].setValue( -1 )
+
+		s["n"]["iterations"].setValue( 1000 )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			self.assertEqual( s["n"]["out"].getValue(), 1 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -1162,5 +1162,98 @@ class MetadataTest( GafferTest.TestCase ) :
 		with self.assertRaisesRegexp( Exception, "did not match C\+\+ signature" ) :
 			Gaffer.Metadata.value( None, "test" )
 
+	def testPlugValues( self ) :
+
+		n = self.DerivedAddNode()
+		n["user"]["p"] = Gaffer.Color3fPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "op*", "testPlugValues", "wildcard" )
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "op1", "testPlugValues", "exact" )
+		Gaffer.Metadata.registerValue( self.DerivedAddNode, "sum", "testPlugValues", "derived" )
+		Gaffer.Metadata.registerValue( Gaffer.Color3fPlug, "g", "testPlugValues", "ancestor" )
+		Gaffer.Metadata.registerValue( Gaffer.FloatPlug, "testPlugValues", "type" )
+		Gaffer.Metadata.registerValue( n["user"]["p"]["b"], "testPlugValues", "instance" )
+
+		def assertMatchesValue( root, instanceOnly = False ) :
+
+			expected = [
+				( p, Gaffer.Metadata.value( p, "testPlugValues", instanceOnly = instanceOnly ) )
+				for p in Gaffer.Plug.RecursiveRange( root )
+			]
+			expected = [ x for x in expected if x[1] is not None ]
+
+			self.assertEqual(
+				[ ( p.fullName(), v ) for p, v in Gaffer.Metadata.plugValues( root, "testPlugValues", instanceOnly = instanceOnly ) ],
+				[ ( p.fullName(), v ) for p, v in expected ],
+			)
+
+		assertMatchesValue( n )
+		assertMatchesValue( n, instanceOnly = True )
+		assertMatchesValue( n["user"] )
+		assertMatchesValue( n["user"]["p"] )
+
+		self.assertEqual(
+			dict( ( p.getName(), v ) for p, v in Gaffer.Metadata.plugValues( n, "testPlugValues" ) ),
+			{
+				"op1" : "exact",
+				"op2" : "wildcard",
+				"sum" : "derived",
+				"r" : "type",
+				"g" : "ancestor",
+				"b" : "instance",
+			}
+		)
+
+		# Registrations must be reflected in subsequent queries.
+
+		Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "op1", "testPlugValues" )
+		Gaffer.Metadata.deregisterValue( Gaffer.FloatPlug, "testPlugValues" )
+		Gaffer.Metadata.registerValue( Gaffer.Node, "user.*.r", "testPlugValues", "node" )
+
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testPlugValues" ), "wildcard" )
+		self.assertEqual( Gaffer.Metadata.value( n["user"]["p"]["r"], "testPlugValues" ), "node" )
+		assertMatchesValue( n )
+
+		Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "op*", "testPlugValues" )
+		Gaffer.Metadata.deregisterValue( self.DerivedAddNode, "sum", "testPlugValues" )
+		Gaffer.Metadata.deregisterValue( Gaffer.Color3fPlug, "g", "testPlugValues" )
+		Gaffer.Metadata.deregisterValue( Gaffer.Node, "user.*.r", "testPlugValues" )
+
+		self.assertEqual(
+			[ ( p.getName(), v ) for p, v in Gaffer.Metadata.plugValues( n, "testPlugValues" ) ],
+			[ ( "b", "instance" ) ]
+		)
+
+	def __metadataPerformanceScript( self ) :
+
+		s = Gaffer.ScriptNode()
+		for i in range( 0, 10000 ) :
+			s.addChild( GafferTest.AddNode() )
+
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "op*", "testPerformance", "wildcard" )
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "sum", "testPerformance", "exact" )
+		self.addCleanup( Gaffer.Metadata.deregisterValue, GafferTest.AddNode, "op*", "testPerformance" )
+		self.addCleanup( Gaffer.Metadata.deregisterValue, GafferTest.AddNode, "sum", "testPerformance" )
+
+		return s
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testValuePerformance( self ) :
+
+		s = self.__metadataPerformanceScript()
+		with GafferTest.TestRunner.PerformanceScope() :
+			numValues = GafferTest.testMetadataValuePerformance( s, "testPerformance", False )
+
+		self.assertEqual( numValues, 30000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPlugValuesPerformance( self ) :
+
+		s = self.__metadataPerformanceScript()
+		with GafferTest.TestRunner.PerformanceScope() :
+			numValues = GafferTest.testMetadataValuePerformance( s, "testPerformance", True )
+
+		self.assertEqual( numValues, 30000 )
+
 if __name__ == "__main__":
 	unittest.main()
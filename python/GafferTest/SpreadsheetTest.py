@@ -543,5 +543,100 @@ class SpreadsheetTest( GafferTest.TestCase ) :
 		self.assertEqual( len( values ), 6 )
 		self.assertEqual( len( exceptions ), 0 )
 
+	def testRowPrecedence( self ) :
+
+		s = Gaffer.Spreadsheet()
+		s["rows"].addColumn( Gaffer.IntPlug( "i" ) )
+
+		for i, name in enumerate( [ "a b", "c*", "cat", "b", "dog", "[cd]og", "x" ] ) :
+			row = s["rows"].addRow()
+			row["name"].setValue( name )
+			row["cells"]["i"]["value"].setValue( i + 1 )
+
+		s["rows"][7]["enabled"].setValue( False )
+
+		for selector, expected in [
+			( "a", 1 ),
+			( "b", 1 ),
+			# Wildcard in an earlier row takes precedence
+			# over an exact match in a later one.
+			( "cat", 2 ),
+			( "cow", 2 ),
+			# Exact match in an earlier row takes precedence
+			# over a wildcard in a later one.
+			( "dog", 5 ),
+			( "cog", 2 ),
+			( "dig", 0 ),
+			# Disabled rows are ignored.
+			( "x", 0 ),
+			( "", 0 ),
+			( "a b", 0 ),
+		] :
+			s["selector"].setValue( selector )
+			self.assertEqual( s["out"]["i"].getValue(), expected, selector )
+
+		s["selector"].setValue( "cat" )
+		s["rows"][2]["enabled"].setValue( False )
+		self.assertEqual( s["out"]["i"].getValue(), 3 )
+
+		s["selector"].setValue( "cog" )
+		self.assertEqual( s["out"]["i"].getValue(), 6 )
+
+		s["rows"][2]["enabled"].setValue( True )
+		s["rows"][2]["name"].setValue( "ca" )
+		s["selector"].setValue( "cat" )
+		self.assertEqual( s["out"]["i"].getValue(), 3 )
+
+		s["rows"][3]["name"].setValue( "" )
+		self.assertEqual( s["out"]["i"].getValue(), 0 )
+
+	def testRowsMapHashedOncePerSpreadsheet( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["s"] = Gaffer.Spreadsheet()
+		s["s"]["selector"].setValue( "${testSelector}" )
+		s["s"]["rows"].addColumn( Gaffer.IntPlug( "i" ) )
+		for i in range( 1, 101 ) :
+			row = s["s"]["rows"].addRow()
+			row["name"].setValue( "row{0}".format( i ) )
+			row["cells"]["i"]["value"].setValue( i )
+
+		def assertRowsMapHashCount( expectedHashCount ) :
+
+			with Gaffer.PerformanceMonitor() as m :
+				for i in range( 1, 101 ) :
+					with Gaffer.Context() as c :
+						c["testSelector"] = "row{0}".format( i )
+						c["testRowName"] = "row1"
+						self.assertEqual( s["s"]["out"]["i"].getValue(), i )
+
+			self.assertEqual( m.plugStatistics( s["s"]["__rowsMap"] ).hashCount, expectedHashCount )
+
+		# The rows don't depend on the context, so they are hashed
+		# only once, however many selector values we look up.
+
+		assertRowsMapHashCount( 1 )
+
+		# Rows which do depend on the context must be hashed
+		# in each context.
+
+		s["s"]["rows"][1]["name"].setValue( "${testRowName}" )
+		assertRowsMapHashCount( 100 )
+
+		s["s"]["rows"][1]["name"].setValue( "row1" )
+		assertRowsMapHashCount( 1 )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["s"]["rows"]["row2"]["name"] = "row2"' )
+		assertRowsMapHashCount( 100 )
+
+		del s["e"]
+		assertRowsMapHashCount( 1 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSelectorPerformance( self ) :
+
+		GafferTest.testSpreadsheetSelectorPerformance( 5000, 1000000 )
+
 if __name__ == "__main__":
 	unittest.main()
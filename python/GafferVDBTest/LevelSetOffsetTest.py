@@ -79,3 +79,22 @@ class LevelSetOffsetTest( GafferVDBTest.VDBTestCase ) :
 		levelSetOffset["offset"].setValue( 1.0 )
 		self.assertEqualTolerance( 4.0, levelSetOffset['out'].bound( "sphere" ).max()[0], 0.05 )
 		self.assertTrue( 640 <= levelSetOffset['out'].object( "sphere" ).findGrid( "surface" ).leafCount() <= 650)
+
+	def testZeroOffsetPassesThrough( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		meshToLevelSet = GafferVDB.MeshToLevelSet()
+		self.setFilter( meshToLevelSet, path='/sphere' )
+		meshToLevelSet["voxelSize"].setValue( 0.1 )
+		meshToLevelSet["in"].setInput( sphere["out"] )
+
+		levelSetOffset = GafferVDB.LevelSetOffset()
+		self.setFilter( levelSetOffset, path='/sphere' )
+		levelSetOffset["in"].setInput( meshToLevelSet["out"] )
+
+		self.assertNotEqual( levelSetOffset["out"].objectHash( "/sphere" ), meshToLevelSet["out"].objectHash( "/sphere" ) )
+
+		levelSetOffset["offset"].setValue( 0.0 )
+		self.assertEqual( levelSetOffset["out"].objectHash( "/sphere" ), meshToLevelSet["out"].objectHash( "/sphere" ) )
+		self.assertEqual( levelSetOffset["out"].object( "/sphere" ), meshToLevelSet["out"].object( "/sphere" ) )
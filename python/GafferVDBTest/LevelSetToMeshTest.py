@@ -118,3 +118,74 @@ class LevelSetToMeshTest( GafferVDBTest.VDBTestCase ) :
 		levelSetToMesh['adaptivity'].setValue(1.0)
 		self.assertTrue( 2800 <= len( levelSetToMesh['out'].object( "sphere" ).verticesPerFace ) <= 3200 )
 
+	def testClip( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["radius"].setValue( 5 )
+
+		meshToLevelSet = GafferVDB.MeshToLevelSet()
+		self.setFilter( meshToLevelSet, path='/sphere' )
+		meshToLevelSet["voxelSize"].setValue( 0.05 )
+		meshToLevelSet["in"].setInput( sphere["out"] )
+
+		levelSetToMesh = GafferVDB.LevelSetToMesh()
+		self.setFilter( levelSetToMesh, path='/sphere' )
+		levelSetToMesh["in"].setInput( meshToLevelSet["out"] )
+
+		unclippedMesh = levelSetToMesh["out"].object( "/sphere" )
+		unclippedHash = levelSetToMesh["out"].objectHash( "/sphere" )
+
+		# Changing the bound has no effect until clipping is turned on.
+
+		clipBound = imath.Box3f( imath.V3f( 0, -6, -6 ), imath.V3f( 6, 6, 6 ) )
+		levelSetToMesh["clipBound"].setValue( clipBound )
+		self.assertEqual( levelSetToMesh["out"].objectHash( "/sphere" ), unclippedHash )
+
+		levelSetToMesh["clip"].setValue( True )
+		self.assertNotEqual( levelSetToMesh["out"].objectHash( "/sphere" ), unclippedHash )
+
+		clippedMesh = levelSetToMesh["out"].object( "/sphere" )
+		self.assertTrue( isinstance( clippedMesh, IECoreScene.MeshPrimitive ) )
+		self.assertLess( clippedMesh.numFaces(), unclippedMesh.numFaces() )
+		self.assertGreater( clippedMesh.numFaces(), 0 )
+
+		# Allow a voxel's leeway at the clipping plane.
+		self.assertGreaterEqual( clippedMesh.bound().min().x, -0.05 )
+		self.assertEqualTolerance( 5.0, clippedMesh.bound().max().x, 0.05 )
+
+		bound = levelSetToMesh["out"].bound( "/sphere" )
+		self.assertEqual( bound.min().x, 0 )
+		self.assertEqualTolerance( 5.0, bound.max().x, 0.05 )
+		self.assertTrue( clipBound.intersects( bound.min() ) )
+		self.assertTrue( clipBound.intersects( bound.max() ) )
+
+		# Bounds outside the level set produce an empty mesh.
+
+		levelSetToMesh["clipBound"].setValue( imath.Box3f( imath.V3f( 10 ), imath.V3f( 11 ) ) )
+		self.assertEqual( levelSetToMesh["out"].object( "/sphere" ).numFaces(), 0 )
+		self.assertTrue( levelSetToMesh["out"].bound( "/sphere" ).isEmpty() )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testClipPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["radius"].setValue( 5 )
+		sphere["divisions"].setValue( imath.V2i( 200, 400 ) )
+
+		meshToLevelSet = GafferVDB.MeshToLevelSet()
+		self.setFilter( meshToLevelSet, path='/sphere' )
+		meshToLevelSet["voxelSize"].setValue( 0.01 )
+		meshToLevelSet["in"].setInput( sphere["out"] )
+
+		levelSetToMesh = GafferVDB.LevelSetToMesh()
+		self.setFilter( levelSetToMesh, path='/sphere' )
+		levelSetToMesh["in"].setInput( meshToLevelSet["out"] )
+		levelSetToMesh["clip"].setValue( True )
+		levelSetToMesh["clipBound"].setValue( imath.Box3f( imath.V3f( 4.5, -0.5, -0.5 ), imath.V3f( 5.5, 0.5, 0.5 ) ) )
+
+		# Exclude the cost of generating the level set.
+		meshToLevelSet["out"].object( "/sphere" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			levelSetToMesh["out"].object( "/sphere" )
+
@@ -34,6 +34,8 @@
 #
 ##########################################################################
 
+import imath
+
 import GafferTest
 
 import GafferVDB
@@ -119,3 +121,87 @@ class MeshToLevelSetTest( GafferVDBTest.VDBTestCase ) :
 		meshToLevelSet["grid"].setValue( "fooBar" )
 		obj2 = meshToLevelSet['out'].object( "sphere" )
 		self.assertEqual( obj2.gridNames(), ["fooBar"] )
+
+	def testMergeDescendants( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 4, 0, 0 ) )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( duplicate["out"] )
+		group["transform"]["translate"].setValue( imath.V3f( 0, 10, 0 ) )
+
+		meshToLevelSet = GafferVDB.MeshToLevelSet()
+		self.setFilter( meshToLevelSet, path='/group' )
+		meshToLevelSet["voxelSize"].setValue( 0.1 )
+		meshToLevelSet["in"].setInput( group["out"] )
+
+		# Without merging, nothing happens, because there is no
+		# mesh at the filtered location.
+
+		self.assertScenesEqual( meshToLevelSet["out"], group["out"] )
+
+		# With merging, the two spheres are converted into a single
+		# grid in the space of the group.
+
+		meshToLevelSet["mergeDescendants"].setValue( True )
+
+		grid = meshToLevelSet["out"].object( "/group" ).findGrid( "surface" )
+		bboxMin, bboxMax = grid.evalActiveVoxelBoundingBox()
+		self.assertAlmostEqual( bboxMin[0] * 0.1, -1, delta = 0.5 )
+		self.assertAlmostEqual( bboxMax[0] * 0.1, 5, delta = 0.5 )
+		self.assertAlmostEqual( bboxMin[1] * 0.1, -1, delta = 0.5 )
+		self.assertAlmostEqual( bboxMax[1] * 0.1, 1, delta = 0.5 )
+
+		singleSphere = GafferVDB.MeshToLevelSet()
+		self.setFilter( singleSphere, path='/sphere' )
+		singleSphere["voxelSize"].setValue( 0.1 )
+		singleSphere["in"].setInput( sphere["out"] )
+		self.assertEqual(
+			grid.leafCount(),
+			2 * singleSphere["out"].object( "/sphere" ).findGrid( "surface" ).leafCount()
+		)
+
+		# The descendants themselves are left unchanged.
+
+		self.assertEqual( meshToLevelSet["out"].object( "/group/sphere" ), group["out"].object( "/group/sphere" ) )
+
+		# Changing a descendant's transform changes the result.
+
+		hash1 = meshToLevelSet["out"].objectHash( "/group" )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 6, 0, 0 ) )
+		self.assertNotEqual( meshToLevelSet["out"].objectHash( "/group" ), hash1 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testMergeDescendantsPerformance( self ) :
+
+		# 5000 small meshes
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 8, 16 ) )
+		sphere["radius"].setValue( 0.1 )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 4999 )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 0.25, 0, 0 ) )
+		duplicate["transform"]["rotate"].setValue( imath.V3f( 0, 1, 0 ) )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( duplicate["out"] )
+
+		meshToLevelSet = GafferVDB.MeshToLevelSet()
+		self.setFilter( meshToLevelSet, path='/group' )
+		meshToLevelSet["voxelSize"].setValue( 0.02 )
+		meshToLevelSet["mergeDescendants"].setValue( True )
+		meshToLevelSet["in"].setInput( group["out"] )
+
+		# Exclude the cost of hashing the input hierarchy.
+		meshToLevelSet["out"].objectHash( "/group" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			meshToLevelSet["out"].object( "/group" )
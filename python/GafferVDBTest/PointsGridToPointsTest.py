@@ -80,5 +80,48 @@ class PointsGridToPointsTest( GafferVDBTest.VDBTestCase ) :
 		vdb = pointsGridToPoints["out"].object("/vdb")
 		self.assertTrue( isinstance( vdb, IECoreVDB.VDBObject) )
 
+	def testClip( self ) :
+
+		sceneReader = GafferScene.SceneReader( "SceneReader" )
+		sceneReader["fileName"].setValue( self.sourcePath )
+
+		pointsGridToPoints = GafferVDB.PointsGridToPoints( "PointsGridToPoints" )
+		pointsGridToPoints["in"].setInput( sceneReader["out"] )
+
+		allPoints = pointsGridToPoints["out"].object( "/vdb" )
+		allP = allPoints["P"].data
+
+		# Clip to a bound containing only the first point, and check
+		# that primitive variables are filtered to match.
+
+		clipBound = imath.Box3f( allP[0] - imath.V3f( 0.001 ), allP[0] + imath.V3f( 0.001 ) )
+		expectedIndices = [ i for i, p in enumerate( allP ) if clipBound.intersects( p ) ]
+
+		pointsGridToPoints["clip"].setValue( True )
+		pointsGridToPoints["clipBound"].setValue( clipBound )
+
+		clippedPoints = pointsGridToPoints["out"].object( "/vdb" )
+		self.assertTrue( isinstance( clippedPoints, IECoreScene.PointsPrimitive ) )
+		self.assertTrue( clippedPoints.arePrimitiveVariablesValid() )
+		self.assertEqual( clippedPoints.numPoints, len( expectedIndices ) )
+		self.assertEqual( list( clippedPoints["P"].data ), [ allP[i] for i in expectedIndices ] )
+
+		for name in allPoints.keys() :
+			self.assertIn( name, clippedPoints )
+			self.assertEqual(
+				list( clippedPoints[name].data ),
+				[ allPoints[name].data[i] for i in expectedIndices ]
+			)
+
+		# A bound containing all the points gives the unclipped result.
+
+		pointsGridToPoints["clipBound"].setValue( allPoints.bound() )
+		self.assertEqual( pointsGridToPoints["out"].object( "/vdb" ), allPoints )
+
+		# And a bound containing none gives no points.
+
+		pointsGridToPoints["clipBound"].setValue( imath.Box3f( imath.V3f( 100 ), imath.V3f( 101 ) ) )
+		self.assertEqual( pointsGridToPoints["out"].object( "/vdb" ).numPoints, 0 )
+
 if __name__ == "__main__":
 	unittest.main()
\ No newline at end of file
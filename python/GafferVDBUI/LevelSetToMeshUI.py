@@ -42,6 +42,8 @@ GafferUI.Metadata.registerNode(
 	'description',
 	"""Converts a level set VDB object to a mesh primitive .""",
 
+	'layout:activator:clipActivator', lambda node : node['clip'].getValue(),
+
 	plugs={
 		'grid' : [
 			'description',
@@ -61,6 +63,24 @@ GafferUI.Metadata.registerNode(
 			"""
 			Adaptively generate fewer polygons from level set. 0 - uniform meshing, 1 - maximum level of adaptivity.
 			"""
-		]
+		],
+		'clip' : [
+			'description',
+			"""
+			When on, only the region of the level set within the
+			clipBound is converted to a mesh. Parts of the grid outside
+			the bound are not visited at all, making this much cheaper
+			than meshing the whole grid when only a small region is
+			needed.
+			"""
+		],
+		'clipBound' : [
+			'description',
+			"""
+			The region to be converted when clip is on, specified in
+			object space.
+			""",
+			'layout:activator', 'clipActivator',
+		],
 	}
 )
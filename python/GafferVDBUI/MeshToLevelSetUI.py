@@ -66,5 +66,15 @@ GafferUI.Metadata.registerNode(
 			Defines the interior width of the level set in voxel units.
 			"""
 		],
+		'mergeDescendants' : [
+			'description',
+			"""
+			When on, the meshes at each filtered location and all its
+			descendants are converted into a single merged level set
+			at the filtered location. The descendant meshes are
+			transformed into the space of the filtered location, and
+			are converted in parallel.
+			"""
+		],
 	}
 )
@@ -41,6 +41,9 @@ GafferUI.Metadata.registerNode(
 	GafferVDB.PointsGridToPoints,
 	'description',
 	"""Converts a points grid in a VDB object to a points primitive.""",
+
+	"layout:activator:clipActivator", lambda node : node["clip"].getValue(),
+
 	plugs={
 		'grid' : [
 			'description',
@@ -67,5 +70,23 @@ GafferUI.Metadata.registerNode(
 			"""
 		],
 
+		"clip" : [
+			"description",
+			"""
+			When on, only the points within the clipBound are
+			extracted. Leaves of the grid lying entirely outside
+			the bound are skipped without reading their attributes.
+			"""
+		],
+
+		"clipBound" : [
+			"description",
+			"""
+			The region from which points are extracted when clip
+			is on, specified in object space.
+			""",
+			"layout:activator", "clipActivator",
+		],
+
 	}
 )
@@ -40,6 +40,7 @@
 #include "Gaffer/Action.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/Private/NativeExpressionEngine.h"
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/StringPlug.h"
 
@@ -52,6 +53,20 @@
 using namespace IECore;
 using namespace Gaffer;
 
+namespace
+{
+
+Expression::EnginePtr nativeEngine( const Expression *node, const std::string &language, const std::string &expression, const std::vector<ValuePlug *> &inPlugs, const std::vector<ValuePlug *> &outPlugs )
+{
+	if( language != "python" )
+	{
+		return nullptr;
+	}
+	return Private::createNativeExpressionEngine( node, expression, inPlugs, outPlugs );
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Expression implementation
 //////////////////////////////////////////////////////////////////////////
@@ -61,7 +76,7 @@ size_t Expression::g_firstPlugIndex;
 GAFFER_GRAPHCOMPONENT_DEFINE_TYPE( Expression );
 
 Expression::Expression( const std::string &name )
-	:	ComputeNode( name ), m_engine( nullptr )
+	:	ComputeNode( name ), m_engine( nullptr ), m_nativeEngine( nullptr )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 
@@ -168,6 +183,7 @@ void Expression::setExpression( const std::string &expression, const std::string
 	);
 
 	m_engine = engine;
+	m_nativeEngine = nativeEngine( this, language, expression, inPlugs, outPlugs );
 	m_contextNames = contextNames;
 	updatePlugs( inPlugs, outPlugs );
 	enginePlug()->setValue( language );
@@ -338,7 +354,18 @@ void Expression::compute( ValuePlug *output, const Context *context ) const
 			{
 				inputs.push_back( it->get() );
 			}
-			static_cast<ObjectVectorPlug *>( output )->setValue( m_engine->execute( context, inputs ) );
+			// The native engine returns null if it can't
+			// match the Python engine's result exactly.
+			ConstObjectVectorPtr values;
+			if( m_nativeEngine )
+			{
+				values = m_nativeEngine->execute( context, inputs );
+			}
+			if( !values )
+			{
+				values = m_engine->execute( context, inputs );
+			}
+			static_cast<ObjectVectorPlug *>( output )->setValue( values );
 		}
 		else
 		{
@@ -374,7 +401,22 @@ void Expression::compute( ValuePlug *output, const Context *context ) const
 
 		if( index < values->members().size() )
 		{
-			m_engine->apply( output, outPlugChild, values->members()[index].get() );
+			const Object *value = values->members()[index].get();
+			if( m_nativeEngine )
+			{
+				try
+				{
+					m_nativeEngine->apply( output, outPlugChild, value );
+					return;
+				}
+				catch( const IECore::Exception & )
+				{
+					// The native engine throws for values it can't
+					// apply. Let the Python engine try instead, so
+					// that any error is exactly the one it reports.
+				}
+			}
+			m_engine->apply( output, outPlugChild, value );
 		}
 		else
 		{
@@ -515,6 +557,7 @@ void Expression::plugSet( const Plug *plug )
 	expression = transcribe( expression, /* toInternalForm = */ false );
 	std::vector<ValuePlug *> inPlugs, outPlugs;
 	m_engine->parse( this, expression, inPlugs, outPlugs, m_contextNames );
+	m_nativeEngine = nativeEngine( this, engineType, expression, inPlugs, outPlugs );
 
 	// Alas, it's not quite that simple. Nodes might have been renamed
 	// during deserialisation (to avoid name clashes between duplicates).
@@ -49,6 +49,7 @@
 #include "boost/regex.hpp"
 
 #include <set>
+#include <unordered_map>
 
 using namespace Gaffer;
 using namespace IECore;
@@ -71,8 +72,125 @@ void validateName( const InternedString &name )
 	}
 }
 
+// Splits `name` into a prefix and a numeric suffix, returning the suffix.
+// Names without a numeric suffix are treated as having a suffix of 0.
+long splitNumericSuffix( const std::string &name, std::string &prefix )
+{
+	size_t prefixSize = name.size();
+	while( prefixSize && name[prefixSize-1] >= '0' && name[prefixSize-1] <= '9' )
+	{
+		prefixSize--;
+	}
+	prefix = name.substr( 0, prefixSize );
+	return strtol( name.c_str() + prefixSize, nullptr, 10 );
+}
+
+// Number of children at which we start maintaining a ChildNameIndex.
+// Below this, a linear search is as quick as a hashed lookup.
+const size_t g_childNameIndexThreshold = 64;
+
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// GraphComponent::ChildNameIndex
+//
+// Maps names to children, and tracks the numeric suffixes in use for each
+// name prefix. This provides constant time `getChild()` and avoids
+// scanning all siblings when `setName()` must make a name unique. It is
+// only updated by the methods which edit the hierarchy, so is subject to
+// the same threading rules as `m_children` itself.
+//////////////////////////////////////////////////////////////////////////
+
+struct GraphComponent::ChildNameIndex : boost::noncopyable
+{
+
+	ChildNameIndex( const ChildContainer &children )
+	{
+		names.reserve( children.size() );
+		for( const auto &child : children )
+		{
+			add( child.get() );
+		}
+	}
+
+	void add( GraphComponent *child )
+	{
+		if( !names.emplace( child->m_name, child ).second )
+		{
+			// Either already indexed, or a sibling with the same name
+			// is yet to be renamed by `addChildInternal()`.
+			return;
+		}
+		string prefix;
+		const long suffix = splitNumericSuffix( child->m_name.string(), prefix );
+		suffixes[prefix].insert( suffix );
+	}
+
+	void remove( const GraphComponent *child )
+	{
+		auto it = names.find( child->m_name );
+		if( it == names.end() || it->second != child )
+		{
+			return;
+		}
+		names.erase( it );
+
+		string prefix;
+		const long suffix = splitNumericSuffix( child->m_name.string(), prefix );
+		auto sIt = suffixes.find( prefix );
+		sIt->second.erase( sIt->second.find( suffix ) );
+		if( sIt->second.empty() )
+		{
+			suffixes.erase( sIt );
+		}
+	}
+
+	bool contains( const GraphComponent *child ) const
+	{
+		auto it = names.find( child->m_name );
+		return it != names.end() && it->second == child;
+	}
+
+	// Returns the largest suffix used by any child with the specified
+	// prefix, ignoring `exclude`. Returns -1 if there is no such child.
+	long maxSuffix( const string &prefix, const GraphComponent *exclude ) const
+	{
+		auto sIt = suffixes.find( prefix );
+		if( sIt == suffixes.end() )
+		{
+			return -1;
+		}
+
+		long excludedSuffix = -1;
+		if( contains( exclude ) )
+		{
+			string excludedPrefix;
+			const long s = splitNumericSuffix( exclude->m_name.string(), excludedPrefix );
+			if( excludedPrefix == prefix )
+			{
+				excludedSuffix = s;
+			}
+		}
+
+		for( auto it = sIt->second.rbegin(), eIt = sIt->second.rend(); it != eIt; ++it )
+		{
+			if( *it == excludedSuffix )
+			{
+				// Skip only the one occurrence belonging to `exclude`.
+				excludedSuffix = -1;
+				continue;
+			}
+			return *it;
+		}
+
+		return -1;
+	}
+
+	std::unordered_map<InternedString, GraphComponent *> names;
+	std::unordered_map<string, std::multiset<long>> suffixes;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // GraphComponent::Signals
 //
@@ -139,7 +257,21 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 
 	// make sure the name is unique
 	IECore::InternedString newName = name;
-	if( m_parent )
+	if( m_parent && m_parent->m_childNameIndex )
+	{
+		const ChildNameIndex &index = *m_parent->m_childNameIndex;
+		auto it = index.names.find( newName );
+		if( it != index.names.end() && it->second != this )
+		{
+			// As below, but using the index to find the largest
+			// existing suffix rather than scanning the siblings.
+			std::string prefix;
+			int suffix = StringAlgo::numericSuffix( newName.value(), 1, &prefix );
+			suffix = max( suffix, (int)index.maxSuffix( prefix, this ) + 1 );
+			newName = prefix + std::to_string( suffix );
+		}
+	}
+	else if( m_parent )
 	{
 		bool uniqueAlready = true;
 		for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
@@ -199,7 +331,16 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 
 void GraphComponent::setNameInternal( const IECore::InternedString &name )
 {
+	ChildNameIndex *index = m_parent ? m_parent->m_childNameIndex.get() : nullptr;
+	if( index )
+	{
+		index->remove( this );
+	}
 	m_name = name;
+	if( index )
+	{
+		index->add( this );
+	}
 	Signals::emitLazily( m_signals.get(), &Signals::nameChangedSignal, this );
 }
 
@@ -354,9 +495,21 @@ void GraphComponent::addChildInternal( GraphComponentPtr child, size_t index )
 		previousParent->removeChildInternal( child, false );
 	}
 
+	if( !m_childNameIndex && m_children.size() + 1 >= g_childNameIndexThreshold )
+	{
+		// Build from the existing children, whose names are
+		// known to be unique.
+		m_childNameIndex.reset( new ChildNameIndex( m_children ) );
+	}
+
 	m_children.insert( m_children.begin() + min( index, m_children.size() ), child );
 	child->m_parent = this;
 	child->setName( child->m_name.value() ); // to force uniqueness
+	if( m_childNameIndex )
+	{
+		// Indexes the child if `setName()` didn't need to rename it.
+		m_childNameIndex->add( child.get() );
+	}
 	Signals::emitLazily( m_signals.get(), &Signals::childAddedSignal, this, child.get() );
 	child->parentChanged( previousParent );
 	Signals::emitLazily( child->m_signals.get(), &Signals::parentChangedSignal, child.get(), previousParent );
@@ -419,6 +572,10 @@ void GraphComponent::removeChildInternal( GraphComponentPtr child, bool emitPare
 		throw Exception( boost::str( boost::format( "GraphComponent::removeChildInternal : \"%s\" is not a child of \"%s\"." ) % child->fullName() % fullName() ) );
 	}
 	m_children.erase( it );
+	if( m_childNameIndex )
+	{
+		m_childNameIndex->remove( child.get() );
+	}
 	child->m_parent = nullptr;
 	Signals::emitLazily( m_signals.get(), &Signals::childRemovedSignal, this, child.get() );
 	if( emitParentChanged )
@@ -435,6 +592,12 @@ size_t GraphComponent::index() const
 	return std::find( c.begin(), c.end(), this ) - c.begin();
 }
 
+const GraphComponent *GraphComponent::indexedChild( const IECore::InternedString &name ) const
+{
+	auto it = m_childNameIndex->names.find( name );
+	return it != m_childNameIndex->names.end() ? it->second : nullptr;
+}
+
 const GraphComponent::ChildContainer &GraphComponent::children() const
 {
 	return m_children;
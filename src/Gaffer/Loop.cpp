@@ -203,6 +203,19 @@ void Loop::hash( const ValuePlug *output, const Context *context, IECore::Murmur
 		{
 			tmpContext.remove( indexVariable );
 		}
+		if( index > 0 && isOutput( output ) )
+		{
+			// Hash the preceding iterations in order, so that each finds
+			// the hash of its predecessor in the cache. Otherwise we would
+			// recurse through every iteration, with the stack growing in
+			// proportion to the number of iterations.
+			for( int i = 0; i < index; ++i )
+			{
+				tmpContext.set<int>( indexVariable, i );
+				plug->hash();
+			}
+			tmpContext.set<int>( indexVariable, index );
+		}
 		h = plug->hash();
 		return;
 	}
@@ -225,6 +238,19 @@ void Loop::compute( ValuePlug *output, const Context *context ) const
 		{
 			tmpContext.remove( indexVariable );
 		}
+		if( index > 0 && isOutput( output ) )
+		{
+			// As in `hash()`, compute the preceding iterations in order so
+			// that each finds the value of its predecessor in the cache.
+			// The values are discarded here, but remain in the cache to be
+			// retrieved by the final iteration.
+			for( int i = 0; i < index; ++i )
+			{
+				tmpContext.set<int>( indexVariable, i );
+				output->setFrom( plug );
+			}
+			tmpContext.set<int>( indexVariable, index );
+		}
 		output->setFrom( plug );
 		return;
 	}
@@ -340,6 +366,12 @@ const ValuePlug *Loop::descendantPlug( const ValuePlug *plug, const std::vector<
 	return plug;
 }
 
+bool Loop::isOutput( const ValuePlug *plug ) const
+{
+	const ValuePlug *out = outPlug();
+	return plug == out || out->isAncestorOf( plug );
+}
+
 const ValuePlug *Loop::sourcePlug( const ValuePlug *output, const Context *context, int &sourceLoopIndex, IECore::InternedString &indexVariable ) const
 {
 	sourceLoopIndex = -1;
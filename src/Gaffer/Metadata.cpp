@@ -53,6 +53,9 @@
 
 #include "tbb/tbb.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 using namespace std;
 using namespace boost;
 using namespace tbb;
@@ -62,6 +65,8 @@ using namespace Gaffer;
 namespace
 {
 
+const InternedString g_ellipsis( "..." );
+
 typedef std::pair<InternedString, Metadata::ValueFunction> NamedValue;
 
 typedef multi_index::multi_index_container<
@@ -82,6 +87,31 @@ MetadataMap &metadataMap()
 	return m;
 }
 
+struct MatchPatternPathHash
+{
+	size_t operator()( const StringAlgo::MatchPatternPath &path ) const
+	{
+		size_t result = 0;
+		for( const auto &name : path )
+		{
+			result = result * 31 + std::hash<InternedString>()( name );
+		}
+		return result;
+	}
+};
+
+bool isExactPath( const StringAlgo::MatchPatternPath &path )
+{
+	for( const auto &name : path )
+	{
+		if( name == g_ellipsis || StringAlgo::hasWildcards( name.string() ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 struct GraphComponentMetadata
 {
 
@@ -110,8 +140,44 @@ struct GraphComponentMetadata
 
 	typedef map<StringAlgo::MatchPatternPath, PlugValues> PlugPathsToValues;
 
+	// The values for a single key from `plugPathsToValues`, indexed
+	// so that exact paths can be looked up directly, and only the
+	// wildcards registered for the key need to be matched.
+	struct PlugKeyValues
+	{
+
+		typedef std::unordered_map<StringAlgo::MatchPatternPath, Metadata::PlugValueFunction, MatchPatternPathHash> ExactValues;
+		typedef std::map<StringAlgo::MatchPatternPath, Metadata::PlugValueFunction> WildcardValues;
+
+		ExactValues exactValues;
+		WildcardValues wildcardValues;
+
+		const Metadata::PlugValueFunction *find( const StringAlgo::MatchPatternPath &plugPath ) const
+		{
+			auto it = exactValues.find( plugPath );
+			if( it != exactValues.end() )
+			{
+				return &it->second;
+			}
+
+			for( const auto &v : wildcardValues )
+			{
+				if( StringAlgo::match( plugPath, v.first ) )
+				{
+					return &v.second;
+				}
+			}
+
+			return nullptr;
+		}
+
+	};
+
+	typedef std::unordered_map<InternedString, PlugKeyValues> KeysToPlugValues;
+
 	Values values;
 	PlugPathsToValues plugPathsToValues;
+	KeysToPlugValues keysToPlugValues;
 
 };
 
@@ -123,6 +189,135 @@ GraphComponentMetadataMap &graphComponentMetadataMap()
 	return m;
 }
 
+// All the values registered for a particular key, for a type and
+// all its base types. These are compiled on demand, and cleared
+// whenever a type-based registration is made.
+struct CompiledLookup
+{
+
+	CompiledLookup()
+		:	value( nullptr )
+	{
+	}
+
+	// Values registered for plugs relative to the type,
+	// most derived type first.
+	std::vector<const GraphComponentMetadata::PlugKeyValues *> plugValues;
+	// Value registered for the type itself.
+	const Metadata::GraphComponentValueFunction *value;
+
+};
+
+typedef std::pair<IECore::TypeId, InternedString> CompiledLookupKey;
+
+struct CompiledLookupHashCompare
+{
+
+	size_t hash( const CompiledLookupKey &key ) const
+	{
+		return std::hash<InternedString>()( key.second ) * 31 + key.first;
+	}
+
+	bool equal( const CompiledLookupKey &a, const CompiledLookupKey &b ) const
+	{
+		return a == b;
+	}
+
+};
+
+// Metadata may be queried concurrently, so we use a concurrent
+// container for lookups compiled on demand.
+typedef concurrent_hash_map<CompiledLookupKey, CompiledLookup, CompiledLookupHashCompare> CompiledLookupCache;
+
+CompiledLookupCache &compiledLookupCache()
+{
+	static CompiledLookupCache c;
+	return c;
+}
+
+const CompiledLookup &compiledLookup( IECore::TypeId typeId, InternedString key )
+{
+	CompiledLookupCache &cache = compiledLookupCache();
+	const CompiledLookupKey cacheKey( typeId, key );
+
+	CompiledLookupCache::const_accessor readAccessor;
+	if( cache.find( readAccessor, cacheKey ) )
+	{
+		// Entries are only removed by registrations,
+		// which may not be made concurrently with queries.
+		return readAccessor->second;
+	}
+	readAccessor.release();
+
+	CompiledLookupCache::accessor writeAccessor;
+	if( cache.insert( writeAccessor, cacheKey ) )
+	{
+		CompiledLookup &lookup = writeAccessor->second;
+		const GraphComponentMetadataMap &m = graphComponentMetadataMap();
+		while( typeId != InvalidTypeId )
+		{
+			auto nIt = m.find( typeId );
+			if( nIt != m.end() )
+			{
+				auto pIt = nIt->second.keysToPlugValues.find( key );
+				if( pIt != nIt->second.keysToPlugValues.end() )
+				{
+					lookup.plugValues.push_back( &pIt->second );
+				}
+				if( !lookup.value )
+				{
+					auto vIt = nIt->second.values.find( key );
+					if( vIt != nIt->second.values.end() )
+					{
+						lookup.value = &vIt->second;
+					}
+				}
+			}
+			typeId = RunTimeTyped::baseTypeId( typeId );
+		}
+	}
+
+	return writeAccessor->second;
+}
+
+// Returns the value for `plug`, ignoring instance values. `ancestors`
+// contains lookups for the ancestors of `plug`, outermost first, and
+// `names` contains the name of the child of each ancestor on the path
+// to `plug`, such that `names.back()` is the name of `plug` itself.
+ConstDataPtr plugValue( const Plug *plug, InternedString key, const std::vector<const CompiledLookup *> &ancestors, const StringAlgo::MatchPatternPath &names )
+{
+	// Path-based values are more specific than type-based values,
+	// and take precedence when registered relative to a nearer
+	// ancestor.
+
+	StringAlgo::MatchPatternPath relativePath;
+	for( size_t i = ancestors.size(); i-- > 0; )
+	{
+		if( ancestors[i]->plugValues.empty() )
+		{
+			continue;
+		}
+
+		relativePath.assign( names.begin() + i, names.end() );
+		for( const auto &plugValues : ancestors[i]->plugValues )
+		{
+			if( const Metadata::PlugValueFunction *f = plugValues->find( relativePath ) )
+			{
+				return (*f)( plug );
+			}
+		}
+	}
+
+	// Finally look for values registered to the type.
+
+	const CompiledLookup &lookup = compiledLookup( plug->typeId(), key );
+	if( lookup.value )
+	{
+		return (*lookup.value)( plug );
+	}
+	return nullptr;
+}
+
 struct NamedInstanceValue
 {
 	NamedInstanceValue( InternedString n, ConstDataPtr v, bool p )
@@ -278,6 +473,41 @@ void registerInstanceValue( GraphComponent *instance, IECore::InternedString key
 	);
 }
 
+void plugValuesWalk( const GraphComponent *parent, InternedString key, bool instanceOnly, std::vector<const CompiledLookup *> &ancestors, StringAlgo::MatchPatternPath &names, Metadata::PlugValues &values )
+{
+	for( const auto &child : parent->children() )
+	{
+		names.push_back( child->getName() );
+
+		if( const Plug *plug = runTimeCast<const Plug>( child.get() ) )
+		{
+			ConstDataPtr value;
+			if( OptionalData iv = instanceValue( plug, key ) )
+			{
+				value = *iv;
+			}
+			else if( !instanceOnly )
+			{
+				value = plugValue( plug, key, ancestors, names );
+			}
+
+			if( value )
+			{
+				values.push_back( Metadata::PlugValues::value_type( plug, value ) );
+			}
+		}
+
+		if( !child->children().empty() )
+		{
+			ancestors.push_back( instanceOnly ? nullptr : &compiledLookup( child->typeId(), key ) );
+			plugValuesWalk( child.get(), key, instanceOnly, ancestors, names, values );
+			ancestors.pop_back();
+		}
+
+		names.pop_back();
+	}
+}
+
 void registeredInstanceValues( const GraphComponent *graphComponent, std::vector<IECore::InternedString> &keys, bool persistentOnly )
 {
 	if( const InstanceValues *im = instanceMetadata( graphComponent, /* createIfMissing = */ false ) )
@@ -386,6 +616,8 @@ void Metadata::registerValue( IECore::TypeId typeId, IECore::InternedString key,
 		m.replace( it, namedValue );
 	}
 
+	compiledLookupCache().clear();
+
 	if( typeId == Node::staticTypeId() || RunTimeTyped::inheritsFrom( typeId, Node::staticTypeId() ) )
 	{
 		nodeValueChangedSignal()( typeId, key, nullptr );
@@ -406,6 +638,7 @@ void Metadata::deregisterValue( IECore::TypeId typeId, IECore::InternedString ke
 	}
 
 	m.erase( it );
+	compiledLookupCache().clear();
 
 	if( typeId == Node::staticTypeId() || RunTimeTyped::inheritsFrom( typeId, Node::staticTypeId() ) )
 	{
@@ -420,7 +653,8 @@ void Metadata::deregisterValue( IECore::TypeId typeId, IECore::InternedString ke
 void Metadata::deregisterValue( IECore::TypeId ancestorTypeId, const StringAlgo::MatchPattern &plugPath, IECore::InternedString key )
 {
 	auto &m = graphComponentMetadataMap()[ancestorTypeId];
-	auto &plugValues = m.plugPathsToValues[StringAlgo::matchPatternPath( plugPath, '.' )];
+	const StringAlgo::MatchPatternPath path = StringAlgo::matchPatternPath( plugPath, '.' );
+	auto &plugValues = m.plugPathsToValues[path];
 
 	auto it = plugValues.find( key );
 	if( it == plugValues.end() )
@@ -429,6 +663,18 @@ void Metadata::deregisterValue( IECore::TypeId ancestorTypeId, const StringAlgo:
 	}
 
 	plugValues.erase( it );
+
+	auto &keyValues = m.keysToPlugValues[key];
+	if( isExactPath( path ) )
+	{
+		keyValues.exactValues.erase( path );
+	}
+	else
+	{
+		keyValues.wildcardValues.erase( path );
+	}
+	compiledLookupCache().clear();
+
 	plugValueChangedSignal()( ancestorTypeId, plugPath, key, nullptr );
 }
 
@@ -481,7 +727,8 @@ void Metadata::registerValue( IECore::TypeId ancestorTypeId, const StringAlgo::M
 void Metadata::registerValue( IECore::TypeId ancestorTypeId, const StringAlgo::MatchPattern &plugPath, IECore::InternedString key, PlugValueFunction value )
 {
 	auto &graphComponentMetadata = graphComponentMetadataMap()[ancestorTypeId];
-	auto &plugValues = graphComponentMetadata.plugPathsToValues[StringAlgo::matchPatternPath( plugPath, '.' )];
+	const StringAlgo::MatchPatternPath path = StringAlgo::matchPatternPath( plugPath, '.' );
+	auto &plugValues = graphComponentMetadata.plugPathsToValues[path];
 
 	GraphComponentMetadata::NamedPlugValue namedValue( key, value );
 
@@ -495,6 +742,17 @@ void Metadata::registerValue( IECore::TypeId ancestorTypeId, const StringAlgo::M
 		plugValues.replace( it, namedValue );
 	}
 
+	auto &keyValues = graphComponentMetadata.keysToPlugValues[key];
+	if( isExactPath( path ) )
+	{
+		keyValues.exactValues[path] = value;
+	}
+	else
+	{
+		keyValues.wildcardValues[path] = value;
+	}
+	compiledLookupCache().clear();
+
 	plugValueChangedSignal()( ancestorTypeId, plugPath, key, nullptr );
 }
 
@@ -526,17 +784,36 @@ std::vector<Plug*> Metadata::plugsWithMetadata( GraphComponent *root, IECore::In
 	}
 	else
 	{
-		for( FilteredRecursiveChildIterator<TypePredicate<Plug> > it( root ); !it.done(); ++it )
+		for( const auto &v : plugValues( root, key ) )
 		{
-			if( valueInternal( it->get(), key, false ) )
-			{
-				plugs.push_back( it->get() );
-			}
+			plugs.push_back( const_cast<Plug *>( v.first ) );
 		}
 	}
 	return plugs;
 }
 
+Metadata::PlugValues Metadata::plugValues( const GraphComponent *root, IECore::InternedString key, bool instanceOnly )
+{
+	// Compile the lookups for `root` and its ancestors once,
+	// and share them between all the plugs below `root`.
+	std::vector<const CompiledLookup *> ancestors;
+	StringAlgo::MatchPatternPath names;
+	for( const GraphComponent *ancestor = root; ancestor; ancestor = ancestor->parent() )
+	{
+		ancestors.push_back( instanceOnly ? nullptr : &compiledLookup( ancestor->typeId(), key ) );
+		if( ancestor->parent() )
+		{
+			names.push_back( ancestor->getName() );
+		}
+	}
+	std::reverse( ancestors.begin(), ancestors.end() );
+	std::reverse( names.begin(), names.end() );
+
+	PlugValues result;
+	plugValuesWalk( root, key, instanceOnly, ancestors, names, result );
+	return result;
+}
+
 void Metadata::registerValue( GraphComponent *target, IECore::InternedString key, IECore::ConstDataPtr value, bool persistent )
 {
 	registerInstanceValue( target, key, value, persistent );
@@ -615,71 +892,33 @@ IECore::ConstDataPtr Metadata::valueInternal( const GraphComponent *target, IECo
 		return nullptr;
 	}
 
-	// If the target is a plug, then look for a path-based
-	// value. These are more specific than type-based values.
+	// If the target is a plug, then look for path-based values
+	// registered relative to its ancestors.
 
 	if( const Plug *plug = runTimeCast<const Plug>( target ) )
 	{
-		const GraphComponent *ancestor = plug->parent();
-		vector<InternedString> plugPath( { plug->getName() } );
-		while( ancestor )
+		std::vector<const CompiledLookup *> ancestors;
+		StringAlgo::MatchPatternPath names;
+		const GraphComponent *child = plug;
+		for( const GraphComponent *ancestor = plug->parent(); ancestor; ancestor = ancestor->parent() )
 		{
-			IECore::TypeId typeId = ancestor->typeId();
-			while( typeId != InvalidTypeId )
-			{
-				auto nIt = graphComponentMetadataMap().find( typeId );
-				if( nIt != graphComponentMetadataMap().end() )
-				{
-					// First do a direct lookup using the plug path.
-					auto it = nIt->second.plugPathsToValues.find( plugPath );
-					const auto eIt = nIt->second.plugPathsToValues.end();
-					if( it != eIt )
-					{
-						auto vIt = it->second.find( key );
-						if( vIt != it->second.end() )
-						{
-							return vIt->second( plug );
-						}
-					}
-					// And only if the direct lookup fails, do a full search using
-					// wildcard matches.
-					for( it = nIt->second.plugPathsToValues.begin(); it != eIt; ++it )
-					{
-						if( StringAlgo::match( plugPath, it->first ) )
-						{
-							auto vIt = it->second.find( key );
-							if( vIt != it->second.end() )
-							{
-								return vIt->second( plug );
-							}
-						}
-					}
-				}
-				typeId = RunTimeTyped::baseTypeId( typeId );
-			}
-
-			plugPath.insert( plugPath.begin(), ancestor->getName() );
-			ancestor = ancestor->parent();
+			ancestors.push_back( &compiledLookup( ancestor->typeId(), key ) );
+			names.push_back( child->getName() );
+			child = ancestor;
 		}
+		std::reverse( ancestors.begin(), ancestors.end() );
+		std::reverse( names.begin(), names.end() );
+
+		return plugValue( plug, key, ancestors, names );
 	}
 
-	// Finally look for values registered to the type
+	// Otherwise look for values registered to the type.
 
-	IECore::TypeId typeId = target->typeId();
-	while( typeId != InvalidTypeId )
+	const CompiledLookup &lookup = compiledLookup( target->typeId(), key );
+	if( lookup.value )
 	{
-		auto nIt = graphComponentMetadataMap().find( typeId );
-		if( nIt != graphComponentMetadataMap().end() )
-		{
-			auto vIt = nIt->second.values.find( key );
-			if( vIt != nIt->second.values.end() )
-			{
-				return vIt->second( target );
-			}
-		}
-		typeId = RunTimeTyped::baseTypeId( typeId );
+		return (*lookup.value)( target );
 	}
-
 	return nullptr;
 }
 
@@ -0,0 +1,2416 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Gaffer/Private/NativeExpressionEngine.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedPlug.h"
+
+#include "IECore/NullObject.h"
+#include "IECore/ObjectVector.h"
+#include "IECore/SimpleTypedData.h"
+
+#include "boost/format.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Values. These emulate the subset of Python 2's types that we support,
+// and the Python semantics for operations on them. Anything we can't
+// emulate exactly throws `Unsupported`, to defer to the Python engine.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Unsupported
+{
+};
+
+[[noreturn]] void unsupported()
+{
+	throw Unsupported();
+}
+
+struct Value
+{
+
+	enum Type
+	{
+		Bool,
+		Int,
+		Float,
+		String
+	};
+
+	Type type = Int;
+	int64_t i = 0;
+	double f = 0;
+	std::string s;
+
+	bool isString() const
+	{
+		return type == String;
+	}
+
+	// As in Python, bools behave as integers in arithmetic.
+	bool isIntegral() const
+	{
+		return type == Bool || type == Int;
+	}
+
+	double asDouble() const
+	{
+		if( type == String )
+		{
+			unsupported();
+		}
+		return type == Float ? f : (double)i;
+	}
+
+};
+
+Value boolValue( bool b )
+{
+	Value result;
+	result.type = Value::Bool;
+	result.i = b;
+	return result;
+}
+
+Value intValue( int64_t i )
+{
+	Value result;
+	result.type = Value::Int;
+	result.i = i;
+	return result;
+}
+
+Value floatValue( double f )
+{
+	Value result;
+	result.type = Value::Float;
+	result.f = f;
+	return result;
+}
+
+Value stringValue( const std::string &s )
+{
+	Value result;
+	result.type = Value::String;
+	result.s = s;
+	return result;
+}
+
+bool truth( const Value &v )
+{
+	switch( v.type )
+	{
+		case Value::Bool :
+		case Value::Int :
+			return v.i != 0;
+		case Value::Float :
+			return v.f != 0;
+		case Value::String :
+			return !v.s.empty();
+	}
+	return false;
+}
+
+// Matches Python 2's `str( float )`.
+std::string floatToString( double f )
+{
+	if( std::isnan( f ) )
+	{
+		return "nan";
+	}
+
+	char buffer[32];
+	snprintf( buffer, sizeof( buffer ), "%.12g", f );
+	std::string result( buffer );
+	if( result.find_first_not_of( "-0123456789" ) == std::string::npos )
+	{
+		result += ".0";
+	}
+	return result;
+}
+
+std::string toString( const Value &v )
+{
+	switch( v.type )
+	{
+		case Value::Bool :
+			return v.i ? "True" : "False";
+		case Value::Int :
+			return std::to_string( v.i );
+		case Value::Float :
+			return floatToString( v.f );
+		case Value::String :
+			return v.s;
+	}
+	return "";
+}
+
+int64_t doubleToInt( double f )
+{
+	// Python would promote to a long if out of range.
+	if( !( f > -9.2e18 && f < 9.2e18 ) )
+	{
+		unsupported();
+	}
+	return (int64_t)f;
+}
+
+// Strips leading and trailing whitespace, as Python's
+// `int()` and `float()` do.
+std::string strip( const std::string &s )
+{
+	const size_t begin = s.find_first_not_of( " \t\n\r\f\v" );
+	if( begin == std::string::npos )
+	{
+		return "";
+	}
+	const size_t end = s.find_last_not_of( " \t\n\r\f\v" );
+	return s.substr( begin, end - begin + 1 );
+}
+
+int64_t toInt( const Value &v )
+{
+	switch( v.type )
+	{
+		case Value::Bool :
+		case Value::Int :
+			return v.i;
+		case Value::Float :
+			return doubleToInt( v.f );
+		case Value::String : {
+			const std::string s = strip( v.s );
+			const size_t digits = s.size() && ( s[0] == '-' || s[0] == '+' ) ? 1 : 0;
+			if( s.size() == digits || s.find_first_not_of( "0123456789", digits ) != std::string::npos )
+			{
+				unsupported();
+			}
+			errno = 0;
+			const long long result = strtoll( s.c_str(), nullptr, 10 );
+			if( errno )
+			{
+				unsupported();
+			}
+			return result;
+		}
+	}
+	return 0;
+}
+
+double toFloat( const Value &v )
+{
+	if( !v.isString() )
+	{
+		return v.asDouble();
+	}
+
+	// `strtod()` accepts hexadecimal floats, but Python doesn't.
+	const std::string s = strip( v.s );
+	if( s.empty() || s.find_first_of( "xX" ) != std::string::npos )
+	{
+		unsupported();
+	}
+	char *end = nullptr;
+	const double result = strtod( s.c_str(), &end );
+	if( *end )
+	{
+		unsupported();
+	}
+	return result;
+}
+
+template<typename T>
+std::string formatValue( const std::string &spec, T value )
+{
+	char buffer[128];
+	const int size = snprintf( buffer, sizeof( buffer ), spec.c_str(), value );
+	if( size < 0 )
+	{
+		unsupported();
+	}
+	if( size < (int)sizeof( buffer ) )
+	{
+		return std::string( buffer, size );
+	}
+
+	std::string result( size + 1, '\0' );
+	snprintf( &result[0], result.size(), spec.c_str(), value );
+	result.resize( size );
+	return result;
+}
+
+// Implements `format % args`.
+std::string format( const std::string &format, const std::vector<Value> &args )
+{
+	std::string result;
+	size_t argIndex = 0;
+	for( size_t i = 0, e = format.size(); i < e; ++i )
+	{
+		if( format[i] != '%' )
+		{
+			result += format[i];
+			continue;
+		}
+
+		if( ++i < e && format[i] == '%' )
+		{
+			result += '%';
+			continue;
+		}
+
+		std::string spec = "%";
+		while( i < e && strchr( "-+ #0", format[i] ) )
+		{
+			spec += format[i++];
+		}
+		while( i < e && isdigit( format[i] ) )
+		{
+			spec += format[i++];
+		}
+		if( i < e && format[i] == '.' )
+		{
+			spec += format[i++];
+			while( i < e && isdigit( format[i] ) )
+			{
+				spec += format[i++];
+			}
+		}
+
+		if( i >= e || argIndex >= args.size() )
+		{
+			unsupported();
+		}
+
+		const Value &arg = args[argIndex++];
+		switch( format[i] )
+		{
+			case 'd' :
+			case 'i' :
+				if( arg.isString() )
+				{
+					unsupported();
+				}
+				result += formatValue( spec + "lld", (long long)toInt( arg ) );
+				break;
+			case 'e' :
+			case 'E' :
+			case 'f' :
+			case 'F' :
+			case 'g' :
+			case 'G' :
+				result += formatValue( spec + format[i], arg.asDouble() );
+				break;
+			case 's' :
+				result += formatValue( spec + "s", toString( arg ).c_str() );
+				break;
+			default :
+				unsupported();
+		}
+	}
+
+	if( argIndex != args.size() )
+	{
+		unsupported();
+	}
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+
+enum class BinaryOp
+{
+	Add,
+	Subtract,
+	Multiply,
+	Divide,
+	FloorDivide,
+	Modulo,
+	Power
+};
+
+int64_t floorDivide( int64_t a, int64_t b )
+{
+	if( b == 0 || ( a == std::numeric_limits<int64_t>::min() && b == -1 ) )
+	{
+		unsupported();
+	}
+	int64_t result = a / b;
+	if( a % b && ( ( a < 0 ) != ( b < 0 ) ) )
+	{
+		--result;
+	}
+	return result;
+}
+
+int64_t modulo( int64_t a, int64_t b )
+{
+	if( b == 0 )
+	{
+		unsupported();
+	}
+	if( b == -1 )
+	{
+		return 0;
+	}
+	int64_t result = a % b;
+	if( result && ( ( result < 0 ) != ( b < 0 ) ) )
+	{
+		result += b;
+	}
+	return result;
+}
+
+// Float division and modulo follow CPython's `float_divmod()`.
+double modulo( double a, double b )
+{
+	if( b == 0 )
+	{
+		unsupported();
+	}
+	double mod = fmod( a, b );
+	if( mod )
+	{
+		if( ( b < 0 ) != ( mod < 0 ) )
+		{
+			mod += b;
+		}
+	}
+	else
+	{
+		mod = copysign( 0.0, b );
+	}
+	return mod;
+}
+
+double floorDivide( double a, double b )
+{
+	if( b == 0 )
+	{
+		unsupported();
+	}
+	double mod = fmod( a, b );
+	double div = ( a - mod ) / b;
+	if( mod && ( ( b < 0 ) != ( mod < 0 ) ) )
+	{
+		div -= 1.0;
+	}
+	if( div )
+	{
+		double floorDiv = floor( div );
+		if( div - floorDiv > 0.5 )
+		{
+			floorDiv += 1.0;
+		}
+		return floorDiv;
+	}
+	return copysign( 0.0, a / b );
+}
+
+double power( double a, double b )
+{
+	if( ( a == 0 && b < 0 ) || ( a < 0 && b != floor( b ) ) )
+	{
+		// Python raises ZeroDivisionError and ValueError respectively.
+		unsupported();
+	}
+	const double result = pow( a, b );
+	if( std::isinf( result ) && std::isfinite( a ) && std::isfinite( b ) )
+	{
+		// Python raises OverflowError.
+		unsupported();
+	}
+	return result;
+}
+
+Value power( int64_t a, int64_t b )
+{
+	if( b < 0 )
+	{
+		return floatValue( power( (double)a, (double)b ) );
+	}
+
+	int64_t result = 1;
+	while( b )
+	{
+		if( ( b & 1 ) && __builtin_mul_overflow( result, a, &result ) )
+		{
+			unsupported();
+		}
+		b >>= 1;
+		if( b && __builtin_mul_overflow( a, a, &a ) )
+		{
+			unsupported();
+		}
+	}
+	return intValue( result );
+}
+
+Value binaryOp( BinaryOp op, const Value &a, const Value &b )
+{
+	if( a.isString() || b.isString() )
+	{
+		if( op == BinaryOp::Add && a.isString() && b.isString() )
+		{
+			return stringValue( a.s + b.s );
+		}
+		unsupported();
+	}
+
+	if( a.isIntegral() && b.isIntegral() )
+	{
+		// Python would promote to a long in the case of overflow.
+		int64_t result = 0;
+		switch( op )
+		{
+			case BinaryOp::Add :
+				if( __builtin_add_overflow( a.i, b.i, &result ) )
+				{
+					unsupported();
+				}
+				return intValue( result );
+			case BinaryOp::Subtract :
+				if( __builtin_sub_overflow( a.i, b.i, &result ) )
+				{
+					unsupported();
+				}
+				return intValue( result );
+			case BinaryOp::Multiply :
+				if( __builtin_mul_overflow( a.i, b.i, &result ) )
+				{
+					unsupported();
+				}
+				return intValue( result );
+			case BinaryOp::Divide :
+			case BinaryOp::FloorDivide :
+				return intValue( floorDivide( a.i, b.i ) );
+			case BinaryOp::Modulo :
+				return intValue( modulo( a.i, b.i ) );
+			case BinaryOp::Power :
+				return power( a.i, b.i );
+		}
+	}
+
+	const double x = a.asDouble();
+	const double y = b.asDouble();
+	switch( op )
+	{
+		case BinaryOp::Add :
+			return floatValue( x + y );
+		case BinaryOp::Subtract :
+			return floatValue( x - y );
+		case BinaryOp::Multiply :
+			return floatValue( x * y );
+		case BinaryOp::Divide :
+			if( y == 0 )
+			{
+				unsupported();
+			}
+			return floatValue( x / y );
+		case BinaryOp::FloorDivide :
+			return floatValue( floorDivide( x, y ) );
+		case BinaryOp::Modulo :
+			return floatValue( modulo( x, y ) );
+		case BinaryOp::Power :
+			return floatValue( power( x, y ) );
+	}
+
+	return Value();
+}
+
+enum class CompareOp
+{
+	Equal,
+	NotEqual,
+	Less,
+	LessEqual,
+	Greater,
+	GreaterEqual
+};
+
+template<typename T>
+bool compare( CompareOp op, const T &a, const T &b )
+{
+	switch( op )
+	{
+		case CompareOp::Equal :
+			return a == b;
+		case CompareOp::NotEqual :
+			return a != b;
+		case CompareOp::Less :
+			return a < b;
+		case CompareOp::LessEqual :
+			return a <= b;
+		case CompareOp::Greater :
+			return a > b;
+		case CompareOp::GreaterEqual :
+			return a >= b;
+	}
+	return false;
+}
+
+bool compare( CompareOp op, const Value &a, const Value &b )
+{
+	if( a.isString() != b.isString() )
+	{
+		// Python 2 orders strings and numbers by type name,
+		// which we don't emulate. But they're never equal.
+		switch( op )
+		{
+			case CompareOp::Equal :
+				return false;
+			case CompareOp::NotEqual :
+				return true;
+			default :
+				unsupported();
+		}
+	}
+
+	if( a.isString() )
+	{
+		return compare( op, a.s, b.s );
+	}
+	else if( a.isIntegral() && b.isIntegral() )
+	{
+		return compare( op, a.i, b.i );
+	}
+	return compare( op, a.asDouble(), b.asDouble() );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Functions
+//////////////////////////////////////////////////////////////////////////
+
+typedef Value (*Function)( const std::vector<Value> &arguments );
+
+struct FunctionDescription
+{
+	Function function;
+	size_t minArguments;
+	size_t maxArguments;
+};
+
+typedef std::unordered_map<std::string, FunctionDescription> FunctionMap;
+
+Value absFunction( const std::vector<Value> &arguments )
+{
+	const Value &v = arguments[0];
+	if( v.isIntegral() )
+	{
+		if( v.i == std::numeric_limits<int64_t>::min() )
+		{
+			unsupported();
+		}
+		return intValue( std::abs( v.i ) );
+	}
+	return floatValue( fabs( v.asDouble() ) );
+}
+
+template<CompareOp op>
+Value minMaxFunction( const std::vector<Value> &arguments )
+{
+	size_t result = 0;
+	for( size_t i = 1; i < arguments.size(); ++i )
+	{
+		if( compare( op, arguments[i], arguments[result] ) )
+		{
+			result = i;
+		}
+	}
+	return arguments[result];
+}
+
+Value intFunction( const std::vector<Value> &arguments )
+{
+	return intValue( toInt( arguments[0] ) );
+}
+
+Value floatFunction( const std::vector<Value> &arguments )
+{
+	return floatValue( toFloat( arguments[0] ) );
+}
+
+Value strFunction( const std::vector<Value> &arguments )
+{
+	return stringValue( toString( arguments[0] ) );
+}
+
+Value boolFunction( const std::vector<Value> &arguments )
+{
+	return boolValue( truth( arguments[0] ) );
+}
+
+Value roundFunction( const std::vector<Value> &arguments )
+{
+	// Python 2 rounds half away from zero, and returns a float.
+	return floatValue( std::round( arguments[0].asDouble() ) );
+}
+
+Value lenFunction( const std::vector<Value> &arguments )
+{
+	if( !arguments[0].isString() )
+	{
+		unsupported();
+	}
+	return intValue( arguments[0].s.size() );
+}
+
+// Python raises ValueError or OverflowError where the C
+// functions return NaN or infinity for finite arguments.
+double checkMathResult( double result, const std::vector<Value> &arguments )
+{
+	if( std::isnan( result ) || std::isinf( result ) )
+	{
+		for( const auto &a : arguments )
+		{
+			if( !std::isfinite( a.asDouble() ) )
+			{
+				return result;
+			}
+		}
+		unsupported();
+	}
+	return result;
+}
+
+template<double (*f)( double )>
+Value mathFunction( const std::vector<Value> &arguments )
+{
+	return floatValue( checkMathResult( f( arguments[0].asDouble() ), arguments ) );
+}
+
+template<double (*f)( double, double )>
+Value mathFunction2( const std::vector<Value> &arguments )
+{
+	return floatValue( checkMathResult( f( arguments[0].asDouble(), arguments[1].asDouble() ), arguments ) );
+}
+
+double logFunction( double x )
+{
+	return log( x );
+}
+
+Value mathLogFunction( const std::vector<Value> &arguments )
+{
+	if( arguments.size() == 1 )
+	{
+		return mathFunction<logFunction>( arguments );
+	}
+	const double base = arguments[1].asDouble();
+	if( base <= 0 || base == 1 )
+	{
+		unsupported();
+	}
+	return floatValue( checkMathResult( log( arguments[0].asDouble() ) / log( base ), arguments ) );
+}
+
+// As in CPython, we multiply by a precomputed factor, which
+// doesn't always round the same way as `x * M_PI / 180.0`.
+const double g_degToRad = M_PI / 180.0;
+const double g_radToDeg = 180.0 / M_PI;
+
+double radians( double x )
+{
+	return x * g_degToRad;
+}
+
+double degrees( double x )
+{
+	return x * g_radToDeg;
+}
+
+// Wrappers to resolve the overloads of the standard functions.
+double floorFunction( double x ) { return floor( x ); }
+double ceilFunction( double x ) { return ceil( x ); }
+double sqrtFunction( double x ) { return sqrt( x ); }
+double expFunction( double x ) { return exp( x ); }
+double log10Function( double x ) { return log10( x ); }
+double fabsFunction( double x ) { return fabs( x ); }
+double sinFunction( double x ) { return sin( x ); }
+double cosFunction( double x ) { return cos( x ); }
+double tanFunction( double x ) { return tan( x ); }
+double asinFunction( double x ) { return asin( x ); }
+double acosFunction( double x ) { return acos( x ); }
+double atanFunction( double x ) { return atan( x ); }
+double atan2Function( double y, double x ) { return atan2( y, x ); }
+double hypotFunction( double x, double y ) { return hypot( x, y ); }
+double fmodFunction( double x, double y ) { return fmod( x, y ); }
+
+const size_t g_unlimited = std::numeric_limits<size_t>::max();
+
+const FunctionMap &builtinFunctions()
+{
+	static FunctionMap m = {
+		{ "abs", { absFunction, 1, 1 } },
+		{ "min", { minMaxFunction<CompareOp::Less>, 2, g_unlimited } },
+		{ "max", { minMaxFunction<CompareOp::Greater>, 2, g_unlimited } },
+		{ "int", { intFunction, 1, 1 } },
+		{ "float", { floatFunction, 1, 1 } },
+		{ "str", { strFunction, 1, 1 } },
+		{ "bool", { boolFunction, 1, 1 } },
+		{ "round", { roundFunction, 1, 1 } },
+		{ "len", { lenFunction, 1, 1 } },
+	};
+	return m;
+}
+
+const FunctionMap &mathFunctions()
+{
+	static FunctionMap m = {
+		{ "floor", { mathFunction<floorFunction>, 1, 1 } },
+		{ "ceil", { mathFunction<ceilFunction>, 1, 1 } },
+		{ "sqrt", { mathFunction<sqrtFunction>, 1, 1 } },
+		{ "exp", { mathFunction<expFunction>, 1, 1 } },
+		{ "log", { mathLogFunction, 1, 2 } },
+		{ "log10", { mathFunction<log10Function>, 1, 1 } },
+		{ "fabs", { mathFunction<fabsFunction>, 1, 1 } },
+		{ "sin", { mathFunction<sinFunction>, 1, 1 } },
+		{ "cos", { mathFunction<cosFunction>, 1, 1 } },
+		{ "tan", { mathFunction<tanFunction>, 1, 1 } },
+		{ "asin", { mathFunction<asinFunction>, 1, 1 } },
+		{ "acos", { mathFunction<acosFunction>, 1, 1 } },
+		{ "atan", { mathFunction<atanFunction>, 1, 1 } },
+		{ "atan2", { mathFunction2<atan2Function>, 2, 2 } },
+		{ "hypot", { mathFunction2<hypotFunction>, 2, 2 } },
+		{ "fmod", { mathFunction2<fmodFunction>, 2, 2 } },
+		{ "pow", { mathFunction2<power>, 2, 2 } },
+		{ "radians", { mathFunction<radians>, 1, 1 } },
+		{ "degrees", { mathFunction<degrees>, 1, 1 } },
+	};
+	return m;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Conversion to and from IECore::Data
+//////////////////////////////////////////////////////////////////////////
+
+Value dataToValue( const Object *data )
+{
+	switch( static_cast<IECore::TypeId>( data->typeId() ) )
+	{
+		case BoolDataTypeId :
+			return boolValue( static_cast<const BoolData *>( data )->readable() );
+		case IntDataTypeId :
+			return intValue( static_cast<const IntData *>( data )->readable() );
+		case FloatDataTypeId :
+			return floatValue( static_cast<const FloatData *>( data )->readable() );
+		case DoubleDataTypeId :
+			return floatValue( static_cast<const DoubleData *>( data )->readable() );
+		case StringDataTypeId :
+			return stringValue( static_cast<const StringData *>( data )->readable() );
+		default :
+			unsupported();
+	}
+}
+
+ObjectPtr valueToData( const Value &value )
+{
+	switch( value.type )
+	{
+		case Value::Bool :
+			return new BoolData( value.i );
+		case Value::Int :
+			if( value.i < std::numeric_limits<int>::min() || value.i > std::numeric_limits<int>::max() )
+			{
+				unsupported();
+			}
+			return new IntData( value.i );
+		case Value::Float :
+			return new DoubleData( value.f );
+		case Value::String :
+			return new StringData( value.s );
+	}
+	return nullptr;
+}
+
+bool supportedPlugType( const ValuePlug *plug )
+{
+	switch( static_cast<Gaffer::TypeId>( plug->typeId() ) )
+	{
+		case BoolPlugTypeId :
+		case IntPlugTypeId :
+		case FloatPlugTypeId :
+		case StringPlugTypeId :
+			return true;
+		default :
+			return false;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Terms. The parser compiles expressions into a tree of these.
+//////////////////////////////////////////////////////////////////////////
+
+struct Frame
+{
+
+	Frame( const Context *context, const std::vector<const ValuePlug *> &inputs, size_t numVariables )
+		:	context( context ), inputs( inputs ), variables( numVariables )
+	{
+	}
+
+	const Context *context;
+	const std::vector<const ValuePlug *> &inputs;
+	std::vector<Value> variables;
+
+};
+
+class Term
+{
+
+	public :
+
+		virtual ~Term()
+		{
+		}
+
+		virtual Value evaluate( Frame &frame ) const = 0;
+
+};
+
+typedef std::unique_ptr<Term> TermPtr;
+typedef std::vector<TermPtr> Terms;
+
+class LiteralTerm : public Term
+{
+
+	public :
+
+		LiteralTerm( const Value &value )
+			:	m_value( value )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			return m_value;
+		}
+
+		const Value &value() const
+		{
+			return m_value;
+		}
+
+	private :
+
+		const Value m_value;
+
+};
+
+class VariableTerm : public Term
+{
+
+	public :
+
+		VariableTerm( size_t index )
+			:	m_index( index )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			return frame.variables[m_index];
+		}
+
+	private :
+
+		const size_t m_index;
+
+};
+
+class PlugTerm : public Term
+{
+
+	public :
+
+		PlugTerm( size_t index )
+			:	m_index( index )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			const ValuePlug *plug = frame.inputs[m_index];
+			switch( static_cast<Gaffer::TypeId>( plug->typeId() ) )
+			{
+				case BoolPlugTypeId :
+					return boolValue( static_cast<const BoolPlug *>( plug )->getValue() );
+				case IntPlugTypeId :
+					return intValue( static_cast<const IntPlug *>( plug )->getValue() );
+				case FloatPlugTypeId :
+					return floatValue( static_cast<const FloatPlug *>( plug )->getValue() );
+				case StringPlugTypeId :
+					return stringValue( static_cast<const StringPlug *>( plug )->getValue() );
+				default :
+					unsupported();
+			}
+		}
+
+	private :
+
+		const size_t m_index;
+
+};
+
+// `context["name"]` and `context.get( "name", defaultValue )`.
+class ContextVariableTerm : public Term
+{
+
+	public :
+
+		ContextVariableTerm( const InternedString &name, bool get, TermPtr defaultValue )
+			:	m_name( name ), m_get( get ), m_defaultValue( std::move( defaultValue ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			if( !m_get )
+			{
+				if( const Data *d = frame.context->get<Data>( m_name, nullptr ) )
+				{
+					return dataToValue( d );
+				}
+				// Defer to Python, so that the error is reported
+				// exactly as it always has been.
+				unsupported();
+			}
+
+			// Python evaluates the default value even when it isn't used.
+			const Value defaultValue = m_defaultValue ? m_defaultValue->evaluate( frame ) : Value();
+			if( const Data *d = frame.context->get<Data>( m_name, nullptr ) )
+			{
+				return dataToValue( d );
+			}
+			else if( !m_defaultValue )
+			{
+				// Python returns `None`, which we don't support.
+				unsupported();
+			}
+			return defaultValue;
+		}
+
+	private :
+
+		const InternedString m_name;
+		const bool m_get;
+		const TermPtr m_defaultValue;
+
+};
+
+// `"name" in context` and `"name" not in context`.
+class ContextContainsTerm : public Term
+{
+
+	public :
+
+		ContextContainsTerm( const InternedString &name, bool negate )
+			:	m_name( name ), m_negate( negate )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			return boolValue( ( frame.context->get<Data>( m_name, nullptr ) != nullptr ) != m_negate );
+		}
+
+	private :
+
+		const InternedString m_name;
+		const bool m_negate;
+
+};
+
+class ContextMethodTerm : public Term
+{
+
+	public :
+
+		enum Method
+		{
+			GetFrame,
+			GetTime,
+			GetFramesPerSecond
+		};
+
+		ContextMethodTerm( Method method )
+			:	m_method( method )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			switch( m_method )
+			{
+				case GetFrame :
+					return floatValue( frame.context->getFrame() );
+				case GetTime :
+					return floatValue( frame.context->getTime() );
+				case GetFramesPerSecond :
+					return floatValue( frame.context->getFramesPerSecond() );
+			}
+			return Value();
+		}
+
+	private :
+
+		const Method m_method;
+
+};
+
+enum class UnaryOp
+{
+	Negate,
+	Plus,
+	Not
+};
+
+class UnaryTerm : public Term
+{
+
+	public :
+
+		UnaryTerm( UnaryOp op, TermPtr operand )
+			:	m_op( op ), m_operand( std::move( operand ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			const Value v = m_operand->evaluate( frame );
+			switch( m_op )
+			{
+				case UnaryOp::Negate :
+					if( v.isIntegral() )
+					{
+						if( v.i == std::numeric_limits<int64_t>::min() )
+						{
+							unsupported();
+						}
+						return intValue( -v.i );
+					}
+					return floatValue( -v.asDouble() );
+				case UnaryOp::Plus :
+					if( v.isIntegral() )
+					{
+						return intValue( v.i );
+					}
+					return floatValue( v.asDouble() );
+				case UnaryOp::Not :
+					return boolValue( !truth( v ) );
+			}
+			return Value();
+		}
+
+	private :
+
+		const UnaryOp m_op;
+		const TermPtr m_operand;
+
+};
+
+class BinaryTerm : public Term
+{
+
+	public :
+
+		BinaryTerm( BinaryOp op, TermPtr left, TermPtr right )
+			:	m_op( op ), m_left( std::move( left ) ), m_right( std::move( right ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			const Value left = m_left->evaluate( frame );
+			return binaryOp( m_op, left, m_right->evaluate( frame ) );
+		}
+
+	private :
+
+		const BinaryOp m_op;
+		const TermPtr m_left;
+		const TermPtr m_right;
+
+};
+
+// Tuples are only supported as the arguments to string formatting.
+class TupleTerm : public Term
+{
+
+	public :
+
+		TupleTerm( Terms &&items )
+			:	m_items( std::move( items ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			unsupported();
+		}
+
+		const Terms &items() const
+		{
+			return m_items;
+		}
+
+	private :
+
+		const Terms m_items;
+
+};
+
+// The `%` operator, which performs string formatting when the
+// left operand is a string, and modulo otherwise.
+class ModuloTerm : public Term
+{
+
+	public :
+
+		ModuloTerm( TermPtr left, TermPtr right )
+			:	m_left( std::move( left ) ), m_right( std::move( right ) )
+		{
+			m_tuple = dynamic_cast<const TupleTerm *>( m_right.get() );
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			const Value left = m_left->evaluate( frame );
+			if( !left.isString() )
+			{
+				return binaryOp( BinaryOp::Modulo, left, m_right->evaluate( frame ) );
+			}
+
+			std::vector<Value> arguments;
+			if( m_tuple )
+			{
+				for( const auto &item : m_tuple->items() )
+				{
+					arguments.push_back( item->evaluate( frame ) );
+				}
+			}
+			else
+			{
+				arguments.push_back( m_right->evaluate( frame ) );
+			}
+
+			return stringValue( format( left.s, arguments ) );
+		}
+
+	private :
+
+		const TermPtr m_left;
+		const TermPtr m_right;
+		const TupleTerm *m_tuple;
+
+};
+
+class CompareTerm : public Term
+{
+
+	public :
+
+		CompareTerm( CompareOp op, TermPtr left, TermPtr right )
+			:	m_op( op ), m_left( std::move( left ) ), m_right( std::move( right ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			const Value left = m_left->evaluate( frame );
+			return boolValue( compare( m_op, left, m_right->evaluate( frame ) ) );
+		}
+
+	private :
+
+		const CompareOp m_op;
+		const TermPtr m_left;
+		const TermPtr m_right;
+
+};
+
+// Substring tests.
+class InTerm : public Term
+{
+
+	public :
+
+		InTerm( TermPtr left, TermPtr right, bool negate )
+			:	m_left( std::move( left ) ), m_right( std::move( right ) ), m_negate( negate )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			const Value left = m_left->evaluate( frame );
+			const Value right = m_right->evaluate( frame );
+			if( !left.isString() || !right.isString() )
+			{
+				unsupported();
+			}
+			return boolValue( ( right.s.find( left.s ) != std::string::npos ) != m_negate );
+		}
+
+	private :
+
+		const TermPtr m_left;
+		const TermPtr m_right;
+		const bool m_negate;
+
+};
+
+// `and` and `or`, which return one of their operands.
+class BooleanTerm : public Term
+{
+
+	public :
+
+		BooleanTerm( bool isAnd, TermPtr left, TermPtr right )
+			:	m_isAnd( isAnd ), m_left( std::move( left ) ), m_right( std::move( right ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			Value left = m_left->evaluate( frame );
+			if( truth( left ) != m_isAnd )
+			{
+				return left;
+			}
+			return m_right->evaluate( frame );
+		}
+
+	private :
+
+		const bool m_isAnd;
+		const TermPtr m_left;
+		const TermPtr m_right;
+
+};
+
+class ConditionalTerm : public Term
+{
+
+	public :
+
+		ConditionalTerm( TermPtr condition, TermPtr trueValue, TermPtr falseValue )
+			:	m_condition( std::move( condition ) ), m_trueValue( std::move( trueValue ) ), m_falseValue( std::move( falseValue ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			return truth( m_condition->evaluate( frame ) ) ? m_trueValue->evaluate( frame ) : m_falseValue->evaluate( frame );
+		}
+
+	private :
+
+		const TermPtr m_condition;
+		const TermPtr m_trueValue;
+		const TermPtr m_falseValue;
+
+};
+
+class CallTerm : public Term
+{
+
+	public :
+
+		CallTerm( Function function, Terms &&arguments )
+			:	m_function( function ), m_arguments( std::move( arguments ) )
+		{
+		}
+
+		Value evaluate( Frame &frame ) const override
+		{
+			std::vector<Value> arguments;
+			arguments.reserve( m_arguments.size() );
+			for( const auto &a : m_arguments )
+			{
+				arguments.push_back( a->evaluate( frame ) );
+			}
+			return m_function( arguments );
+		}
+
+	private :
+
+		const Function m_function;
+		const Terms m_arguments;
+
+};
+
+struct Assignment
+{
+	// Index into either the variables or the outputs.
+	size_t index;
+	bool isOutput;
+	TermPtr value;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Tokenizer
+//////////////////////////////////////////////////////////////////////////
+
+struct Token
+{
+
+	enum Type
+	{
+		Name,
+		Integer,
+		Float,
+		String,
+		Operator,
+		Newline,
+		End
+	};
+
+	Token( Type type, const std::string &text, int64_t i = 0, double f = 0 )
+		:	type( type ), text( text ), i( i ), f( f )
+	{
+	}
+
+	Type type;
+	std::string text;
+	int64_t i;
+	double f;
+
+};
+
+std::vector<Token> tokenize( const std::string &expression )
+{
+	std::vector<Token> result;
+
+	const char *c = expression.c_str();
+	int depth = 0;
+	bool lineStart = true;
+	while( *c )
+	{
+		if( *c == '#' )
+		{
+			while( *c && *c != '\n' )
+			{
+				c++;
+			}
+			continue;
+		}
+
+		if( *c == '\\' && c[1] == '\n' )
+		{
+			c += 2;
+			continue;
+		}
+
+		if( *c == '\n' )
+		{
+			if( !depth && result.size() && result.back().type != Token::Newline )
+			{
+				result.push_back( Token( Token::Newline, "\n" ) );
+			}
+			lineStart = true;
+			c++;
+			continue;
+		}
+
+		if( *c == ' ' || *c == '\t' || *c == '\r' )
+		{
+			while( *c == ' ' || *c == '\t' || *c == '\r' )
+			{
+				c++;
+			}
+			if( lineStart && !depth && *c && *c != '\n' && *c != '#' )
+			{
+				// Indented blocks aren't supported.
+				unsupported();
+			}
+			continue;
+		}
+
+		lineStart = false;
+
+		if( isalpha( *c ) || *c == '_' )
+		{
+			const char *start = c;
+			while( isalnum( *c ) || *c == '_' )
+			{
+				c++;
+			}
+			if( *c == '"' || *c == '\'' )
+			{
+				// String prefix (`r`, `u` or `b`).
+				unsupported();
+			}
+			result.push_back( Token( Token::Name, std::string( start, c ) ) );
+			continue;
+		}
+
+		if( isdigit( *c ) || ( *c == '.' && isdigit( c[1] ) ) )
+		{
+			const char *start = c;
+			bool isFloat = false;
+			while( isdigit( *c ) )
+			{
+				c++;
+			}
+			if( *c == '.' )
+			{
+				isFloat = true;
+				c++;
+				while( isdigit( *c ) )
+				{
+					c++;
+				}
+			}
+			if( *c == 'e' || *c == 'E' )
+			{
+				isFloat = true;
+				c++;
+				if( *c == '+' || *c == '-' )
+				{
+					c++;
+				}
+				if( !isdigit( *c ) )
+				{
+					unsupported();
+				}
+				while( isdigit( *c ) )
+				{
+					c++;
+				}
+			}
+			if( isalnum( *c ) || *c == '_' )
+			{
+				// Long, complex, hex or octal literals.
+				unsupported();
+			}
+
+			const std::string text( start, c );
+			if( isFloat )
+			{
+				result.push_back( Token( Token::Float, text, 0, strtod( text.c_str(), nullptr ) ) );
+			}
+			else
+			{
+				if( text.size() > 1 && text[0] == '0' )
+				{
+					// Octal.
+					unsupported();
+				}
+				errno = 0;
+				const long long i = strtoll( text.c_str(), nullptr, 10 );
+				if( errno )
+				{
+					unsupported();
+				}
+				result.push_back( Token( Token::Integer, text, i ) );
+			}
+			continue;
+		}
+
+		if( *c == '"' || *c == '\'' )
+		{
+			const char quote = *c++;
+			if( *c == quote && c[1] == quote )
+			{
+				// Triple quoted strings.
+				unsupported();
+			}
+
+			std::string s;
+			while( *c != quote )
+			{
+				if( !*c || *c == '\n' )
+				{
+					unsupported();
+				}
+				if( *c != '\\' )
+				{
+					s += *c++;
+					continue;
+				}
+
+				c++;
+				switch( *c )
+				{
+					case '\\' : s += '\\'; break;
+					case '\'' : s += '\''; break;
+					case '"' : s += '"'; break;
+					case 'a' : s += '\a'; break;
+					case 'b' : s += '\b'; break;
+					case 'f' : s += '\f'; break;
+					case 'n' : s += '\n'; break;
+					case 'r' : s += '\r'; break;
+					case 't' : s += '\t'; break;
+					case 'v' : s += '\v'; break;
+					default :
+						if( !*c || *c == '\n' || *c == 'x' || *c == 'N' || *c == 'u' || *c == 'U' || isdigit( *c ) )
+						{
+							unsupported();
+						}
+						// Python preserves unrecognised escapes.
+						s += '\\';
+						s += *c;
+				}
+				c++;
+			}
+			c++;
+
+			result.push_back( Token( Token::String, s ) );
+			continue;
+		}
+
+		// Longest operators first, so they take precedence.
+		static const char *g_operators[] = {
+			"**", "//", "==", "!=", "<=", ">=",
+			"+", "-", "*", "/", "%", "<", ">", "=", "(", ")", "[", "]", ",", ".", ";"
+		};
+
+		bool matched = false;
+		for( const char *op : g_operators )
+		{
+			const size_t length = strlen( op );
+			if( !strncmp( c, op, length ) )
+			{
+				if( c[length] == '=' && strchr( "*/+-%", op[0] ) )
+				{
+					// Augmented assignment.
+					unsupported();
+				}
+				if( *op == '(' || *op == '[' )
+				{
+					depth++;
+				}
+				else if( *op == ')' || *op == ']' )
+				{
+					depth--;
+				}
+				result.push_back( { Token::Operator, op } );
+				c += length;
+				matched = true;
+				break;
+			}
+		}
+
+		if( !matched )
+		{
+			unsupported();
+		}
+	}
+
+	result.push_back( Token( Token::End, "" ) );
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Parser
+//////////////////////////////////////////////////////////////////////////
+
+class Parser
+{
+
+	public :
+
+		Parser( const Expression *node, const std::string &expression, const std::vector<ValuePlug *> &inputs, const std::vector<ValuePlug *> &outputs )
+			:	m_node( node ), m_inputs( inputs ), m_outputs( outputs ), m_tokens( tokenize( expression ) ), m_position( 0 ), m_mathImported( false )
+		{
+			while( !accept( Token::End ) )
+			{
+				if( accept( Token::Newline ) || acceptOperator( ";" ) )
+				{
+					continue;
+				}
+				parseStatement();
+				if( !accept( Token::Newline ) && !acceptOperator( ";" ) && peek().type != Token::End )
+				{
+					unsupported();
+				}
+			}
+		}
+
+		std::vector<Assignment> assignments;
+
+		size_t numVariables() const
+		{
+			return m_variables.size();
+		}
+
+	private :
+
+		const Token &peek( size_t offset = 0 ) const
+		{
+			return m_tokens[std::min( m_position + offset, m_tokens.size() - 1 )];
+		}
+
+		const Token &next()
+		{
+			const Token &result = peek();
+			if( result.type == Token::End )
+			{
+				unsupported();
+			}
+			m_position++;
+			return result;
+		}
+
+		bool accept( Token::Type type )
+		{
+			if( peek().type == type )
+			{
+				m_position++;
+				return true;
+			}
+			return false;
+		}
+
+		bool check( Token::Type type, const char *text, size_t offset = 0 ) const
+		{
+			return peek( offset ).type == type && peek( offset ).text == text;
+		}
+
+		bool acceptOperator( const char *op )
+		{
+			if( check( Token::Operator, op ) )
+			{
+				m_position++;
+				return true;
+			}
+			return false;
+		}
+
+		bool acceptName( const char *name )
+		{
+			if( check( Token::Name, name ) )
+			{
+				m_position++;
+				return true;
+			}
+			return false;
+		}
+
+		void expectOperator( const char *op )
+		{
+			if( !acceptOperator( op ) )
+			{
+				unsupported();
+			}
+		}
+
+		std::string expectString()
+		{
+			if( peek().type != Token::String )
+			{
+				unsupported();
+			}
+			std::string result;
+			while( peek().type == Token::String )
+			{
+				result += next().text;
+			}
+			return result;
+		}
+
+		static bool reservedName( const std::string &name )
+		{
+			static const std::unordered_set<std::string> g_reserved = {
+				"parent", "context", "math", "imath", "IECore",
+				"and", "or", "not", "if", "else", "in", "is", "lambda", "import", "from",
+				"True", "False", "None", "print", "exec", "del", "pass", "for", "while",
+			};
+			return g_reserved.count( name ) || builtinFunctions().count( name );
+		}
+
+		void parseStatement()
+		{
+			if( acceptName( "import" ) )
+			{
+				if( !acceptName( "math" ) )
+				{
+					unsupported();
+				}
+				m_mathImported = true;
+				return;
+			}
+
+			const Token &target = next();
+			if( target.type != Token::Name )
+			{
+				unsupported();
+			}
+
+			Assignment assignment;
+			if( target.text == "parent" )
+			{
+				assignment.index = plugIndex( m_outputs );
+				assignment.isOutput = true;
+				expectOperator( "=" );
+				assignment.value = parseTest();
+			}
+			else
+			{
+				if( reservedName( target.text ) )
+				{
+					unsupported();
+				}
+				const std::string name = target.text;
+				expectOperator( "=" );
+				// Parse the value before declaring the variable,
+				// so that `x = x + 1` is rejected when `x` is undefined.
+				assignment.value = parseTest();
+				assignment.isOutput = false;
+				assignment.index = m_variables.emplace( name, m_variables.size() ).first->second;
+			}
+
+			assignments.push_back( std::move( assignment ) );
+		}
+
+		// Parses `["a"]["b"]...` following `parent`, and returns
+		// the index of the plug in `plugs`.
+		size_t plugIndex( const std::vector<ValuePlug *> &plugs )
+		{
+			std::string path;
+			while( acceptOperator( "[" ) )
+			{
+				if( path.size() )
+				{
+					path += ".";
+				}
+				path += expectString();
+				expectOperator( "]" );
+			}
+
+			const ValuePlug *plug = m_node->parent() ? m_node->parent()->descendant<ValuePlug>( path ) : nullptr;
+			if( !plug || !supportedPlugType( plug ) )
+			{
+				unsupported();
+			}
+
+			auto it = std::find( plugs.begin(), plugs.end(), plug );
+			if( it == plugs.end() )
+			{
+				unsupported();
+			}
+			return it - plugs.begin();
+		}
+
+		TermPtr parseTest()
+		{
+			TermPtr result = parseOr();
+			if( acceptName( "if" ) )
+			{
+				TermPtr condition = parseOr();
+				if( !acceptName( "else" ) )
+				{
+					unsupported();
+				}
+				TermPtr falseValue = parseTest();
+				result.reset( new ConditionalTerm( std::move( condition ), std::move( result ), std::move( falseValue ) ) );
+			}
+			return result;
+		}
+
+		TermPtr parseOr()
+		{
+			TermPtr result = parseAnd();
+			while( acceptName( "or" ) )
+			{
+				TermPtr right = parseAnd();
+				result.reset( new BooleanTerm( /* isAnd = */ false, std::move( result ), std::move( right ) ) );
+			}
+			return result;
+		}
+
+		TermPtr parseAnd()
+		{
+			TermPtr result = parseNot();
+			while( acceptName( "and" ) )
+			{
+				TermPtr right = parseNot();
+				result.reset( new BooleanTerm( /* isAnd = */ true, std::move( result ), std::move( right ) ) );
+			}
+			return result;
+		}
+
+		TermPtr parseNot()
+		{
+			if( acceptName( "not" ) )
+			{
+				return TermPtr( new UnaryTerm( UnaryOp::Not, parseNot() ) );
+			}
+			return parseComparison();
+		}
+
+		TermPtr parseComparison()
+		{
+			TermPtr left = parseArithmetic();
+
+			static const std::pair<const char *, CompareOp> g_compareOps[] = {
+				{ "==", CompareOp::Equal },
+				{ "!=", CompareOp::NotEqual },
+				{ "<", CompareOp::Less },
+				{ "<=", CompareOp::LessEqual },
+				{ ">", CompareOp::Greater },
+				{ ">=", CompareOp::GreaterEqual }
+			};
+
+			TermPtr result;
+			for( const auto &op : g_compareOps )
+			{
+				if( acceptOperator( op.first ) )
+				{
+					TermPtr right = parseArithmetic();
+					result.reset( new CompareTerm( op.second, std::move( left ), std::move( right ) ) );
+					break;
+				}
+			}
+
+			if( !result )
+			{
+				bool negate = false;
+				if( check( Token::Name, "not" ) && check( Token::Name, "in", 1 ) )
+				{
+					m_position += 2;
+					negate = true;
+				}
+				else if( acceptName( "in" ) )
+				{
+					negate = false;
+				}
+				else
+				{
+					return left;
+				}
+
+				if( check( Token::Name, "context" ) && !check( Token::Operator, "[", 1 ) && !check( Token::Operator, ".", 1 ) )
+				{
+					m_position++;
+					const LiteralTerm *literal = dynamic_cast<const LiteralTerm *>( left.get() );
+					if( !literal || !literal->value().isString() )
+					{
+						unsupported();
+					}
+					result.reset( new ContextContainsTerm( literal->value().s, negate ) );
+				}
+				else
+				{
+					TermPtr right = parseArithmetic();
+					result.reset( new InTerm( std::move( left ), std::move( right ), negate ) );
+				}
+			}
+
+			// Chained comparisons aren't supported.
+			if( peek().type == Token::Operator )
+			{
+				for( const auto &op : g_compareOps )
+				{
+					if( check( Token::Operator, op.first ) )
+					{
+						unsupported();
+					}
+				}
+			}
+			if( check( Token::Name, "in" ) || check( Token::Name, "not" ) || check( Token::Name, "is" ) )
+			{
+				unsupported();
+			}
+
+			return result;
+		}
+
+		TermPtr parseArithmetic()
+		{
+			TermPtr result = parseMultiplicative();
+			while( true )
+			{
+				BinaryOp op;
+				if( acceptOperator( "+" ) )
+				{
+					op = BinaryOp::Add;
+				}
+				else if( acceptOperator( "-" ) )
+				{
+					op = BinaryOp::Subtract;
+				}
+				else
+				{
+					return result;
+				}
+				TermPtr right = parseMultiplicative();
+				result.reset( new BinaryTerm( op, std::move( result ), std::move( right ) ) );
+			}
+		}
+
+		TermPtr parseMultiplicative()
+		{
+			TermPtr result = parseFactor();
+			while( true )
+			{
+				BinaryOp op;
+				if( acceptOperator( "*" ) )
+				{
+					op = BinaryOp::Multiply;
+				}
+				else if( acceptOperator( "/" ) )
+				{
+					op = BinaryOp::Divide;
+				}
+				else if( acceptOperator( "//" ) )
+				{
+					op = BinaryOp::FloorDivide;
+				}
+				else if( acceptOperator( "%" ) )
+				{
+					TermPtr right = parseFactor();
+					result.reset( new ModuloTerm( std::move( result ), std::move( right ) ) );
+					continue;
+				}
+				else
+				{
+					return result;
+				}
+				TermPtr right = parseFactor();
+				result.reset( new BinaryTerm( op, std::move( result ), std::move( right ) ) );
+			}
+		}
+
+		TermPtr parseFactor()
+		{
+			if( acceptOperator( "-" ) )
+			{
+				return TermPtr( new UnaryTerm( UnaryOp::Negate, parseFactor() ) );
+			}
+			else if( acceptOperator( "+" ) )
+			{
+				return TermPtr( new UnaryTerm( UnaryOp::Plus, parseFactor() ) );
+			}
+
+			TermPtr result = parsePrimary();
+			if( acceptOperator( "**" ) )
+			{
+				TermPtr exponent = parseFactor();
+				result.reset( new BinaryTerm( BinaryOp::Power, std::move( result ), std::move( exponent ) ) );
+			}
+			return result;
+		}
+
+		TermPtr parsePrimary()
+		{
+			TermPtr result;
+
+			const Token &token = peek();
+			switch( token.type )
+			{
+				case Token::Integer :
+					result.reset( new LiteralTerm( intValue( next().i ) ) );
+					break;
+				case Token::Float :
+					result.reset( new LiteralTerm( floatValue( next().f ) ) );
+					break;
+				case Token::String :
+					result.reset( new LiteralTerm( stringValue( expectString() ) ) );
+					break;
+				case Token::Name :
+					result = parseName( next().text );
+					break;
+				case Token::Operator :
+					if( acceptOperator( "(" ) )
+					{
+						result = parseParentheses();
+						break;
+					}
+					unsupported();
+				default :
+					unsupported();
+			}
+
+			// Indexing, attributes and calls on arbitrary
+			// values are unsupported.
+			if( check( Token::Operator, "[" ) || check( Token::Operator, "(" ) || check( Token::Operator, "." ) )
+			{
+				unsupported();
+			}
+
+			return result;
+		}
+
+		TermPtr parseParentheses()
+		{
+			TermPtr result = parseTest();
+			if( acceptOperator( ")" ) )
+			{
+				return result;
+			}
+
+			Terms items;
+			items.push_back( std::move( result ) );
+			while( acceptOperator( "," ) )
+			{
+				if( acceptOperator( ")" ) )
+				{
+					return TermPtr( new TupleTerm( std::move( items ) ) );
+				}
+				items.push_back( parseTest() );
+			}
+			expectOperator( ")" );
+			return TermPtr( new TupleTerm( std::move( items ) ) );
+		}
+
+		Terms parseArguments()
+		{
+			Terms result;
+			expectOperator( "(" );
+			if( acceptOperator( ")" ) )
+			{
+				return result;
+			}
+			do
+			{
+				if( check( Token::Operator, ")" ) )
+				{
+					break;
+				}
+				result.push_back( parseTest() );
+			} while( acceptOperator( "," ) );
+			expectOperator( ")" );
+			return result;
+		}
+
+		TermPtr parseCall( const FunctionDescription &function )
+		{
+			Terms arguments = parseArguments();
+			if( arguments.size() < function.minArguments || arguments.size() > function.maxArguments )
+			{
+				unsupported();
+			}
+			return TermPtr( new CallTerm( function.function, std::move( arguments ) ) );
+		}
+
+		TermPtr parseName( const std::string &name )
+		{
+			if( name == "True" || name == "False" )
+			{
+				return TermPtr( new LiteralTerm( boolValue( name == "True" ) ) );
+			}
+			else if( name == "parent" )
+			{
+				return TermPtr( new PlugTerm( plugIndex( m_inputs ) ) );
+			}
+			else if( name == "context" )
+			{
+				return parseContext();
+			}
+			else if( name == "math" && m_mathImported )
+			{
+				expectOperator( "." );
+				const Token &attribute = next();
+				if( attribute.type != Token::Name )
+				{
+					unsupported();
+				}
+				if( attribute.text == "pi" )
+				{
+					return TermPtr( new LiteralTerm( floatValue( M_PI ) ) );
+				}
+				else if( attribute.text == "e" )
+				{
+					return TermPtr( new LiteralTerm( floatValue( M_E ) ) );
+				}
+				auto it = mathFunctions().find( attribute.text );
+				if( it == mathFunctions().end() )
+				{
+					unsupported();
+				}
+				return parseCall( it->second );
+			}
+
+			auto functionIt = builtinFunctions().find( name );
+			if( functionIt != builtinFunctions().end() )
+			{
+				return parseCall( functionIt->second );
+			}
+
+			auto variableIt = m_variables.find( name );
+			if( variableIt == m_variables.end() )
+			{
+				unsupported();
+			}
+			return TermPtr( new VariableTerm( variableIt->second ) );
+		}
+
+		TermPtr parseContext()
+		{
+			if( acceptOperator( "[" ) )
+			{
+				const std::string name = expectString();
+				expectOperator( "]" );
+				return TermPtr( new ContextVariableTerm( name, /* get = */ false, nullptr ) );
+			}
+
+			expectOperator( "." );
+			const Token &method = next();
+			if( method.text == "get" )
+			{
+				expectOperator( "(" );
+				const std::string name = expectString();
+				TermPtr defaultValue;
+				if( acceptOperator( "," ) && !check( Token::Operator, ")" ) )
+				{
+					defaultValue = parseTest();
+					acceptOperator( "," );
+				}
+				expectOperator( ")" );
+				return TermPtr( new ContextVariableTerm( name, /* get = */ true, std::move( defaultValue ) ) );
+			}
+
+			ContextMethodTerm::Method m;
+			if( method.text == "getFrame" )
+			{
+				m = ContextMethodTerm::GetFrame;
+			}
+			else if( method.text == "getTime" )
+			{
+				m = ContextMethodTerm::GetTime;
+			}
+			else if( method.text == "getFramesPerSecond" )
+			{
+				m = ContextMethodTerm::GetFramesPerSecond;
+			}
+			else
+			{
+				unsupported();
+			}
+
+			expectOperator( "(" );
+			expectOperator( ")" );
+			return TermPtr( new ContextMethodTerm( m ) );
+		}
+
+		const Expression *m_node;
+		const std::vector<ValuePlug *> &m_inputs;
+		const std::vector<ValuePlug *> &m_outputs;
+
+		const std::vector<Token> m_tokens;
+		size_t m_position;
+
+		std::unordered_map<std::string, size_t> m_variables;
+		bool m_mathImported;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// NativeExpressionEngine
+//////////////////////////////////////////////////////////////////////////
+
+class NativeExpressionEngine : public Expression::Engine
+{
+
+	public :
+
+		NativeExpressionEngine( const Expression *node, const std::string &expression, const std::vector<ValuePlug *> &inputs, const std::vector<ValuePlug *> &outputs )
+			:	m_numOutputs( outputs.size() )
+		{
+			for( const auto &p : outputs )
+			{
+				if( !supportedPlugType( p ) )
+				{
+					unsupported();
+				}
+			}
+
+			Parser parser( node, expression, inputs, outputs );
+			m_assignments = std::move( parser.assignments );
+			m_numVariables = parser.numVariables();
+		}
+
+	protected :
+
+		void parse( Expression *node, const std::string &expression, std::vector<ValuePlug *> &inputs, std::vector<ValuePlug *> &outputs, std::vector<IECore::InternedString> &contextVariables ) override
+		{
+			throw IECore::Exception( "NativeExpressionEngine must be created via createNativeExpressionEngine()" );
+		}
+
+		IECore::ConstObjectVectorPtr execute( const Context *context, const std::vector<const ValuePlug *> &proxyInputs ) const override
+		{
+			try
+			{
+				Frame frame( context, proxyInputs, m_numVariables );
+				ObjectVectorPtr result = new ObjectVector;
+				result->members().resize( m_numOutputs, NullObject::defaultNullObject() );
+				for( const auto &assignment : m_assignments )
+				{
+					Value value = assignment.value->evaluate( frame );
+					if( assignment.isOutput )
+					{
+						result->members()[assignment.index] = valueToData( value );
+					}
+					else
+					{
+						frame.variables[assignment.index] = std::move( value );
+					}
+				}
+				return result;
+			}
+			catch( const Unsupported & )
+			{
+				return nullptr;
+			}
+		}
+
+		// Mirrors the conversions made by the Python engine, so that
+		// we can also apply the values it computes when `execute()`
+		// defers to it.
+		void apply( ValuePlug *proxyOutput, const ValuePlug *topLevelProxyOutput, const IECore::Object *value ) const override
+		{
+			if( runTimeCast<const NullObject>( value ) )
+			{
+				proxyOutput->setToDefault();
+				return;
+			}
+
+			try
+			{
+				const Value v = dataToValue( value );
+				switch( static_cast<Gaffer::TypeId>( proxyOutput->typeId() ) )
+				{
+					case BoolPlugTypeId :
+						// Python's `BoolPlug.setValue()` only accepts
+						// bools and ints.
+						if( v.isIntegral() )
+						{
+							static_cast<BoolPlug *>( proxyOutput )->setValue( truth( v ) );
+							return;
+						}
+						break;
+					case IntPlugTypeId : {
+						const int64_t i = toInt( v );
+						if( i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max() )
+						{
+							static_cast<IntPlug *>( proxyOutput )->setValue( i );
+							return;
+						}
+						break;
+					}
+					case FloatPlugTypeId :
+						if( !v.isString() )
+						{
+							static_cast<FloatPlug *>( proxyOutput )->setValue( v.asDouble() );
+							return;
+						}
+						break;
+					case StringPlugTypeId :
+						if( v.isString() )
+						{
+							static_cast<StringPlug *>( proxyOutput )->setValue( v.s );
+							return;
+						}
+						break;
+					default :
+						break;
+				}
+			}
+			catch( const Unsupported & )
+			{
+			}
+
+			throw IECore::Exception( boost::str(
+				boost::format( "Unsupported value type \"%s\" for plug \"%s\"" ) % value->typeName() % proxyOutput->fullName()
+			) );
+		}
+
+		// Language utilities are provided by the Python engine.
+
+		std::string identifier( const Expression *node, const ValuePlug *plug ) const override
+		{
+			return "";
+		}
+
+		std::string replace( const Expression *node, const std::string &expression, const std::vector<const ValuePlug *> &oldPlugs, const std::vector<const ValuePlug *> &newPlugs ) const override
+		{
+			return expression;
+		}
+
+		std::string defaultExpression( const ValuePlug *output ) const override
+		{
+			return "";
+		}
+
+	private :
+
+		std::vector<Assignment> m_assignments;
+		size_t m_numVariables;
+		size_t m_numOutputs;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Public API
+//////////////////////////////////////////////////////////////////////////
+
+Expression::EnginePtr Gaffer::Private::createNativeExpressionEngine( const Expression *node, const std::string &expression, const std::vector<ValuePlug *> &inputs, const std::vector<ValuePlug *> &outputs )
+{
+	try
+	{
+		return new NativeExpressionEngine( node, expression, inputs, outputs );
+	}
+	catch( const Unsupported & )
+	{
+		return nullptr;
+	}
+}
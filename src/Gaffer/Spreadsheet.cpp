@@ -36,10 +36,17 @@
 
 #include "Gaffer/Spreadsheet.h"
 
+#include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/ThreadState.h"
 
+#include "IECore/StringAlgo.h"
+
+#include "boost/bind.hpp"
 #include "boost/container/small_vector.hpp"
 
+#include <algorithm>
+
 using namespace std;
 using namespace IECore;
 using namespace Gaffer;
@@ -66,6 +73,63 @@ void appendLeafPlugs( const Gaffer::Plug *p, DependencyNode::AffectedPlugsContai
 	}
 }
 
+// The rows map separates the (space separated) patterns from the row
+// names into exact names, which are stored sorted for binary search, and
+// wildcard patterns, which are stored in row order and must be matched
+// individually. Each is paired with the index of the row it came from.
+const InternedString g_exactNamesName( "exactNames" );
+const InternedString g_exactIndicesName( "exactIndices" );
+const InternedString g_patternsName( "patterns" );
+const InternedString g_patternIndicesName( "patternIndices" );
+
+// Context used to evaluate the rows map when the rows have
+// the same value in every context.
+const Context *rowsMapContext()
+{
+	static ConstContextPtr g_context = new Context;
+	return g_context.get();
+}
+
+// Returns true if `plug` has the same value in all contexts,
+// because it has no input and no means of computing a value.
+bool isStatic( const Plug *plug )
+{
+	const Plug *source = plug->source();
+	return source->direction() == Plug::In || !runTimeCast<const ComputeNode>( source->node() );
+}
+
+int rowIndexFromMap( const CompoundObject *rowsMap, const std::string &selector )
+{
+	const auto &exactNames = rowsMap->member<StringVectorData>( g_exactNamesName )->readable();
+	const auto &exactIndices = rowsMap->member<IntVectorData>( g_exactIndicesName )->readable();
+	const auto &patterns = rowsMap->member<StringVectorData>( g_patternsName )->readable();
+	const auto &patternIndices = rowsMap->member<IntVectorData>( g_patternIndicesName )->readable();
+
+	int result = 0;
+	auto it = std::lower_bound( exactNames.begin(), exactNames.end(), selector );
+	if( it != exactNames.end() && *it == selector )
+	{
+		result = exactIndices[it - exactNames.begin()];
+	}
+
+	// A pattern only takes precedence if it belongs
+	// to an earlier row than the exact match.
+	for( size_t i = 0, e = patterns.size(); i < e; ++i )
+	{
+		if( result && patternIndices[i] >= result )
+		{
+			break;
+		}
+		if( StringAlgo::match( selector, patterns[i] ) )
+		{
+			result = patternIndices[i];
+			break;
+		}
+	}
+
+	return result;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -317,7 +381,7 @@ size_t Spreadsheet::g_firstPlugIndex = 0;
 GAFFER_GRAPHCOMPONENT_DEFINE_TYPE( Spreadsheet );
 
 Spreadsheet::Spreadsheet( const std::string &name )
-	:	ComputeNode( name )
+	:	ComputeNode( name ), m_rowsContextDependency( RowsContextDependency::Unknown )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 
@@ -327,6 +391,9 @@ Spreadsheet::Spreadsheet( const std::string &name )
 	addChild( new ValuePlug( "out", Plug::Out ) );
 	addChild( new StringVectorDataPlug( "activeRowNames", Plug::Out, new IECore::StringVectorData ) );
 	addChild( new IntPlug( "__rowIndex", Plug::Out ) );
+	addChild( new CompoundObjectPlug( "__rowsMap", Plug::Out, new CompoundObject ) );
+
+	plugDirtiedSignal().connect( boost::bind( &Spreadsheet::plugDirtied, this, ::_1 ) );
 }
 
 Spreadsheet::~Spreadsheet()
@@ -393,6 +460,16 @@ const IntPlug *Spreadsheet::rowIndexPlug() const
 	return getChild<IntPlug>( g_firstPlugIndex + 5 );
 }
 
+CompoundObjectPlug *Spreadsheet::rowsMapPlug()
+{
+	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 6 );
+}
+
+const CompoundObjectPlug *Spreadsheet::rowsMapPlug() const
+{
+	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 6 );
+}
+
 void Spreadsheet::affects( const Plug *input, DependencyNode::AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -401,11 +478,18 @@ void Spreadsheet::affects( const Plug *input, DependencyNode::AffectedPlugsConta
 	if(
 		input == enabledPlug() ||
 		input == selectorPlug() ||
+		input == rowsMapPlug()
+	)
+	{
+		outputs.push_back( rowIndexPlug() );
+	}
+
+	if(
 		( row && input == row->namePlug() ) ||
 		( row && input == row->enabledPlug() )
 	)
 	{
-		outputs.push_back( rowIndexPlug() );
+		outputs.push_back( rowsMapPlug() );
 	}
 
 	if( input == rowIndexPlug() )
@@ -463,8 +547,16 @@ void Spreadsheet::hash( const ValuePlug *output, const Context *context, IECore:
 	if( output == rowIndexPlug() )
 	{
 		ComputeNode::hash( output, context, h );
-		enabledPlug()->hash( h );
-		selectorPlug()->hash( h );
+		if( enabledPlug()->getValue() )
+		{
+			selectorPlug()->hash( h );
+			h.append( rowsMapHash() );
+		}
+		return;
+	}
+	else if( output == rowsMapPlug() )
+	{
+		ComputeNode::hash( output, context, h );
 		for( int i = 1, e = rowsPlug()->children().size(); i < e; ++i )
 		{
 			const auto *row = rowsPlug()->getChild<RowPlug>( i );
@@ -500,22 +592,74 @@ void Spreadsheet::compute( ValuePlug *output, const Context *context ) const
 		int result = 0;
 		if( enabledPlug()->getValue() )
 		{
-			const std::string selector = selectorPlug()->getValue();
-			for( int i = 1, e = rowsPlug()->children().size(); i < e; ++i )
+			result = rowIndexFromMap( rowsMap().get(), selectorPlug()->getValue() );
+		}
+		static_cast<IntPlug *>( output )->setValue( result );
+		return;
+	}
+	else if( output == rowsMapPlug() )
+	{
+		vector<pair<string, int>> exact;
+		StringVectorDataPtr patternsData = new StringVectorData;
+		IntVectorDataPtr patternIndicesData = new IntVectorData;
+
+		vector<string> tokens;
+		for( int i = 1, e = rowsPlug()->children().size(); i < e; ++i )
+		{
+			const auto *row = rowsPlug()->getChild<RowPlug>( i );
+			if( !row->enabledPlug()->getValue() )
+			{
+				continue;
+			}
+
+			// Split in the same way as `StringAlgo::matchMultiple()`.
+			tokens.clear();
+			StringAlgo::tokenize( row->namePlug()->getValue(), ' ', tokens );
+			for( const auto &token : tokens )
 			{
-				const auto *row = rowsPlug()->getChild<RowPlug>( i );
-				if( !row->enabledPlug()->getValue() )
+				if( token.empty() )
 				{
 					continue;
 				}
-				if( StringAlgo::matchMultiple( selector, row->namePlug()->getValue() ) )
+				if( StringAlgo::hasWildcards( token ) )
+				{
+					patternsData->writable().push_back( token );
+					patternIndicesData->writable().push_back( i );
+				}
+				else
 				{
-					result = i;
-					break;
+					exact.push_back( { token, i } );
 				}
 			}
 		}
-		static_cast<IntPlug *>( output )->setValue( result );
+
+		// Sort by name then row, keeping only the first row
+		// for each name.
+		std::sort( exact.begin(), exact.end() );
+		exact.erase(
+			std::unique(
+				exact.begin(), exact.end(),
+				[]( const pair<string, int> &a, const pair<string, int> &b ) { return a.first == b.first; }
+			),
+			exact.end()
+		);
+
+		StringVectorDataPtr exactNamesData = new StringVectorData;
+		IntVectorDataPtr exactIndicesData = new IntVectorData;
+		exactNamesData->writable().reserve( exact.size() );
+		exactIndicesData->writable().reserve( exact.size() );
+		for( auto &e : exact )
+		{
+			exactNamesData->writable().push_back( std::move( e.first ) );
+			exactIndicesData->writable().push_back( e.second );
+		}
+
+		CompoundObjectPtr result = new CompoundObject;
+		result->members()[g_exactNamesName] = exactNamesData;
+		result->members()[g_exactIndicesName] = exactIndicesData;
+		result->members()[g_patternsName] = patternsData;
+		result->members()[g_patternIndicesName] = patternIndicesData;
+		static_cast<CompoundObjectPlug *>( output )->setValue( result );
 		return;
 	}
 	else if( outPlug()->isAncestorOf( output ) )
@@ -544,6 +688,70 @@ void Spreadsheet::compute( ValuePlug *output, const Context *context ) const
 	ComputeNode::compute( output, context );
 }
 
+IECore::MurmurHash Spreadsheet::rowsMapHash() const
+{
+	if( rowsAreContextIndependent() )
+	{
+		Context::Scope scope( rowsMapContext() );
+		return rowsMapPlug()->hash();
+	}
+	return rowsMapPlug()->hash();
+}
+
+IECore::ConstCompoundObjectPtr Spreadsheet::rowsMap() const
+{
+	if( rowsAreContextIndependent() )
+	{
+		Context::Scope scope( rowsMapContext() );
+		return rowsMapPlug()->getValue();
+	}
+	return rowsMapPlug()->getValue();
+}
+
+bool Spreadsheet::rowsAreContextIndependent() const
+{
+	RowsContextDependency dependency = m_rowsContextDependency;
+	if( dependency != RowsContextDependency::Unknown )
+	{
+		return dependency == RowsContextDependency::Independent;
+	}
+
+	// Remove the current Process, so that `StringPlug::getValue()`
+	// returns the names without substitutions, and we can check
+	// if they need them.
+	const ThreadState defaultThreadState;
+	ThreadState::Scope defaultThreadStateScope( defaultThreadState );
+
+	dependency = RowsContextDependency::Independent;
+	for( int i = 1, e = rowsPlug()->children().size(); i < e; ++i )
+	{
+		const auto *row = rowsPlug()->getChild<RowPlug>( i );
+		if(
+			!isStatic( row->enabledPlug() ) ||
+			!isStatic( row->namePlug() ) ||
+			Context::hasSubstitutions( row->namePlug()->getValue() )
+		)
+		{
+			dependency = RowsContextDependency::Dependent;
+			break;
+		}
+	}
+
+	m_rowsContextDependency = dependency;
+	return dependency == RowsContextDependency::Independent;
+}
+
+void Spreadsheet::plugDirtied( const Plug *plug )
+{
+	// The rows map is dirtied by any change to the row names and
+	// enabled states, including their input connections, and by
+	// the addition and removal of rows.
+	if( plug == rowsMapPlug() )
+	{
+		m_rowsContextDependency = RowsContextDependency::Unknown;
+	}
+}
+
 const ValuePlug *Spreadsheet::correspondingInput( const Plug *plug, size_t rowIndex ) const
 {
 	const ValuePlug *out = outPlug();
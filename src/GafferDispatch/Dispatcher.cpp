@@ -50,6 +50,8 @@
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/filesystem.hpp"
 
+#include <fstream>
+
 using namespace std;
 using namespace IECore;
 using namespace Gaffer;
@@ -58,6 +60,7 @@ using namespace GafferDispatch;
 static InternedString g_frame( "frame" );
 static InternedString g_batchSize( "batchSize" );
 static InternedString g_immediatePlugName( "immediate" );
+static InternedString g_outputFilesPlugName( "outputFiles" );
 static InternedString g_postTaskIndexBlindDataName( "dispatcher:postTaskIndex" );
 static InternedString g_immediateBlindDataName( "dispatcher:immediate" );
 static InternedString g_sizeBlindDataName( "dispatcher:size" );
@@ -65,6 +68,7 @@ static InternedString g_executedBlindDataName( "dispatcher:executed" );
 static InternedString g_visitedBlindDataName( "dispatcher:visited" );
 static InternedString g_jobDirectoryContextEntry( "dispatcher:jobDirectory" );
 static InternedString g_scriptFileNameContextEntry( "dispatcher:scriptFileName" );
+static InternedString g_manifestDirectoryContextEntry( "dispatcher:manifestDirectory" );
 static IECore::BoolDataPtr g_trueBoolData = new BoolData( true );
 
 size_t Dispatcher::g_firstPlugIndex = 0;
@@ -84,6 +88,7 @@ Dispatcher::Dispatcher( const std::string &name )
 	addChild( new StringPlug( "frameRange", Plug::In, "1-100x10" ) );
 	addChild( new StringPlug( "jobName", Plug::In, "" ) );
 	addChild( new StringPlug( "jobsDirectory", Plug::In, "" ) );
+	addChild( new BoolPlug( "skipUpToDateTasks", Plug::In, false ) );
 }
 
 Dispatcher::~Dispatcher()
@@ -130,6 +135,16 @@ const StringPlug *Dispatcher::jobsDirectoryPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 3 );
 }
 
+BoolPlug *Dispatcher::skipUpToDateTasksPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
+const BoolPlug *Dispatcher::skipUpToDateTasksPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
 const std::string Dispatcher::jobDirectory() const
 {
 	return m_jobDirectory;
@@ -174,12 +189,19 @@ void Dispatcher::createJobDirectory( const Gaffer::ScriptNode *script, Gaffer::C
 	// we use a unique numeric subdirectory per job. Start by finding
 	// the highest existing numbered directory entry. Doing this with
 	// a directory iterator is much quicker than calling `is_directory()`
-	// in a loop.
+	// in a loop. Non-numeric entries such as the manifest directory
+	// are ignored.
 
 	long i = -1;
 	for( const auto &d : boost::filesystem::directory_iterator( jobDirectory ) )
 	{
-		i = std::max( i, strtol( d.path().filename().c_str(), nullptr, 10 ) );
+		const std::string fileName = d.path().filename().string();
+		char *end;
+		const long n = strtol( fileName.c_str(), &end, 10 );
+		if( end != fileName.c_str() )
+		{
+			i = std::max( i, n );
+		}
 	}
 
 	// Now create the next directory. We do this in a loop until we
@@ -251,6 +273,7 @@ void Dispatcher::setupPlugs( Plug *parentPlug )
 	}
 
 	parentPlug->addChild( new BoolPlug( g_immediatePlugName, Plug::In, false ) );
+	parentPlug->addChild( new StringPlug( g_outputFilesPlugName, Plug::In, "" ) );
 
 	const CreatorMap &m = creators();
 	for ( CreatorMap::const_iterator it = m.begin(); it != m.end(); ++it )
@@ -366,6 +389,141 @@ const CompoundData *Dispatcher::TaskBatch::blindData() const
 	return m_blindData.get();
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Manifest. This is a directory containing a record file for each task
+// executed by an incremental dispatch. Records are named by the task hash,
+// and list the modification times of the task's output files.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+typedef std::vector<std::pair<std::string, std::time_t>> OutputFiles;
+
+// Returns the path to the record for the task in the current
+// context, or an empty path if the task is a no-op.
+boost::filesystem::path manifestRecordPath( const TaskNode::TaskPlug *plug, const std::string &manifestDirectory )
+{
+	IECore::MurmurHash h = plug->hash();
+	if( h == IECore::MurmurHash() )
+	{
+		return boost::filesystem::path();
+	}
+
+	// Prevent identical tasks from different nodes from
+	// sharing a record.
+	h.append( plug->relativeName( plug->ancestor<ScriptNode>() ) );
+	return boost::filesystem::path( manifestDirectory ) / h.toString();
+}
+
+// Fills `files` with the output files declared for the task in the current
+// context, along with their modification times. Returns false if any of
+// the files doesn't exist.
+bool outputFiles( const TaskNode::TaskPlug *plug, OutputFiles &files )
+{
+	const TaskNode *node = runTimeCast<const TaskNode>( plug->node() );
+	const StringPlug *outputFilesPlug = node ? node->dispatcherPlug()->getChild<StringPlug>( g_outputFilesPlugName ) : nullptr;
+	if( !outputFilesPlug )
+	{
+		return true;
+	}
+
+	vector<string> fileNames;
+	StringAlgo::tokenize<string>( outputFilesPlug->getValue(), ' ', back_inserter( fileNames ) );
+	for( const auto &fileName : fileNames )
+	{
+		if( fileName.empty() )
+		{
+			continue;
+		}
+
+		boost::system::error_code error;
+		const std::time_t time = boost::filesystem::last_write_time( fileName, error );
+		if( error )
+		{
+			return false;
+		}
+		files.push_back( OutputFiles::value_type( fileName, time ) );
+	}
+
+	return true;
+}
+
+bool taskIsUpToDate( const TaskNode::TaskPlug *plug, const std::string &manifestDirectory )
+{
+	const boost::filesystem::path recordPath = manifestRecordPath( plug, manifestDirectory );
+	if( recordPath.empty() )
+	{
+		// No-ops are always up to date.
+		return true;
+	}
+
+	std::ifstream record( recordPath.string() );
+	if( !record.is_open() )
+	{
+		return false;
+	}
+
+	OutputFiles recordedFiles;
+	std::time_t time;
+	std::string fileName;
+	while( record >> time >> fileName )
+	{
+		recordedFiles.push_back( OutputFiles::value_type( fileName, time ) );
+	}
+
+	OutputFiles files;
+	if( !outputFiles( plug, files ) )
+	{
+		return false;
+	}
+
+	return files == recordedFiles;
+}
+
+} // namespace
+
+void Dispatcher::recordExecutedTask( const TaskNode::TaskPlug *plug )
+{
+	const string manifestDirectory = Context::current()->get<string>( g_manifestDirectoryContextEntry, "" );
+	if( manifestDirectory.empty() )
+	{
+		return;
+	}
+
+	const boost::filesystem::path recordPath = manifestRecordPath( plug, manifestDirectory );
+	if( recordPath.empty() )
+	{
+		return;
+	}
+
+	OutputFiles files;
+	if( !outputFiles( plug, files ) )
+	{
+		// The task didn't produce the outputs it declared, so
+		// we don't record it, and it will be executed again by
+		// the next dispatch.
+		return;
+	}
+
+	// Write to a temporary file and then rename it, so that concurrently
+	// executing tasks and dispatches never see a partial record.
+	boost::filesystem::create_directories( manifestDirectory );
+	const boost::filesystem::path tempPath = boost::filesystem::unique_path( recordPath.string() + ".%%%%-%%%%-%%%%" );
+	{
+		std::ofstream record( tempPath.string() );
+		for( const auto &file : files )
+		{
+			record << file.second << " " << file.first << "\n";
+		}
+		if( !record )
+		{
+			throw IECore::IOException( "Unable to write manifest record \"" + tempPath.string() + "\"" );
+		}
+	}
+	boost::filesystem::rename( tempPath, recordPath );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Batcher class. This is an internal utility class for constructing
 // the DAG of TaskBatches to be dispatched. It is a separate class so
@@ -377,8 +535,10 @@ class Dispatcher::Batcher
 
 	public :
 
-		Batcher()
-			:	m_rootBatch( new TaskBatch() )
+		// If `manifestDirectory` is non-empty, tasks which are up to
+		// date with respect to the manifest are omitted from the batches.
+		Batcher( const std::string &manifestDirectory = "" )
+			:	m_rootBatch( new TaskBatch() ), m_manifestDirectory( manifestDirectory )
 		{
 		}
 
@@ -397,7 +557,9 @@ class Dispatcher::Batcher
 
 	private :
 
-		TaskBatchPtr batchTasksWalk( TaskNode::Task task, const std::set<const TaskBatch *> &ancestors = std::set<const TaskBatch *>() )
+		// If `upToDate` is passed, it is filled with the result of the
+		// incremental dispatch check for the task.
+		TaskBatchPtr batchTasksWalk( TaskNode::Task task, const std::set<const TaskBatch *> &ancestors = std::set<const TaskBatch *>(), bool *upToDate = nullptr )
 		{
 			task = TaskNode::Task( task.plug()->source<TaskNode::TaskPlug>(), task.context() );
 			// Deal with Switch and ContextProcessor nodes. We need to do this manually
@@ -421,13 +583,18 @@ class Dispatcher::Batcher
 
 			if( task.plug()->direction() != Plug::Out )
 			{
+				if( upToDate )
+				{
+					*upToDate = true;
+				}
 				return nullptr;
 			}
 
 			// Acquire a batch with this task placed in it,
 			// and check that we haven't discovered a cyclic
 			// dependency.
-			TaskBatchPtr batch = acquireBatch( task );
+			TaskInfo &taskInfo = acquireBatch( task );
+			TaskBatchPtr batch = taskInfo.batch;
 			if( ancestors.find( batch.get() ) != ancestors.end() )
 			{
 				throw IECore::Exception( ( boost::format( "Dispatched tasks cannot have cyclic dependencies but %s is involved in a cycle." ) % batch->plug()->relativeName( batch->plug()->ancestor<ScriptNode>() ) ).str() );
@@ -465,12 +632,38 @@ class Dispatcher::Batcher
 				preTaskAncestors.insert( it->get() );
 			}
 
+			bool preTasksUpToDate = true;
 			for( TaskNode::Tasks::const_iterator it = preTasks.begin(); it != preTasks.end(); ++it )
 			{
-				if( auto preBatch = batchTasksWalk( *it, preTaskAncestors ) )
+				bool preTaskUpToDate = false;
+				if( auto preBatch = batchTasksWalk( *it, preTaskAncestors, &preTaskUpToDate ) )
 				{
 					addPreTask( batch.get(), preBatch );
 				}
+				preTasksUpToDate = preTasksUpToDate && preTaskUpToDate;
+			}
+
+			// Now we know the state of our preTasks, we can decide whether
+			// or not an incremental dispatch needs to execute the task. Any
+			// task downstream of an executed task must also be executed,
+			// because its inputs may have changed.
+			if( taskInfo.pending )
+			{
+				taskInfo.pending = false;
+				if( preTasksUpToDate )
+				{
+					Context::Scope scopedTaskContext( task.context() );
+					taskInfo.upToDate = taskInfo.noOp || taskIsUpToDate( task.plug(), m_manifestDirectory );
+				}
+				if( !taskInfo.upToDate && !taskInfo.noOp )
+				{
+					addFrame( batch.get(), task );
+				}
+			}
+
+			if( upToDate )
+			{
+				*upToDate = taskInfo.upToDate;
 			}
 
 			// As far as TaskBatch and doDispatch() are concerned, there
@@ -487,7 +680,19 @@ class Dispatcher::Batcher
 			return batch;
 		}
 
-		TaskBatchPtr acquireBatch( const TaskNode::Task &task )
+		// Per-task state, shared by all visits to the same task.
+		struct TaskInfo
+		{
+			TaskBatchPtr batch;
+			bool noOp;
+			// True while the incremental dispatch check has yet
+			// to be made for the task. The task's frame is only
+			// added to the batch once the check has been made.
+			bool pending;
+			bool upToDate;
+		};
+
+		TaskInfo &acquireBatch( const TaskNode::Task &task )
 		{
 			// See if we've previously visited this task, and therefore
 			// have placed it in a batch already, which we can return
@@ -509,7 +714,7 @@ class Dispatcher::Batcher
 			// coalesced.
 			taskHash.append( (uint64_t)task.plug() );
 
-			const TaskToBatchMap::const_iterator it = m_tasksToBatches.find( taskHash );
+			TaskToBatchMap::iterator it = m_tasksToBatches.find( taskHash );
 			if( it != m_tasksToBatches.end() )
 			{
 				return it->second;
@@ -549,19 +754,13 @@ class Dispatcher::Batcher
 
 			// Now we have an appropriate batch, update it to include
 			// the frame for our task, and any other relevant information.
+			// For incremental dispatches, the frame is added later by
+			// `batchTasksWalk()`, if the task needs executing.
 
-			if( !taskIsNoOp )
+			TaskInfo taskInfo = { batch, taskIsNoOp, /* pending = */ !m_manifestDirectory.empty(), /* upToDate = */ false };
+			if( !taskInfo.pending && !taskIsNoOp )
 			{
-				float frame = task.context()->getFrame();
-				std::vector<float> &frames = batch->frames();
-				if( requiresSequenceExecution )
-				{
-					frames.insert( std::lower_bound( frames.begin(), frames.end(), frame ), frame );
-				}
-				else
-				{
-					frames.push_back( frame );
-				}
+				addFrame( batch.get(), task );
 			}
 
 			const BoolPlug *immediatePlug = dispatcherPlug( task )->getChild<const BoolPlug>( g_immediatePlugName );
@@ -576,9 +775,21 @@ class Dispatcher::Batcher
 
 			// Remember which batch we stored this task in, for
 			// the next time someone asks for it.
-			m_tasksToBatches[taskHash] = batch;
+			return m_tasksToBatches[taskHash] = taskInfo;
+		}
 
-			return batch;
+		void addFrame( TaskBatch *batch, const TaskNode::Task &task )
+		{
+			float frame = task.context()->getFrame();
+			std::vector<float> &frames = batch->frames();
+			if( task.plug()->requiresSequenceExecution() )
+			{
+				frames.insert( std::lower_bound( frames.begin(), frames.end(), frame ), frame );
+			}
+			else
+			{
+				frames.push_back( frame );
+			}
 		}
 
 		// Hash used to determine how to coalesce tasks into batches.
@@ -655,9 +866,10 @@ class Dispatcher::Batcher
 		}
 
 		typedef std::map<IECore::MurmurHash, TaskBatchPtr> BatchMap;
-		typedef std::map<IECore::MurmurHash, TaskBatchPtr> TaskToBatchMap;
+		typedef std::map<IECore::MurmurHash, TaskInfo> TaskToBatchMap;
 
 		TaskBatchPtr m_rootBatch;
+		const std::string m_manifestDirectory;
 		BatchMap m_currentBatches;
 		TaskToBatchMap m_tasksToBatches;
 
@@ -760,6 +972,15 @@ void Dispatcher::dispatch( const std::vector<NodePtr> &nodes ) const
 	Context::Scope jobScope( jobContext.get() );
 	createJobDirectory( script, jobContext.get() );
 
+	// Advertise the manifest location via the context, so that tasks
+	// can record themselves when they are executed.
+	std::string manifestDirectory;
+	if( skipUpToDateTasksPlug()->getValue() )
+	{
+		manifestDirectory = ( boost::filesystem::path( m_jobDirectory ).parent_path() / "manifest" ).string();
+		jobContext->set( g_manifestDirectoryContextEntry, manifestDirectory );
+	}
+
 	// this object calls this->preDispatchSignal() in its constructor and this->postDispatchSignal()
 	// in its destructor, thereby guaranteeing that we always call this->postDispatchSignal().
 
@@ -775,7 +996,7 @@ void Dispatcher::dispatch( const std::vector<NodePtr> &nodes ) const
 	FrameListPtr frameList = frameRange( script, Context::current() );
 	frameList->asList( frames );
 
-	Batcher batcher;
+	Batcher batcher( manifestDirectory );
 	for( std::vector<FrameList::Frame>::const_iterator fIt = frames.begin(); fIt != frames.end(); ++fIt )
 	{
 		for( std::vector<TaskNodePtr>::const_iterator nIt = taskNodes.begin(); nIt != taskNodes.end(); ++nIt )
@@ -45,6 +45,8 @@
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/SubGraph.h"
 
+#include "tbb/pipeline.h"
+
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferDispatch;
@@ -210,6 +212,7 @@ void TaskNode::TaskPlug::execute() const
 	try
 	{
 		p.taskNode()->execute();
+		Dispatcher::recordExecutedTask( this );
 	}
 	catch( ... )
 	{
@@ -224,6 +227,12 @@ void TaskNode::TaskPlug::executeSequence( const std::vector<float> &frames ) con
 	try
 	{
 		p.taskNode()->executeSequence( frames );
+		Context::EditableScope frameScope( p.context() );
+		for( auto frame : frames )
+		{
+			frameScope.setFrame( frame );
+			Dispatcher::recordExecutedTask( this );
+		}
 	}
 	catch( ... )
 	{
@@ -406,3 +415,49 @@ bool TaskNode::requiresSequenceExecution() const
 {
 	return false;
 }
+
+void TaskNode::executeSequenceInParallel( const std::vector<float> &frames, size_t maxFramesInFlight ) const
+{
+	if( maxFramesInFlight <= 1 || frames.size() <= 1 )
+	{
+		TaskNode::executeSequence( frames );
+		return;
+	}
+
+	const ThreadState &threadState = ThreadState::current();
+	size_t nextFrame = 0;
+
+	// We use a pipeline rather than a `parallel_for()` so that we can limit
+	// the number of frames in flight without limiting the threads available
+	// to the computes within each frame.
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_pipeline(
+
+		maxFramesInFlight,
+
+		tbb::make_filter<void, float>(
+			tbb::filter::serial_in_order,
+			[&frames, &nextFrame] ( tbb::flow_control &flowControl ) -> float {
+				if( nextFrame >= frames.size() )
+				{
+					flowControl.stop();
+					return 0.0f;
+				}
+				return frames[nextFrame++];
+			}
+		) &
+
+		tbb::make_filter<float, void>(
+			tbb::filter::parallel,
+			[this, &threadState] ( float frame ) {
+				Context::EditableScope frameScope( threadState );
+				frameScope.setFrame( frame );
+				execute();
+			}
+		),
+
+		// Prevents outer tasks silently cancelling our tasks
+		taskGroupContext
+
+	);
+}
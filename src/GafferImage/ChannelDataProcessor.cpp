@@ -44,6 +44,63 @@
 using namespace Gaffer;
 using namespace GafferImage;
 
+namespace
+{
+
+void unpremultiply( IECore::FloatVectorData *data, const IECore::FloatVectorData *alphaData )
+{
+	int size = alphaData->readable().size();
+	const float *A = &alphaData->readable().front();
+	float *O = &data->writable().front();
+	for( int j = 0; j < size; j++ )
+	{
+		if( *A != 0 )
+		{
+			*O /= *A;
+		}
+		A++;
+		O++;
+	}
+}
+
+// If `preAlphaData` is provided, then pixels are left untouched only if both
+// the alpha before and after processing are zero.
+void repremultiply( IECore::FloatVectorData *data, const IECore::FloatVectorData *alphaData, const IECore::FloatVectorData *preAlphaData )
+{
+	int size = alphaData->readable().size();
+	const float *A = &alphaData->readable().front();
+	float *O = &data->writable().front();
+
+	if( preAlphaData )
+	{
+		const float *preA = &preAlphaData->readable().front();
+		for( int j = 0; j < size; j++ )
+		{
+			if( ! ( *A == 0 && *preA == 0 ) )
+			{
+				*O *= *A;
+			}
+			A++;
+			O++;
+			preA++;
+		}
+	}
+	else
+	{
+		for( int j = 0; j < size; j++ )
+		{
+			if( *A != 0 )
+			{
+				*O *= *A;
+			}
+			A++;
+			O++;
+		}
+	}
+}
+
+} // namespace
+
 GAFFER_GRAPHCOMPONENT_DEFINE_TYPE( ChannelDataProcessor );
 
 size_t ChannelDataProcessor::g_firstPlugIndex = 0;
@@ -129,6 +186,11 @@ bool ChannelDataProcessor::channelEnabled( const std::string &channel ) const
 	return IECore::StringAlgo::matchMultiple( channel, channelsPlug()->getValue() );
 }
 
+bool ChannelDataProcessor::processesUniformTiles() const
+{
+	return false;
+}
+
 void ChannelDataProcessor::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	ImageProcessor::hashChannelData( output, context, h );
@@ -168,7 +230,7 @@ void ChannelDataProcessor::hashChannelData( const GafferImage::ImagePlug *output
 
 IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::FloatVectorDataPtr outData = inPlug()->channelData( channelName, tileOrigin )->copy();
+	IECore::ConstFloatVectorDataPtr inData = inPlug()->channelData( channelName, tileOrigin );
 
 	IECore::ConstStringVectorDataPtr channelNamesData;
 	bool unpremult = false;
@@ -199,55 +261,46 @@ IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeChannelData( const
 		{
 			postAlphaData = alphaData;
 		}
+	}
 
-		int size = alphaData->readable().size();
-		const float *A = &alphaData->readable().front();
-		float *O = &outData->writable().front();
-		for( int j = 0; j < size; j++ )
-		{
-			if( *A != 0 )
-			{
-				*O /= *A;
-			}
-			A++;
-			O++;
-		}
+	// If everything we depend on is a uniform tile, then we only need
+	// to process a single pixel, and can return a uniform tile ourselves.
 
-	}
-	processChannelData( context, parent, channelName, outData );
-	if( unpremult && postAlphaData )
+	float uniformValue, uniformAlpha, uniformPostAlpha;
+	if(
+		processesUniformTiles() &&
+		ImagePlug::uniformTileValue( inData.get(), uniformValue ) &&
+		( !alphaData || (
+			ImagePlug::uniformTileValue( alphaData.get(), uniformAlpha ) &&
+			ImagePlug::uniformTileValue( postAlphaData.get(), uniformPostAlpha )
+		) )
+	)
 	{
-		int size = postAlphaData->readable().size();
-		const float *A = &postAlphaData->readable().front();
-		float *O = &outData->writable().front();
-
-		if( repremultByProcessedAlpha )
+		IECore::FloatVectorDataPtr outData = new IECore::FloatVectorData( std::vector<float>( 1, uniformValue ) );
+		if( alphaData )
 		{
-			const float *preA = &alphaData->readable().front();
-			for( int j = 0; j < size; j++ )
-			{
-				if( ! ( *A == 0 && *preA == 0 ) )
-				{
-					*O *= *A;
-				}
-				A++;
-				O++;
-				preA++;
-			}
+			IECore::ConstFloatVectorDataPtr a = new IECore::FloatVectorData( std::vector<float>( 1, uniformAlpha ) );
+			IECore::ConstFloatVectorDataPtr postA = new IECore::FloatVectorData( std::vector<float>( 1, uniformPostAlpha ) );
+			unpremultiply( outData.get(), a.get() );
+			processChannelData( context, parent, channelName, outData );
+			repremultiply( outData.get(), postA.get(), repremultByProcessedAlpha ? a.get() : nullptr );
 		}
 		else
 		{
-			for( int j = 0; j < size; j++ )
-			{
-				if( *A != 0 )
-				{
-					*O *= *A;
-				}
-				A++;
-				O++;
-			}
+			processChannelData( context, parent, channelName, outData );
 		}
+		return ImagePlug::uniformTile( outData->readable()[0] );
+	}
 
+	IECore::FloatVectorDataPtr outData = inData->copy();
+	if( alphaData )
+	{
+		unpremultiply( outData.get(), alphaData.get() );
+	}
+	processChannelData( context, parent, channelName, outData );
+	if( postAlphaData )
+	{
+		repremultiply( outData.get(), postAlphaData.get(), repremultByProcessedAlpha ? alphaData.get() : nullptr );
 	}
 	return outData;
 }
@@ -205,6 +205,11 @@ void Clamp::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 	maxClampToEnabledPlug()->hash( h );
 }
 
+bool Clamp::processesUniformTiles() const
+{
+	return true;
+}
+
 void Clamp::processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channelName, FloatVectorDataPtr outData ) const
 {
 	const int channelIndex = std::max( 0, ImageAlgo::colorIndex( channelName ) );
@@ -161,9 +161,8 @@ void ColorProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 
 		const string &layerName = context->get<string>( g_layerNameKey );
 
-		FloatVectorDataPtr rgb[3];
+		ConstFloatVectorDataPtr inputs[3];
 		ConstFloatVectorDataPtr alpha;
-		int samples = -1;
 		{
 			ImagePlug::ChannelDataScope channelDataScope( context );
 
@@ -180,46 +179,82 @@ void ColorProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 				if( ImageAlgo::channelExists( channelNames, channelName ) )
 				{
 					channelDataScope.setChannelName( channelName );
-					rgb[i] = inPlug()->channelDataPlug()->getValue()->copy();
+					inputs[i] = inPlug()->channelDataPlug()->getValue();
+				}
+				i++;
+			}
+		}
 
-					samples = rgb[i]->readable().size();
+		if( !inputs[0] && !inputs[1] && !inputs[2] )
+		{
+			throw IECore::Exception( "Cannot evaluate color data plug with no source channels" );
+		}
 
-					if( unpremult && alpha )
-					{
-						const float *A = &alpha->readable().front();
-						float *C = &rgb[i]->writable().front();
-						for( int j = 0; j < samples; j++ )
-						{
-							if( *A != 0 )
-							{
-								*C /= *A;
-							}
-							A++;
-							C++;
-						}
-					}
-				}
-				else
+		// If all the inputs are uniform tiles, then so are the outputs,
+		// and we can process a single pixel instead of a whole tile.
+		// Missing channels are treated as uniform black.
+
+		bool uniform = true;
+		float uniformValues[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for( int i = 0; i < 3 && uniform; i++ )
+		{
+			uniform = !inputs[i] || ImagePlug::uniformTileValue( inputs[i].get(), uniformValues[i] );
+		}
+		if( uniform && alpha )
+		{
+			uniform = ImagePlug::uniformTileValue( alpha.get(), uniformValues[3] );
+		}
+
+		FloatVectorDataPtr rgb[3];
+		int samples = -1;
+		if( uniform )
+		{
+			samples = 1;
+			for( int i = 0; i < 3; i++ )
+			{
+				rgb[i] = new FloatVectorData( vector<float>( 1, uniformValues[i] ) );
+			}
+			if( alpha )
+			{
+				alpha = new FloatVectorData( vector<float>( 1, uniformValues[3] ) );
+			}
+		}
+		else
+		{
+			for( int i = 0; i < 3; i++ )
+			{
+				if( inputs[i] )
 				{
-					rgb[i] = nullptr;
+					rgb[i] = inputs[i]->copy();
+					samples = rgb[i]->readable().size();
 				}
-				i++;
 			}
-
-			if( samples == -1 )
+			for( int i = 0; i < 3; i++ )
 			{
-				throw IECore::Exception( "Cannot evaluate color data plug with no source channels" );
+				if( !rgb[i] )
+				{
+					rgb[i] = new FloatVectorData();
+					rgb[i]->writable().resize( samples, 0.0f );
+				}
 			}
+		}
 
-			for( int k = 0; k < 3; k++ )
+		if( unpremult && alpha )
+		{
+			for( int i = 0; i < 3; i++ )
 			{
-				if( !rgb[k] )
+				const float *A = &alpha->readable().front();
+				float *C = &rgb[i]->writable().front();
+				for( int j = 0; j < samples; j++ )
 				{
-					rgb[k] = new FloatVectorData();
-					rgb[k]->writable().resize( samples, 0.0f );
+					if( *A != 0 )
+					{
+						*C /= *A;
+					}
+					A++;
+					C++;
 				}
 			}
-
 		}
 
 		processColorData( context, rgb[0].get(), rgb[1].get(), rgb[2].get() );
@@ -228,28 +263,37 @@ void ColorProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 		{
 			for( int i = 0; i < 3; i++ )
 			{
-				if( unpremult && alpha )
+				const float *A = &alpha->readable().front();
+				float *C = &rgb[i]->writable().front();
+				for( int j = 0; j < samples; j++ )
 				{
-					const float *A = &alpha->readable().front();
-					float *C = &rgb[i]->writable().front();
-					for( int j = 0; j < samples; j++ )
+					// Pixels with no alpha aren't touched by either the unpremult or repremult
+					if( *A != 0 )
 					{
-						// Pixels with no alpha aren't touched by either the unpremult or repremult
-						if( *A != 0 )
-						{
-							*C *= *A;
-						}
-						A++;
-						C++;
+						*C *= *A;
 					}
+					A++;
+					C++;
 				}
 			}
 		}
 
 		ObjectVectorPtr result = new ObjectVector();
-		result->members().push_back( rgb[0] );
-		result->members().push_back( rgb[1] );
-		result->members().push_back( rgb[2] );
+		for( int i = 0; i < 3; i++ )
+		{
+			if( uniform )
+			{
+				// The result is never modified after being stored on the
+				// plug, so it is safe to share the uniform tile.
+				result->members().push_back(
+					boost::const_pointer_cast<FloatVectorData>( ImagePlug::uniformTile( rgb[i]->readable()[0] ) )
+				);
+			}
+			else
+			{
+				result->members().push_back( rgb[i] );
+			}
+		}
 
 		static_cast<ObjectPlug *>( output )->setValue( result );
 		return;
@@ -198,8 +198,7 @@ IECore::ConstFloatVectorDataPtr Constant::computeChannelData( const std::string
 	}
 	const float value = colorPlug()->getChild( channelIndex )->getValue();
 
-	FloatVectorDataPtr result = new FloatVectorData;
-	result->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize(), value );
-
-	return result;
+	// Every tile is identical, so we share a single one, which also
+	// lets downstream nodes take their uniform tile fast paths.
+	return ImagePlug::uniformTile( value );
 }
@@ -682,58 +682,96 @@ IECore::ConstFloatVectorDataPtr sumByWeights( const std::vector<float> &input,
 	return resultData;
 }
 
+// Key used when sorting the samples of a pixel. We compare based on the Z channel - if it
+// is equal, compare based on ZBack, and if everything is equal, preserve the initial order.
+struct SortKey
+{
+	float z;
+	float zBack;
+	int index;
+
+	bool operator<( const SortKey &other ) const
+	{
+		if( z != other.z )
+		{
+			return z < other.z;
+		}
+		else if( zBack != other.zBack )
+		{
+			return zBack < other.zBack;
+		}
+		else
+		{
+			return index < other.index;
+		}
+	}
+};
+
+// Below this many samples, an insertion sort beats std::sort, particularly
+// since deep samples are often already nearly sorted.
+const int g_insertionSortThreshold = 16;
+
+void insertionSort( SortKey *begin, SortKey *end )
+{
+	for( SortKey *i = begin + 1; i < end; ++i )
+	{
+		const SortKey key = *i;
+		SortKey *j = i;
+		while( j > begin && key < *( j - 1 ) )
+		{
+			*j = *( j - 1 );
+			--j;
+		}
+		*j = key;
+	}
+}
+
 // Given the Z and ZBack channels, and corresponding sampleOffsets, return an IntVectorData
 // a list of sample indices that would produce sorted samples.
 IECore::IntVectorDataPtr computeSampleSorting(
 	const vector<int> &sampleOffsets, const vector<float> &z, const vector<float> &zBack
 )
 {
-	// We compare based on the Z channel - if it is equal, compare based on ZBack
-	struct CompareDepth
-	{
-		const vector<float> &m_zSamples;
-		const vector<float> &m_zBackSamples;
+	IntVectorDataPtr resultData = new IntVectorData();
+	std::vector<int> &result = resultData->writable();
+	result.resize( sampleOffsets.back() );
 
-		CompareDepth( const vector<float> &zSamples, const vector<float> &zBackSamples )
-			: m_zSamples( zSamples ), m_zBackSamples( zBackSamples )
-		{}
+	// Rather than sorting indices with a comparison that must look up Z and ZBack
+	// for every sample compared, we copy the keys for each pixel into a contiguous
+	// buffer which is reused between pixels, and sort that directly.
+	std::vector<SortKey> keys;
 
-		bool operator()( int a, int b ) const
+	int prevOffset = 0;
+	for( int offset : sampleOffsets )
+	{
+		const int numSamples = offset - prevOffset;
+		if( numSamples == 1 )
+		{
+			result[prevOffset] = prevOffset;
+		}
+		else if( numSamples > 1 )
 		{
-			if( m_zSamples[a] != m_zSamples[b] )
+			keys.resize( numSamples );
+			for( int i = 0; i < numSamples; i++ )
 			{
-				return m_zSamples[a] < m_zSamples[b];
+				keys[i] = { z[prevOffset + i], zBack[prevOffset + i], prevOffset + i };
 			}
-			else if( m_zBackSamples[a] != m_zBackSamples[b] )
+
+			if( numSamples <= g_insertionSortThreshold )
 			{
-				return m_zBackSamples[a] < m_zBackSamples[b];
+				insertionSort( &keys[0], &keys[0] + numSamples );
 			}
 			else
 			{
-				// If everything is equal, preserve initial order
-				return a < b;
+				std::sort( keys.begin(), keys.end() );
 			}
-		}
-	};
 
-	IntVectorDataPtr resultData = new IntVectorData();
-	std::vector<int> &result = resultData->writable();
-	result.resize( sampleOffsets.back() );
-	for( unsigned int i = 0; i < result.size(); i++ )
-	{
-		result[i] = i;
-	}
-
-	CompareDepth compare( z, zBack );
-
-	int prevOffset = 0;
-	for( int offset : sampleOffsets )
-	{
-		if( offset > prevOffset )
-		{
-			std::sort( &result[prevOffset], &result[offset], compare );
-			prevOffset = offset;
+			for( int i = 0; i < numSamples; i++ )
+			{
+				result[prevOffset + i] = keys[i].index;
+			}
 		}
+		prevOffset = offset;
 	}
 
 	return resultData;
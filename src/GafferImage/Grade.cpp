@@ -247,6 +247,11 @@ void Grade::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 	whiteClampPlug()->hash( h );
 }
 
+bool Grade::processesUniformTiles() const
+{
+	return true;
+}
+
 void Grade::processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, FloatVectorDataPtr outData ) const
 {
 	// Do some pre-processing.
@@ -37,6 +37,10 @@
 
 #include "boost/iterator/counting_iterator.hpp"
 
+#include "tbb/concurrent_hash_map.h"
+
+#include <cstring>
+
 #include "GafferImage/ImagePlug.h"
 
 #include "GafferImage/BufferAlgo.h"
@@ -45,6 +49,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/ContextAlgo.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 using namespace std;
 using namespace tbb;
@@ -186,6 +191,119 @@ const IECore::FloatVectorData *ImagePlug::blackTile()
 	return g_blackTile.get();
 };
 
+namespace
+{
+
+// Registry of the tiles returned by `ImagePlug::uniformTile()`. Tiles are
+// held in an LRU cache keyed by value, so that memory use is bounded. Each
+// cached tile also has an entry in a map from pointer to value, which is
+// removed when the tile is evicted. Because the cache holds a reference to
+// every tile in the map, no other tile can be allocated at the same address
+// while the entry exists, so the pointer lookup in `uniformTileValue()`
+// can't be fooled by address reuse. Evicted tiles remain valid for anyone
+// still holding them, they just aren't recognised as uniform any more.
+class UniformTileRegistry
+{
+
+	public :
+
+		UniformTileRegistry()
+			:	m_tiles(
+					[this]( uint32_t key, size_t &cost ) { return getter( key, cost ); },
+					[this]( uint32_t, const ConstFloatVectorDataPtr &tile ) { m_values.erase( tile.get() ); },
+					g_maxSize
+				)
+		{
+		}
+
+		ConstFloatVectorDataPtr tile( float value )
+		{
+			// Black and white tiles are permanent, so needn't
+			// take up space in the cache.
+			const uint32_t key = bits( value );
+			if( key == bits( 0.0f ) )
+			{
+				return ImagePlug::blackTile();
+			}
+			else if( key == bits( 1.0f ) )
+			{
+				return ImagePlug::whiteTile();
+			}
+			return m_tiles.get( key );
+		}
+
+		bool value( const FloatVectorData *tile, float &value ) const
+		{
+			if( tile == ImagePlug::blackTile() )
+			{
+				value = 0.0f;
+				return true;
+			}
+			else if( tile == ImagePlug::whiteTile() )
+			{
+				value = 1.0f;
+				return true;
+			}
+
+			ValueMap::const_accessor a;
+			if( !m_values.find( a, tile ) )
+			{
+				return false;
+			}
+			value = a->second;
+			return true;
+		}
+
+	private :
+
+		static uint32_t bits( float value )
+		{
+			uint32_t result;
+			memcpy( &result, &value, sizeof( result ) );
+			return result;
+		}
+
+		ConstFloatVectorDataPtr getter( uint32_t key, size_t &cost )
+		{
+			float value;
+			memcpy( &value, &key, sizeof( value ) );
+
+			ConstFloatVectorDataPtr result = new FloatVectorData( vector<float>( ImagePlug::tilePixels(), value ) );
+			m_values.insert( ValueMap::value_type( result.get(), value ) );
+			cost = 1;
+			return result;
+		}
+
+		static const size_t g_maxSize = 1024;
+
+		typedef IECorePreview::LRUCache<uint32_t, ConstFloatVectorDataPtr> TileCache;
+		typedef concurrent_hash_map<const FloatVectorData *, float> ValueMap;
+
+		// Declared first so that it outlives any removal
+		// callbacks made while destroying `m_tiles`.
+		ValueMap m_values;
+		TileCache m_tiles;
+
+};
+
+UniformTileRegistry &uniformTileRegistry()
+{
+	static UniformTileRegistry *g_registry = new UniformTileRegistry;
+	return *g_registry;
+}
+
+} // namespace
+
+IECore::ConstFloatVectorDataPtr ImagePlug::uniformTile( float value )
+{
+	return uniformTileRegistry().tile( value );
+}
+
+bool ImagePlug::uniformTileValue( const IECore::FloatVectorData *tile, float &value )
+{
+	return uniformTileRegistry().value( tile, value );
+}
+
 bool ImagePlug::acceptsChild( const GraphComponent *potentialChild ) const
 {
 	if( !ValuePlug::acceptsChild( potentialChild ) )
@@ -44,7 +44,13 @@
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/TypedPlug.h"
 
+#include "IECore/NullObject.h"
+#include "IECore/SimpleTypedData.h"
+
+#include <limits>
+
 using namespace std;
+using namespace Imath;
 using namespace Gaffer;
 using namespace GafferImage;
 
@@ -72,6 +78,66 @@ int colorIndex( const ValuePlug *plug )
 	return -1;
 }
 
+// Partial statistics for a region of the image,
+// which may be combined with those of other regions.
+struct Stats
+{
+
+	Stats()
+		:	min( std::numeric_limits<double>::infinity() ),
+			max( -std::numeric_limits<double>::infinity() ),
+			sum( 0.0 )
+	{
+	}
+
+	void add( const Stats &other )
+	{
+		min = std::min( min, other.min );
+		max = std::max( max, other.max );
+		sum += other.sum;
+	}
+
+	// Adds `count` pixels with a value of 0.
+	void addZeroes( size_t count )
+	{
+		if( count )
+		{
+			min = std::min( min, 0.0 );
+			max = std::max( max, 0.0 );
+		}
+	}
+
+	double min;
+	double max;
+	double sum;
+
+};
+
+Stats regionStats( const vector<float> &tileData, const V2i &tileOrigin, const Box2i &region )
+{
+	Stats result;
+	for( int y = region.min.y; y < region.max.y; ++y )
+	{
+		const float *v = &tileData[ImagePlug::pixelIndex( V2i( region.min.x, y ), tileOrigin )];
+		// Sum each row separately before adding it to the total, so that
+		// we accumulate fewer rounding errors for large images.
+		double rowSum = 0.0;
+		for( int x = region.min.x; x < region.max.x; ++x, ++v )
+		{
+			result.min = std::min<double>( result.min, *v );
+			result.max = std::max<double>( result.max, *v );
+			rowSum += *v;
+		}
+		result.sum += rowSum;
+	}
+	return result;
+}
+
+size_t pixelCount( const Box2i &box )
+{
+	return BufferAlgo::empty( box ) ? 0 : (size_t)box.size().x * (size_t)box.size().y;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -109,6 +175,9 @@ ImageStats::ImageStats( const std::string &name )
 	deepStateNode->inPlug()->setInput( inPlug() );
 	deepStateNode->deepStatePlug()->setValue( int( DeepState::TargetState::Flat ) );
 	flattenedInPlug()->setInput( deepStateNode->outPlug() );
+
+	addChild( new ObjectPlug( "__tileStats", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
+	addChild( new ObjectPlug( "__allStats", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
 }
 
 ImageStats::~ImageStats()
@@ -187,24 +256,61 @@ const ImagePlug *ImageStats::flattenedInPlug() const
 
 DeepState *ImageStats::deepState()
 {
-	return getChild<DeepState>( g_firstPlugIndex + 4 );
+	return getChild<DeepState>( g_firstPlugIndex + 7 );
 }
 
 const DeepState *ImageStats::deepState() const
 {
-	return getChild<DeepState>( g_firstPlugIndex + 4 );
+	return getChild<DeepState>( g_firstPlugIndex + 7 );
+}
+
+ObjectPlug *ImageStats::tileStatsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 8 );
+}
+
+const ObjectPlug *ImageStats::tileStatsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 8 );
+}
+
+ObjectPlug *ImageStats::allStatsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 9 );
+}
+
+const ObjectPlug *ImageStats::allStatsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 9 );
 }
 
 void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
+
+	if(
+		input == flattenedInPlug()->dataWindowPlug() ||
+		input == flattenedInPlug()->channelDataPlug()
+	)
+	{
+		outputs.push_back( tileStatsPlug() );
+	}
+
 	if(
 		input == flattenedInPlug()->dataWindowPlug() ||
-		input == flattenedInPlug()->channelNamesPlug() ||
 		input == flattenedInPlug()->channelDataPlug() ||
-		input == channelsPlug() ||
+		input == tileStatsPlug() ||
 		areaPlug()->isAncestorOf( input )
 	)
+	{
+		outputs.push_back( allStatsPlug() );
+	}
+
+	if(
+		input == allStatsPlug() ||
+		input == flattenedInPlug()->channelNamesPlug() ||
+		input == channelsPlug()
+	)
 	{
 		for( unsigned int i = 0; i < 4; ++i )
 		{
@@ -220,6 +326,51 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 {
 	ComputeNode::hash( output, context, h);
 
+	if( output == tileStatsPlug() )
+	{
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			flattenedInPlug()->dataWindowPlug()->hash( h );
+		}
+		flattenedInPlug()->channelDataPlug()->hash( h );
+		h.append( context->get<V2i>( ImagePlug::tileOriginContextName ) );
+		return;
+	}
+	else if( output == allStatsPlug() )
+	{
+		const Box2i area = areaPlug()->getValue();
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			dataWindow = flattenedInPlug()->dataWindowPlug()->getValue();
+		}
+		h.append( area );
+		h.append( dataWindow );
+
+		const Box2i validArea = BufferAlgo::intersection( area, dataWindow );
+		if( BufferAlgo::empty( validArea ) )
+		{
+			return;
+		}
+
+		ImageAlgo::parallelGatherTiles(
+			flattenedInPlug(),
+			// Tile
+			[] ( const ImagePlug *image, const V2i &tileOrigin )
+			{
+				return image->channelDataPlug()->hash();
+			},
+			// Gather
+			[ &h ] ( const ImagePlug *image, const V2i &tileOrigin, const IECore::MurmurHash &tileHash )
+			{
+				h.append( tileHash );
+			},
+			validArea,
+			ImageAlgo::TopToBottom
+		);
+		return;
+	}
+
 	const int colorIndex = ::colorIndex( output );
 	if( colorIndex == -1 )
 	{
@@ -236,12 +387,90 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 		return;
 	}
 
-	Sampler s( inPlug(), channelName, area );
-	s.hash( h );
+	Context::EditableScope channelScope( context );
+	channelScope.set( ImagePlug::channelNameContextName, channelName );
+	allStatsPlug()->hash( h );
 }
 
 void ImageStats::compute( ValuePlug *output, const Context *context ) const
 {
+	if( output == tileStatsPlug() )
+	{
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			dataWindow = flattenedInPlug()->dataWindowPlug()->getValue();
+		}
+
+		const Box2i region = BufferAlgo::intersection( Box2i( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) ), dataWindow );
+		IECore::ConstFloatVectorDataPtr channelData = flattenedInPlug()->channelDataPlug()->getValue();
+		const Stats stats = regionStats( channelData->readable(), tileOrigin, region );
+
+		static_cast<ObjectPlug *>( output )->setValue(
+			new IECore::V3dData( V3d( stats.min, stats.max, stats.sum ) )
+		);
+		return;
+	}
+	else if( output == allStatsPlug() )
+	{
+		const Box2i area = areaPlug()->getValue();
+		Box2i dataWindow;
+		{
+			ImagePlug::GlobalScope globalScope( context );
+			dataWindow = flattenedInPlug()->dataWindowPlug()->getValue();
+		}
+
+		// Pixels outside the data window are treated as black,
+		// and need no reading at all.
+		Stats stats;
+		const Box2i validArea = BufferAlgo::intersection( area, dataWindow );
+		stats.addZeroes( pixelCount( area ) - pixelCount( validArea ) );
+
+		if( !BufferAlgo::empty( validArea ) )
+		{
+			// Reduce the tiles in parallel. Tiles entirely within the area
+			// use the cached per-tile stats, so that changing the area only
+			// requires the tiles on its border to be reprocessed. The gather
+			// is ordered so that the sum is deterministic.
+			ImageAlgo::parallelGatherTiles(
+				flattenedInPlug(),
+				// Tile
+				[ this, &validArea, &dataWindow ] ( const ImagePlug *image, const V2i &tileOrigin )
+				{
+					const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+					const Box2i region = BufferAlgo::intersection( tileBound, validArea );
+					if( region == BufferAlgo::intersection( tileBound, dataWindow ) )
+					{
+						IECore::ConstV3dDataPtr tileStats = IECore::runTimeCast<const IECore::V3dData>( tileStatsPlug()->getValue() );
+						Stats result;
+						result.min = tileStats->readable()[0];
+						result.max = tileStats->readable()[1];
+						result.sum = tileStats->readable()[2];
+						return result;
+					}
+					else
+					{
+						IECore::ConstFloatVectorDataPtr channelData = image->channelDataPlug()->getValue();
+						return regionStats( channelData->readable(), tileOrigin, region );
+					}
+				},
+				// Gather
+				[ &stats ] ( const ImagePlug *image, const V2i &tileOrigin, const Stats &tileStats )
+				{
+					stats.add( tileStats );
+				},
+				validArea,
+				ImageAlgo::TopToBottom
+			);
+		}
+
+		static_cast<ObjectPlug *>( output )->setValue(
+			new IECore::V3dData( V3d( stats.min, stats.max, stats.sum / double( pixelCount( area ) ) ) )
+		);
+		return;
+	}
+
 	const int colorIndex = ::colorIndex( output );
 	if( colorIndex == -1 )
 	{
@@ -259,38 +488,43 @@ void ImageStats::compute( ValuePlug *output, const Context *context ) const
 		return;
 	}
 
-	// Loop over the ROI and compute the min, max and average channel values and then set our outputs.
-	Sampler s( inPlug(), channelName, area );
-
-	float min = Imath::limits<float>::max();
-	float max = Imath::limits<float>::min();
-	double sum = 0.;
-
-	for( int y = area.min.y; y < area.max.y; ++y )
+	IECore::ConstV3dDataPtr allStats;
 	{
-		for( int x = area.min.x; x < area.max.x; ++x )
-		{
-			float v = s.sample( x, y );
-			min = std::min( v, min );
-			max = std::max( v, max );
-			sum += v;
-		}
+		Context::EditableScope channelScope( context );
+		channelScope.set( ImagePlug::channelNameContextName, channelName );
+		allStats = IECore::runTimeCast<const IECore::V3dData>( allStatsPlug()->getValue() );
 	}
 
 	if( output->parent<Plug>() == minPlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( min );
+		static_cast<FloatPlug *>( output )->setValue( allStats->readable()[0] );
 	}
 	else if( output->parent<Plug>() == maxPlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( max );
+		static_cast<FloatPlug *>( output )->setValue( allStats->readable()[1] );
 	}
 	else if( output->parent<Plug>() == averagePlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue(
-			sum / double( (area.size().x) * (area.size().y) )
-		);
+		static_cast<FloatPlug *>( output )->setValue( allStats->readable()[2] );
+	}
+}
+
+Gaffer::ValuePlug::CachePolicy ImageStats::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == allStatsPlug() )
+	{
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return ComputeNode::computeCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy ImageStats::hashCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == allStatsPlug() )
+	{
+		return ValuePlug::CachePolicy::TaskCollaboration;
 	}
+	return ComputeNode::hashCachePolicy( output );
 }
 
 std::string ImageStats::channelName( int colorIndex ) const
@@ -234,17 +234,19 @@ class FlatTileWriter
 	// so set the appropriate m_tilesFilled value.
 	//
 	// After flagging filled tiles, it iterates through tiles, starting at
-	// m_nextTileIndex, and for each tile, if the tile is marked as filled,
-	// write it, and if the tile does not intersect the region covered by the
-	// input tiles, write a black tile. If neither of these is the case, stop,
-	// and set m_nextTileIndex to the tile that it stopped on, which is the
-	// next tile to write.
+	// m_nextTileIndex, finding the run of tiles which are ready to write -
+	// those which are either filled or which don't intersect the region
+	// covered by the input tiles (and are therefore black). Every complete
+	// row of tiles within that run is then written with a single call to
+	// `write_tiles()`, and m_nextTileIndex is advanced to the start of the
+	// next row. Writing whole rows at once allows ImageOutputs which support
+	// it (notably OpenEXR) to compress the tiles in parallel, rather than
+	// compressing one tile at a time on the thread calling us.
 	//
 	// Once all Gaffer tiles have been processed, there may still be partially
 	// unfilled tiles, which will be fine, as their unfilled areas will be
-	// black, which is what we want. So iterate over the remaining tiles, and
-	// if memory has been allocated for that tile, write it to the file, and if
-	// nothing has been allocated, write a black tile.
+	// black, which is what we want. So we write all remaining rows, using
+	// black for any tile that nothing has been allocated for.
 	public:
 		FlatTileWriter(
 				ImageOutputPtr out,
@@ -260,8 +262,7 @@ class FlatTileWriter
 				m_inputTilesBounds( Imath::Box2i( ImagePlug::tileOrigin( processWindow.min ), ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) + Imath::V2i( ImagePlug::tileSize() ) ) ),
 				m_outputDataWindow( m_format.fromEXRSpace( Imath::Box2i( Imath::V2i( m_spec.x, m_spec.y ), Imath::V2i( m_spec.x + m_spec.width - 1, m_spec.y + m_spec.height - 1 ) ) ) ),
 				m_numTiles( Imath::V2i( (int)ceil( float( m_spec.width ) / m_spec.tile_width ), (int)ceil( float( m_spec.height ) / m_spec.tile_height ) ) ),
-				m_nextTileIndex( 0 ),
-				m_blackTile( nullptr )
+				m_nextTileIndex( 0 )
 		{
 			m_tilesData.resize( m_numTiles.x * m_numTiles.y );
 			m_tilesFilled.resize( m_numTiles.x * m_numTiles.y, false );
@@ -274,20 +275,10 @@ class FlatTileWriter
 
 		void finish()
 		{
-			for( size_t tileIndex = m_nextTileIndex; tileIndex < m_tilesData.size(); ++tileIndex )
+			while( m_nextTileIndex < m_tilesData.size() )
 			{
-				Imath::V2i tileOrigin = outTileOrigin( tileIndex );
-				if( !m_tilesData[tileIndex]->readable().empty() )
-				{
-					writeTile( tileOrigin, m_tilesData[tileIndex] );
-				}
-				else
-				{
-					// If the tileData object hasn't been resized, then
-					// we have never even tried to write data to this
-					// tile, so write the static black tile.
-					writeTile( tileOrigin, blackTile() );
-				}
+				writeTileRow( m_nextTileIndex );
+				m_nextTileIndex += m_numTiles.x;
 			}
 		}
 
@@ -335,16 +326,6 @@ class FlatTileWriter
 
 	private:
 
-		inline ConstFloatVectorDataPtr blackTile()
-		{
-			if( m_blackTile == nullptr )
-			{
-				m_blackTile = new IECore::FloatVectorData( std::vector<float>( m_spec.tile_width * m_spec.tile_height * m_spec.channelnames.size(), 0. ) );
-			}
-
-			return m_blackTile;
-		}
-
 		inline size_t outTileIndex( const Imath::V2i &tileOrigin ) const
 		{
 			return ( ( ( m_outputDataWindow.max.y - m_spec.tile_height - tileOrigin.y ) / m_spec.tile_height ) * m_numTiles.x ) + ( ( tileOrigin.x - m_outputDataWindow.min.x ) / m_spec.tile_width );
@@ -400,34 +381,70 @@ class FlatTileWriter
 			size_t tileIndex;
 			for( tileIndex = m_nextTileIndex; tileIndex < m_tilesData.size(); ++tileIndex )
 			{
-				Imath::V2i tileOrigin = outTileOrigin( tileIndex );
-
-				if( m_tilesFilled[tileIndex] )
+				if( !m_tilesFilled[tileIndex] && BufferAlgo::intersects( m_inputTilesBounds, outTileBounds( tileIndex ) ) )
 				{
-					writeTile( tileOrigin, m_tilesData[tileIndex] );
-					m_tilesData[tileIndex].reset();
+					break;
 				}
-				else if( !BufferAlgo::intersects( m_inputTilesBounds, outTileBounds( tileIndex ) ) )
+			}
+
+			// Tile indices increase from left to right along each row, so
+			// rows always start at a multiple of m_numTiles.x.
+			const size_t readyRowsEnd = tileIndex - ( tileIndex % m_numTiles.x );
+			while( m_nextTileIndex < readyRowsEnd )
+			{
+				writeTileRow( m_nextTileIndex );
+				m_nextTileIndex += m_numTiles.x;
+			}
+		}
+
+		// Writes the row of tiles starting at `rowStartIndex`, freeing the
+		// tile data as we go.
+		void writeTileRow( size_t rowStartIndex )
+		{
+			const size_t numChannels = m_spec.channelnames.size();
+			const size_t tileLineSize = m_spec.tile_width * numChannels;
+			const size_t rowLineSize = tileLineSize * m_numTiles.x;
+
+			// Interleave the tiles into a single buffer for the whole row.
+			m_rowData.resize( rowLineSize * m_spec.tile_height );
+			for( int x = 0; x < m_numTiles.x; ++x )
+			{
+				FloatVectorDataPtr &tileData = m_tilesData[rowStartIndex + x];
+				float *rowTile = &m_rowData[x * tileLineSize];
+				if( tileData && !tileData->readable().empty() )
 				{
-					writeTile( tileOrigin, blackTile() );
+					const float *tile = &tileData->readable()[0];
+					for( int y = 0; y < m_spec.tile_height; ++y )
+					{
+						memcpy( rowTile + y * rowLineSize, tile + y * tileLineSize, tileLineSize * sizeof( float ) );
+					}
 				}
 				else
 				{
-					break;
+					// If the tileData object hasn't been resized, then
+					// we have never even tried to write data to this
+					// tile, so it is black.
+					for( int y = 0; y < m_spec.tile_height; ++y )
+					{
+						memset( rowTile + y * rowLineSize, 0, tileLineSize * sizeof( float ) );
+					}
 				}
+				tileData.reset();
 			}
 
-			m_nextTileIndex = tileIndex;
-		}
-
+			// Tiles at the right and bottom edges may extend past the data
+			// window, in which case we clamp to the edge of the image, and use
+			// strides to skip the excess data.
+			const Imath::V2i exrRowOrigin = m_format.toEXRSpace( outTileOrigin( rowStartIndex ) + Imath::V2i( 0, m_spec.tile_height - 1 ) );
+			const int exrRowEnd = std::min( exrRowOrigin.y + m_spec.tile_height, m_spec.y + m_spec.height );
 
-		void writeTile( const Imath::V2i &tileOrigin, ConstFloatVectorDataPtr tileData ) const
-		{
-			Imath::V2i exrTileOrigin = m_format.toEXRSpace( tileOrigin + Imath::V2i( 0, m_spec.tile_height - 1 ) );
-
-			if( !m_out->write_tile( exrTileOrigin.x, exrTileOrigin.y, 0, TypeDesc::FLOAT, &tileData->readable()[0] ) )
+			if( !m_out->write_tiles(
+				m_spec.x, m_spec.x + m_spec.width, exrRowOrigin.y, exrRowEnd, 0, 1,
+				TypeDesc::FLOAT, &m_rowData[0],
+				/* xstride = */ numChannels * sizeof( float ), /* ystride = */ rowLineSize * sizeof( float )
+			) )
 			{
-				throw IECore::Exception( boost::str( boost::format( "Could not write tile to \"%s\", error = %s" ) % m_fileName % m_out->geterror() ) );
+				throw IECore::Exception( boost::str( boost::format( "Could not write tiles to \"%s\", error = %s" ) % m_fileName % m_out->geterror() ) );
 			}
 		}
 
@@ -442,7 +459,7 @@ class FlatTileWriter
 		size_t m_nextTileIndex;
 		std::vector<FloatVectorDataPtr> m_tilesData;
 		std::vector<bool> m_tilesFilled;
-		ConstFloatVectorDataPtr m_blackTile;
+		std::vector<float> m_rowData;
 };
 
 class FlatScanlineWriter
@@ -1276,6 +1293,8 @@ ImageWriter::ImageWriter( const std::string &name )
 
 	colorSpaceChild->outputSpacePlug()->setValue( "${__imageWriter:colorSpace}" );
 
+	addChild( new IntPlug( "framesInParallel", Plug::In, 1, 1 ) );
+
 	createFileFormatOptionsPlugs();
 }
 
@@ -1416,6 +1435,16 @@ const GafferImage::ColorSpace *ImageWriter::colorSpaceNode() const
 	return getChild<ColorSpace>( g_firstPlugIndex+6 );
 }
 
+Gaffer::IntPlug *ImageWriter::framesInParallelPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex+7 );
+}
+
+const Gaffer::IntPlug *ImageWriter::framesInParallelPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex+7 );
+}
+
 Gaffer::ValuePlug *ImageWriter::fileFormatSettingsPlug( const std::string &fileFormat )
 {
 	return getChild<ValuePlug>( fileFormat );
@@ -1518,6 +1547,34 @@ IECore::MurmurHash ImageWriter::hash( const Context *context ) const
 	return h;
 }
 
+void ImageWriter::executeSequence( const std::vector<float> &frames ) const
+{
+	size_t maxFramesInFlight = std::max( framesInParallelPlug()->getValue(), 1 );
+	if( maxFramesInFlight > 1 && frames.size() > 1 )
+	{
+		// Every frame in flight pulls its tiles through the compute cache.
+		// Limit the frames in flight so that their combined tiles fit in
+		// half of the cache, leaving room for the frame-invariant upstream
+		// results we hope to share between frames.
+		Context::EditableScope frameScope( Context::current() );
+		frameScope.setFrame( frames.front() );
+		const Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
+		if( !BufferAlgo::empty( dataWindow ) )
+		{
+			const size_t frameBytes =
+				(size_t)dataWindow.size().x * dataWindow.size().y *
+				inPlug()->channelNamesPlug()->getValue()->readable().size() * sizeof( float )
+			;
+			if( frameBytes )
+			{
+				maxFramesInFlight = std::min( maxFramesInFlight, std::max<size_t>( ValuePlug::getCacheMemoryLimit() / ( 2 * frameBytes ), 1 ) );
+			}
+		}
+	}
+
+	executeSequenceInParallel( frames, maxFramesInFlight );
+}
+
 void ImageWriter::execute() const
 {
 	// Set up a context to pass the right colorspace to
@@ -43,6 +43,8 @@
 
 #include "IECore/BoxOps.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -67,6 +69,148 @@ float opUnder( float A, float B, float a, float b){ return A*(1.-b) + B; }
 float opMin( float A, float B, float a, float b){ return std::min( A, B ); }
 float opMax( float A, float B, float a, float b){ return std::max( A, B ); }
 
+// Returns true if the operation uses the alpha of the upper layer (a).
+bool usesUpperAlpha( Merge::Operation operation )
+{
+	switch( operation )
+	{
+		case Merge::Atop :
+		case Merge::Mask :
+		case Merge::Matte :
+		case Merge::Over :
+			return true;
+		default :
+			return false;
+	}
+}
+
+// Returns true if the operation uses the alpha of the lower layer (b),
+// in which case we must track the alpha of the intermediate composite.
+bool usesLowerAlpha( Merge::Operation operation )
+{
+	switch( operation )
+	{
+		case Merge::Atop :
+		case Merge::In :
+		case Merge::Out :
+		case Merge::Under :
+			return true;
+		default :
+			return false;
+	}
+}
+
+// Returns true if we need to fetch alpha tiles from the inputs in order
+// to merge `channelName`. When merging the alpha channel itself, the
+// channel data doubles as the alpha data.
+bool requiresAlpha( Merge::Operation operation, const std::string &channelName )
+{
+	return channelName != "A" && ( usesUpperAlpha( operation ) || usesLowerAlpha( operation ) );
+}
+
+// Kernels for compositing a span of pixels from an upper layer (A, a)
+// onto the intermediate result (B, b). These are templated on the operation
+// so that each gets a tight, branch-free loop which the compiler can inline
+// and vectorise. When `TrackAlpha` is false, `b` may alias `B`, so we take
+// care to read it before writing to `B`.
+
+typedef float (*MergeFunction)( float A, float B, float a, float b );
+
+template<MergeFunction F, bool TrackAlpha>
+void mergeValidSpan( const float *A, const float *a, float *B, float *b, int n )
+{
+	for( int i = 0; i < n; ++i )
+	{
+		const float bv = b[i];
+		B[i] = F( A[i], B[i], a[i], bv );
+		if( TrackAlpha )
+		{
+			b[i] = F( a[i], bv, a[i], bv );
+		}
+	}
+}
+
+// As above, but for pixels outside the upper layer's data window, which
+// are treated as black.
+template<MergeFunction F, bool TrackAlpha>
+void mergeInvalidSpan( float *B, float *b, int n )
+{
+	for( int i = 0; i < n; ++i )
+	{
+		const float bv = b[i];
+		B[i] = F( 0.0f, B[i], 0.0f, bv );
+		if( TrackAlpha )
+		{
+			b[i] = F( 0.0f, bv, 0.0f, bv );
+		}
+	}
+}
+
+template<MergeFunction F, bool TrackAlpha>
+void mergeTile( const float *A, const float *a, float *B, float *b, const Box2i &tileBound, const Box2i &validBound )
+{
+	if( validBound == tileBound )
+	{
+		// Fast path for the common case of a tile entirely inside the
+		// data window - no bounds checks are needed at all.
+		mergeValidSpan<F, TrackAlpha>( A, a, B, b, ImagePlug::tilePixels() );
+		return;
+	}
+	else if( BufferAlgo::empty( validBound ) )
+	{
+		mergeInvalidSpan<F, TrackAlpha>( B, b, ImagePlug::tilePixels() );
+		return;
+	}
+
+	// Partially valid tile. We split each row into up to three spans
+	// so that the inner loops remain free of bounds checks.
+	const int tileSize = ImagePlug::tileSize();
+	const int validBegin = validBound.min.x - tileBound.min.x;
+	const int validEnd = validBound.max.x - tileBound.min.x;
+	for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
+	{
+		const size_t offset = ( y - tileBound.min.y ) * tileSize;
+		if( y < validBound.min.y || y >= validBound.max.y )
+		{
+			mergeInvalidSpan<F, TrackAlpha>( B + offset, b + offset, tileSize );
+			continue;
+		}
+
+		mergeInvalidSpan<F, TrackAlpha>( B + offset, b + offset, validBegin );
+		mergeValidSpan<F, TrackAlpha>( A + offset + validBegin, a + offset + validBegin, B + offset + validBegin, b + offset + validBegin, validEnd - validBegin );
+		mergeInvalidSpan<F, TrackAlpha>( B + offset + validEnd, b + offset + validEnd, tileSize - validEnd );
+	}
+}
+
+// Zeroes the parts of `data` that are outside `validBound`.
+void maskInvalid( float *data, const Box2i &tileBound, const Box2i &validBound )
+{
+	if( validBound == tileBound )
+	{
+		return;
+	}
+
+	const int tileSize = ImagePlug::tileSize();
+	for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
+	{
+		float *row = data + ( y - tileBound.min.y ) * tileSize;
+		if( y < validBound.min.y || y >= validBound.max.y || BufferAlgo::empty( validBound ) )
+		{
+			std::fill( row, row + tileSize, 0.0f );
+			continue;
+		}
+		std::fill( row, row + validBound.min.x - tileBound.min.x, 0.0f );
+		std::fill( row + validBound.max.x - tileBound.min.x, row + tileSize, 0.0f );
+	}
+}
+
+struct Layer
+{
+	ConstFloatVectorDataPtr channelData;
+	ConstFloatVectorDataPtr alphaData;
+	Box2i validBound;
+};
+
 } // namespace
 
 GAFFER_GRAPHCOMPONENT_DEFINE_TYPE( Merge );
@@ -197,6 +341,7 @@ void Merge::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 	const std::string channelName = context->get<std::string>( ImagePlug::channelNameContextName );
 	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+	const bool alphaRequired = requiresAlpha( (Operation)operationPlug()->getValue(), channelName );
 
 	for( ImagePlugIterator it( inPlugs() ); !it.done(); ++it )
 	{
@@ -228,7 +373,7 @@ void Merge::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 				(*it)->channelDataPlug()->hash( h );
 			}
 
-			if( ImageAlgo::channelExists( channelNames, "A" ) )
+			if( alphaRequired && ImageAlgo::channelExists( channelNames, "A" ) )
 			{
 				h.append( (*it)->channelDataHash( "A", tileOrigin ) );
 			}
@@ -252,50 +397,54 @@ void Merge::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 
 IECore::ConstFloatVectorDataPtr Merge::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	switch( operationPlug()->getValue() )
+	const Operation operation = (Operation)operationPlug()->getValue();
+	switch( operation )
 	{
 		case Add :
-			return merge( opAdd, channelName, tileOrigin);
+			return merge<opAdd>( operation, channelName, tileOrigin );
 		case Atop :
-			return merge( opAtop, channelName, tileOrigin);
+			return merge<opAtop>( operation, channelName, tileOrigin );
 		case Divide :
-			return merge( opDivide, channelName, tileOrigin);
+			return merge<opDivide>( operation, channelName, tileOrigin );
 		case In :
-			return merge( opIn, channelName, tileOrigin);
+			return merge<opIn>( operation, channelName, tileOrigin );
 		case Out :
-			return merge( opOut, channelName, tileOrigin);
+			return merge<opOut>( operation, channelName, tileOrigin );
 		case Mask :
-			return merge( opMask, channelName, tileOrigin);
+			return merge<opMask>( operation, channelName, tileOrigin );
 		case Matte :
-			return merge( opMatte, channelName, tileOrigin);
+			return merge<opMatte>( operation, channelName, tileOrigin );
 		case Multiply :
-			return merge( opMultiply, channelName, tileOrigin);
+			return merge<opMultiply>( operation, channelName, tileOrigin );
 		case Over :
-			return merge( opOver, channelName, tileOrigin);
+			return merge<opOver>( operation, channelName, tileOrigin );
 		case Subtract :
-			return merge( opSubtract, channelName, tileOrigin);
+			return merge<opSubtract>( operation, channelName, tileOrigin );
 		case Difference :
-			return merge( opDifference, channelName, tileOrigin);
+			return merge<opDifference>( operation, channelName, tileOrigin );
 		case Under :
-			return merge( opUnder, channelName, tileOrigin);
+			return merge<opUnder>( operation, channelName, tileOrigin );
 		case Min :
-			return merge( opMin, channelName, tileOrigin);
+			return merge<opMin>( operation, channelName, tileOrigin );
 		case Max :
-			return merge( opMax, channelName, tileOrigin);
+			return merge<opMax>( operation, channelName, tileOrigin );
 	}
 
 	throw Exception( "Merge::computeChannelData : Invalid operation mode." );
 }
 
-template<typename F>
-IECore::ConstFloatVectorDataPtr Merge::merge( F f, const std::string &channelName, const Imath::V2i &tileOrigin ) const
+template<float (*F)( float A, float B, float a, float b )>
+IECore::ConstFloatVectorDataPtr Merge::merge( Operation operation, const std::string &channelName, const Imath::V2i &tileOrigin ) const
 {
-	FloatVectorDataPtr resultData = nullptr;
-	// Temporary buffer for computing the alpha of intermediate composited layers.
-	FloatVectorDataPtr resultAlphaData = nullptr;
-
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+	const bool alphaRequired = requiresAlpha( operation, channelName );
+	const bool trackAlpha = alphaRequired && usesLowerAlpha( operation );
+
+	// Gather the tiles from all connected inputs up front, fetching
+	// alpha only if the operation actually needs it.
 
+	vector<Layer> layers;
+	layers.reserve( inPlugs()->children().size() );
 	for( ImagePlugIterator it( inPlugs() ); !it.done(); ++it )
 	{
 		if( !(*it)->getInput<ValuePlug>() )
@@ -313,88 +462,136 @@ IECore::ConstFloatVectorDataPtr Merge::merge( F f, const std::string &channelNam
 
 		const std::vector<std::string> &channelNames = channelNamesData->readable();
 
-		ConstFloatVectorDataPtr channelData;
-		ConstFloatVectorDataPtr alphaData;
-
-		const Box2i validBound = boxIntersection( tileBound, dataWindow );
+		Layer layer;
+		layer.validBound = boxIntersection( tileBound, dataWindow );
+		if( BufferAlgo::empty( layer.validBound ) )
+		{
+			// Normalise, so that we can use the empty bound
+			// to identify wholly invalid tiles.
+			layer.validBound = Box2i();
+		}
 
-		if( ImageAlgo::channelExists( channelNames, channelName ) && !BufferAlgo::empty( validBound ) )
+		if( ImageAlgo::channelExists( channelNames, channelName ) && !BufferAlgo::empty( layer.validBound ) )
 		{
-			channelData = (*it)->channelDataPlug()->getValue();
+			layer.channelData = (*it)->channelDataPlug()->getValue();
 		}
 		else
 		{
-			channelData = ImagePlug::blackTile();
+			layer.channelData = ImagePlug::blackTile();
 		}
 
-		if( ImageAlgo::channelExists( channelNames, "A" ) && !BufferAlgo::empty( validBound ) )
+		if( !alphaRequired )
 		{
-			alphaData = (*it)->channelData( "A", tileOrigin );
+			layer.alphaData = layer.channelData;
+		}
+		else if( ImageAlgo::channelExists( channelNames, "A" ) && !BufferAlgo::empty( layer.validBound ) )
+		{
+			layer.alphaData = (*it)->channelData( "A", tileOrigin );
 		}
 		else
 		{
-			alphaData = ImagePlug::blackTile();
+			layer.alphaData = ImagePlug::blackTile();
 		}
 
-		if( (int)alphaData->readable().size() != ImagePlug::tilePixels()  )
+		if( (int)layer.alphaData->readable().size() != ImagePlug::tilePixels()  )
 		{
 			throw IECore::Exception( "Merge::computeChannelData : Cannot process deep data." );
 		}
-		if( (int)channelData->readable().size() != ImagePlug::tilePixels() )
+		if( (int)layer.channelData->readable().size() != ImagePlug::tilePixels() )
 		{
 			throw IECore::Exception( "Merge::computeChannelData : Cannot process deep data." );
 		}
 
-		if( !resultData )
+		layers.push_back( layer );
+	}
+
+	if( layers.empty() )
+	{
+		return ImagePlug::blackTile();
+	}
+
+	// If every layer is uniform across the tile, then so is the result,
+	// and we need only merge a single pixel. Layers which are wholly
+	// outside their data window count as uniform black.
+
+	vector<float> uniformValues;
+	uniformValues.reserve( layers.size() * 2 );
+	for( const auto &layer : layers )
+	{
+		float value = 0.0f;
+		float alpha = 0.0f;
+		if( layer.validBound == tileBound )
 		{
-			// The first connected layer, with which we must initialise our result.
-			// There's no guarantee that this layer actually covers the full data
-			// window though (the data window could have been expanded by the upper
-			// layers) so we must take care to mask out any invalid areas of the input.
-			/// \todo I'm not convinced this is correct - if we have no connection
-			/// to in[0] then should that not be treated as being a black image, so
-			/// we should unconditionally initaliase with in[0] and then always use
-			/// the operation for in[1:], even if in[0] is disconnected. In other
-			/// words, shouldn't multiplying a white constant over an unconnected
-			/// in[0] produce black?
-			resultData = channelData->copy();
-			resultAlphaData = alphaData->copy();
-			float *B = &resultData->writable().front();
-			float *b = &resultAlphaData->writable().front();
-			for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
+			if( !ImagePlug::uniformTileValue( layer.channelData.get(), value ) || !ImagePlug::uniformTileValue( layer.alphaData.get(), alpha ) )
 			{
-				const bool yValid = y >= validBound.min.y && y < validBound.max.y;
-				for( int x = tileBound.min.x; x < tileBound.max.x; ++x )
-				{
-					if( !yValid || x < validBound.min.x || x >= validBound.max.x )
-					{
-						*B = *b = 0.0f;
-					}
-					++B; ++b;
-				}
+				break;
 			}
 		}
-		else
+		else if( !BufferAlgo::empty( layer.validBound ) )
 		{
-			// A higher layer (A) which must be composited over the result (B).
-			const float *A = &channelData->readable().front();
-			float *B = &resultData->writable().front();
-			const float *a = &alphaData->readable().front();
-			float *b = &resultAlphaData->writable().front();
+			break;
+		}
+		uniformValues.push_back( value );
+		uniformValues.push_back( alpha );
+	}
 
-			for( int y = tileBound.min.y; y < tileBound.max.y; ++y )
+	if( uniformValues.size() == layers.size() * 2 )
+	{
+		float B = uniformValues[0];
+		float b = trackAlpha ? uniformValues[1] : B;
+		for( size_t i = 2; i < uniformValues.size(); i += 2 )
+		{
+			if( trackAlpha )
 			{
-				const bool yValid = y >= validBound.min.y && y < validBound.max.y;
-				for( int x = tileBound.min.x; x < tileBound.max.x; ++x )
-				{
-					const bool valid = yValid && x >= validBound.min.x && x < validBound.max.x;
+				mergeValidSpan<F, true>( &uniformValues[i], &uniformValues[i+1], &B, &b, 1 );
+			}
+			else
+			{
+				mergeValidSpan<F, false>( &uniformValues[i], &uniformValues[i+1], &B, &B, 1 );
+			}
+		}
+		return ImagePlug::uniformTile( B );
+	}
 
-					*B = f( valid ? *A : 0.0f, *B, valid ? *a : 0.0f, *b );
-					*b = f( valid ? *a : 0.0f, *b, valid ? *a : 0.0f, *b );
+	// The first connected layer, with which we must initialise our result.
+	// There's no guarantee that this layer actually covers the full data
+	// window though (the data window could have been expanded by the upper
+	// layers) so we must take care to mask out any invalid areas of the input.
+	/// \todo I'm not convinced this is correct - if we have no connection
+	/// to in[0] then should that not be treated as being a black image, so
+	/// we should unconditionally initaliase with in[0] and then always use
+	/// the operation for in[1:], even if in[0] is disconnected. In other
+	/// words, shouldn't multiplying a white constant over an unconnected
+	/// in[0] produce black?
+
+	FloatVectorDataPtr resultData = layers[0].channelData->copy();
+	float *B = &resultData->writable().front();
+	maskInvalid( B, tileBound, layers[0].validBound );
 
-					++A; ++B; ++a; ++b;
-				}
-			}
+	// Temporary buffer for computing the alpha of intermediate composited layers.
+	// This is only needed when the operation reads the lower alpha and we're not
+	// merging alpha itself, otherwise we alias the result.
+	FloatVectorDataPtr resultAlphaData;
+	float *b = B;
+	if( trackAlpha )
+	{
+		resultAlphaData = layers[0].alphaData->copy();
+		b = &resultAlphaData->writable().front();
+		maskInvalid( b, tileBound, layers[0].validBound );
+	}
+
+	// The higher layers (A), which must be composited over the result (B).
+	for( vector<Layer>::const_iterator it = layers.begin() + 1, eIt = layers.end(); it != eIt; ++it )
+	{
+		const float *A = &it->channelData->readable().front();
+		const float *a = &it->alphaData->readable().front();
+		if( trackAlpha )
+		{
+			mergeTile<F, true>( A, a, B, b, tileBound, it->validBound );
+		}
+		else
+		{
+			mergeTile<F, false>( A, a, B, b, tileBound, it->validBound );
 		}
 	}
 
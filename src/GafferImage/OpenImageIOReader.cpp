@@ -58,11 +58,12 @@
 
 #include "boost/bind.hpp"
 #include "boost/filesystem/path.hpp"
+#include "boost/noncopyable.hpp"
 #include "boost/regex.hpp"
 
-#include "tbb/mutex.h"
-
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 OIIO_NAMESPACE_USING
 
@@ -78,6 +79,11 @@ namespace
 
 const IECore::InternedString g_tileBatchIndexContextName( "__tileBatchIndex" );
 
+// The maximum number of ImageInputs we will open for a single file, and
+// therefore the maximum number of tile batches which may be read from
+// it concurrently.
+const size_t g_maxImageInputsPerFile = 4;
+
 struct ChannelMapEntry
 {
 	ChannelMapEntry( int subImage, int channelIndex )
@@ -150,6 +156,8 @@ V2i coordinateDivide( V2i a, V2i b )
 // of the image horizontally ( this means that the left of the tileBatch is aligned to the data window, not
 // the origin ).
 //
+// ImageInputs may only be used by one thread at a time, so we keep a small pool of them per file, allowing
+// different tile batches to be read concurrently.
 //
 class File
 {
@@ -157,15 +165,17 @@ class File
 	public:
 
 		// Create a File handle object for an image input and image spec
-		File( std::unique_ptr<ImageInput> imageInput, ImageSpec imageSpec, const std::string &infoFileName )
-			: m_imageInput( std::move( imageInput ) ), m_imageSpec( imageSpec )
+		File( std::unique_ptr<ImageInput> imageInput, ImageSpec imageSpec, const std::string &fileName )
+			: m_fileName( fileName ), m_formatName( imageInput->format_name() ), m_imageSpec( imageSpec ), m_numImageInputs( 1 )
 		{
+			const std::string &infoFileName = fileName;
+
 			std::vector<std::string> channelNames;
 
 			// \todo - for stereo images, we would need to take note of which view a subimage is for,
 			// and drive loading based on that.  This might require reorganizing this structure where
-			// we store m_imageSpec together with m_imageInput, since a stero image would have one
-			// m_imageInput, but could need two separate image specs ( different data windows for the two eyes seem
+			// we store m_imageSpec together with the ImageInputs, since a stero image would have one
+			// file, but could need two separate image specs ( different data windows for the two eyes seem
 			// reasonable )
 			ImageSpec currentSpec = m_imageSpec;
 			int subImageIndex = 0;
@@ -218,7 +228,9 @@ class File
 					break;
 				}
 				subImageIndex++;
-			} while( m_imageInput->seek_subimage( subImageIndex, 0, currentSpec ) );
+			} while( imageInput->seek_subimage( subImageIndex, 0, currentSpec ) );
+
+			m_idleImageInputs.push_back( std::move( imageInput ) );
 
 			m_channelNamesData = new StringVectorData( channelNames );
 
@@ -480,9 +492,9 @@ class File
 			return m_imageSpec;
 		}
 
-		std::string formatName() const
+		const std::string &formatName() const
 		{
-			return m_imageInput->format_name();
+			return m_formatName;
 		}
 
 		ConstStringVectorDataPtr channelNamesData()
@@ -491,6 +503,100 @@ class File
 		}
 
 	private:
+
+		// Borrows an ImageInput from the pool for the lifetime of the scope,
+		// returning it to the pool on destruction.
+		class ScopedImageInput : boost::noncopyable
+		{
+
+			public :
+
+				ScopedImageInput( File &file )
+					:	m_file( file ), m_imageInput( file.acquireImageInput() )
+				{
+				}
+
+				~ScopedImageInput()
+				{
+					m_file.releaseImageInput( std::move( m_imageInput ) );
+				}
+
+				ImageInput *get() const
+				{
+					return m_imageInput.get();
+				}
+
+				ImageInput *operator->() const
+				{
+					return m_imageInput.get();
+				}
+
+			private :
+
+				File &m_file;
+				std::unique_ptr<ImageInput> m_imageInput;
+
+		};
+
+		// Returns an idle ImageInput, opening a new one if none are
+		// available and we have not yet reached `g_maxImageInputsPerFile`,
+		// and otherwise waiting for another read to complete.
+		std::unique_ptr<ImageInput> acquireImageInput()
+		{
+			std::unique_lock<std::mutex> lock( m_imageInputsMutex );
+			while( m_idleImageInputs.empty() )
+			{
+				if( m_numImageInputs < g_maxImageInputsPerFile )
+				{
+					m_numImageInputs++;
+					lock.unlock();
+					try
+					{
+						return openImageInput();
+					}
+					catch( ... )
+					{
+						// Opening failed, so allow another attempt.
+						lock.lock();
+						m_numImageInputs--;
+						lock.unlock();
+						m_imageInputAvailable.notify_one();
+						throw;
+					}
+				}
+				m_imageInputAvailable.wait( lock );
+			}
+
+			std::unique_ptr<ImageInput> result = std::move( m_idleImageInputs.back() );
+			m_idleImageInputs.pop_back();
+			return result;
+		}
+
+		void releaseImageInput( std::unique_ptr<ImageInput> imageInput )
+		{
+			{
+				std::lock_guard<std::mutex> lock( m_imageInputsMutex );
+				m_idleImageInputs.push_back( std::move( imageInput ) );
+			}
+			m_imageInputAvailable.notify_one();
+		}
+
+		std::unique_ptr<ImageInput> openImageInput() const
+		{
+			std::unique_ptr<ImageInput> result( ImageInput::create( m_fileName ) );
+			if( !result )
+			{
+				throw IECore::Exception( "OpenImageIOReader : Could not create ImageInput : " + OIIO::geterror() );
+			}
+
+			ImageSpec spec;
+			if( !result->open( m_fileName, spec ) )
+			{
+				throw IECore::Exception( "OpenImageIOReader : Could not open ImageInput : " + result->geterror() );
+			}
+			return result;
+		}
+
 		// Fill the data vector ( for a flat image ) or the deepData object ( for a deep image )
 		// with all data for the specified subImage and target region,
 		// setting the dataRegion to represent the actual bounds of the data read ( which may have had to
@@ -502,11 +608,11 @@ class File
 		{
 			/// \todo OIIO 2.0 introduces thread-safe `read_*()` methods that
 			/// are passed the subimage directly. Upgrade to use those and remove
-			/// this lock entirely.
-			tbb::mutex::scoped_lock lock( m_mutex );
+			/// the ImageInput pool entirely.
+			ScopedImageInput imageInput( *this );
 
 			ImageSpec subImageSpec;
-			m_imageInput->seek_subimage( subImage, 0, subImageSpec );
+			imageInput->seek_subimage( subImage, 0, subImageSpec );
 
 			const V2i fileDataOrigin( m_imageSpec.x, m_imageSpec.y );
 			const Box2i fileDataWindow( fileDataOrigin,
@@ -529,13 +635,13 @@ class File
 				if( !m_imageSpec.deep )
 				{
 					data.resize( subImageSpec.nchannels * fileDataRegion.size().x * fileDataRegion.size().y );
-					success = m_imageInput->read_scanlines(
+					success = imageInput->read_scanlines(
 						fileDataRegion.min.y, fileDataRegion.max.y, 0, TypeDesc::FLOAT, &data[0]
 					);
 				}
 				else
 				{
-					success = m_imageInput->read_native_deep_scanlines(
+					success = imageInput->read_native_deep_scanlines(
 						fileDataRegion.min.y, fileDataRegion.max.y, 0, 0, subImageSpec.nchannels, deepData
 					);
 				}
@@ -545,7 +651,7 @@ class File
 					throw IECore::Exception( boost::str (
 						boost::format( "OpenImageIOReader : Failed to read scanlines %i to %i.  Error: %s" ) %
 						fileDataRegion.min.y % fileDataRegion.max.y %
-						m_imageInput->geterror()
+						imageInput->geterror()
 					) );
 				}
 			}
@@ -570,14 +676,14 @@ class File
 				if( !m_imageSpec.deep )
 				{
 					data.resize( subImageSpec.nchannels * fileDataRegion.size().x * fileDataRegion.size().y );
-					success = m_imageInput->read_tiles (
+					success = imageInput->read_tiles (
 						fileDataRegion.min.x, fileDataRegion.max.x,
 						fileDataRegion.min.y, fileDataRegion.max.y, 0, 1, TypeDesc::FLOAT, &data[0]
 					);
 				}
 				else
 				{
-					success = m_imageInput->read_native_deep_tiles (
+					success = imageInput->read_native_deep_tiles (
 						fileDataRegion.min.x, fileDataRegion.max.x,
 						fileDataRegion.min.y, fileDataRegion.max.y, 0, 1, 0, subImageSpec.nchannels, deepData
 					);
@@ -590,7 +696,7 @@ class File
 						boost::format( "OpenImageIOReader : Failed to read tiles %i,%i to %i,%i.  Error: %s" ) %
 						fileDataRegion.min.x % fileDataRegion.min.y %
 						fileDataRegion.max.x % fileDataRegion.max.y %
-						m_imageInput->geterror()
+						imageInput->geterror()
 					) );
 				}
 			}
@@ -629,13 +735,18 @@ class File
 			return channelIndex * tilePlaneSize + subIndex.y * m_tileBatchSize.x + subIndex.x;
 		}
 
-		std::unique_ptr<ImageInput> m_imageInput;
+		const std::string m_fileName;
+		const std::string m_formatName;
 		ImageSpec m_imageSpec;
 		ConstStringVectorDataPtr m_channelNamesData;
 		std::map<std::string, ChannelMapEntry> m_channelMap;
 		Imath::V2i m_tileBatchSize;
-		tbb::mutex m_mutex;
 		bool m_tiled;
+
+		std::mutex m_imageInputsMutex;
+		std::condition_variable m_imageInputAvailable;
+		std::vector<std::unique_ptr<ImageInput>> m_idleImageInputs;
+		size_t m_numImageInputs;
 };
 
 
@@ -653,7 +764,10 @@ struct CacheEntry
 
 CacheEntry fileCacheGetter( const std::string &fileName, size_t &cost )
 {
-	cost = 1;
+	// Each File may hold up to `g_maxImageInputsPerFile` open handles, so
+	// we account for them all. This keeps the cache limit a bound on the
+	// number of open file handles rather than on the number of files.
+	cost = g_maxImageInputsPerFile;
 
 	CacheEntry result;
 
@@ -685,7 +799,9 @@ typedef IECorePreview::LRUCache<std::string, CacheEntry> FileHandleCache;
 
 FileHandleCache *fileCache()
 {
-	static FileHandleCache *c = new FileHandleCache( fileCacheGetter, 200 );
+	// Sized so that 200 files may remain open, as before each
+	// file could hold more than one handle.
+	static FileHandleCache *c = new FileHandleCache( fileCacheGetter, 200 * g_maxImageInputsPerFile );
 	return c;
 }
 
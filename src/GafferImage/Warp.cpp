@@ -56,6 +56,12 @@ namespace
 	static IECore::InternedString g_tileInputBoundName( "tileInputBound"  );
 	static IECore::InternedString g_pixelInputPositionsName( "pixelInputPositions"  );
 	static IECore::InternedString g_pixelInputDerivativesName( "pixelInputDerivatives"  );
+	static IECore::InternedString g_pixelFilterBoundsName( "pixelFilterBounds"  );
+	static IECore::InternedString g_pixelFilterWeightsName( "pixelFilterWeights"  );
+
+	// Limit on the average number of filter weights stored per pixel. Beyond
+	// this we don't store weights at all, and compute them on the fly instead.
+	const int g_maxFilterWeightsPerPixel = 64;
 
 	const CompoundObject *sampleRegionsEmptyTile()
 	{
@@ -72,6 +78,57 @@ namespace
 		}
 	}
 
+	// Computes the same filter weights as `FilterAlgo::sampleBox()`, storing them
+	// so that they may be reused for every channel. For each pixel we append
+	// the pixel bound of the filter support and an offset into `weights` to
+	// `bounds`. In `weights` we store the total weight followed by the x and y
+	// weights for the separable filter.
+	void appendFilterWeights( const V2f &p, float dx, float dy, const OIIO::Filter2D *filter, vector<int> &bounds, vector<float> &weights )
+	{
+		const float xscale = 1.0f / dx;
+		const float yscale = 1.0f / dy;
+
+		const Box2f support = FilterAlgo::filterSupport( p, dx, dy, filter->width() );
+		const Box2i pixelBounds(
+			V2i( (int)ceilf( support.min.x - 0.5 ), (int)ceilf( support.min.y - 0.5 ) ),
+			V2i( (int)floorf( support.max.x - 0.5 ) + 1, (int)floorf( support.max.y - 0.5 ) + 1 )
+		);
+
+		const int xWidth = pixelBounds.max.x - pixelBounds.min.x;
+		const int yWidth = pixelBounds.max.y - pixelBounds.min.y;
+
+		bounds.push_back( pixelBounds.min.x );
+		bounds.push_back( pixelBounds.min.y );
+		bounds.push_back( xWidth );
+		bounds.push_back( yWidth );
+		bounds.push_back( weights.size() );
+
+		const size_t totalIndex = weights.size();
+		weights.push_back( 0.0f );
+		for( int x = pixelBounds.min.x; x < pixelBounds.max.x; x++ )
+		{
+			weights.push_back( filter->xfilt( ( x + 0.5f - p.x ) * xscale ) );
+		}
+		for( int y = pixelBounds.min.y; y < pixelBounds.max.y; y++ )
+		{
+			weights.push_back( filter->yfilt( ( y + 0.5f - p.y ) * yscale ) );
+		}
+
+		// Accumulate the total in the same order as the sampling loop,
+		// so that our results are identical to `sampleBox()`.
+		const float *xWeights = &weights[totalIndex+1];
+		const float *yWeights = xWeights + xWidth;
+		float totalW = 0.0f;
+		for( int y = 0; y < yWidth; y++ )
+		{
+			for( int x = 0; x < xWidth; x++ )
+			{
+				totalW += xWeights[x] * yWeights[y];
+			}
+		}
+		weights[totalIndex] = totalW;
+	}
+
 	ConstObjectPtr computeEngineIfTileValid( ImagePlug::ChannelDataScope &tileScope, const ObjectPlug *plug, const Box2i &dataWindow, const V2i &tileOrigin )
 	{
 		if( BufferAlgo::intersects( dataWindow, Box2i( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) ) ) )
@@ -585,6 +642,36 @@ void Warp::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context )
 		sampleRegions->members()[ g_tileInputBoundName ] = new Box2iData( inputPixelBound );
 		sampleRegions->members()[ g_pixelInputPositionsName ] = pixelInputPositionsData;
 		sampleRegions->members()[ g_pixelInputDerivativesName ] = pixelInputDerivativesData;
+
+		// Evaluating the filter is a significant part of the cost of sampling,
+		// and doesn't depend on the channel being sampled. For separable filters,
+		// the weights are compact enough that we can compute them once here,
+		// and reuse them for every channel in computeChannelData().
+		if( filter->separable() )
+		{
+			IntVectorDataPtr pixelFilterBoundsData = new IntVectorData();
+			vector<int> &pixelFilterBounds = pixelFilterBoundsData->writable();
+			pixelFilterBounds.reserve( ImagePlug::tilePixels() * 5 );
+			FloatVectorDataPtr pixelFilterWeightsData = new FloatVectorData();
+			vector<float> &pixelFilterWeights = pixelFilterWeightsData->writable();
+
+			const size_t maxWeights = ImagePlug::tilePixels() * g_maxFilterWeightsPerPixel;
+			for( size_t i = 0; i < pixelInputPositions.size() && pixelFilterWeights.size() <= maxWeights; ++i )
+			{
+				if( pixelInputPositions[i] == Engine::black )
+				{
+					pixelFilterBounds.insert( pixelFilterBounds.end(), { 0, 0, 0, 0, 0 } );
+					continue;
+				}
+				appendFilterWeights( pixelInputPositions[i], pixelInputDerivatives[i].x, pixelInputDerivatives[i].y, filter, pixelFilterBounds, pixelFilterWeights );
+			}
+
+			if( pixelFilterWeights.size() <= maxWeights )
+			{
+				sampleRegions->members()[ g_pixelFilterBoundsName ] = pixelFilterBoundsData;
+				sampleRegions->members()[ g_pixelFilterWeightsName ] = pixelFilterWeightsData;
+			}
+		}
 		static_cast<CompoundObjectPlug *>( output )->setValue( sampleRegions );
 		return;
 	}
@@ -671,6 +758,52 @@ IECore::ConstFloatVectorDataPtr Warp::computeChannelData( const std::string &cha
 		(Sampler::BoundingMode)boundingModePlug()->getValue()
 	);
 
+	const IntVectorData *pixelFilterBoundsData = sampleRegions->member<IntVectorData>( g_pixelFilterBoundsName );
+	const FloatVectorData *pixelFilterWeightsData = sampleRegions->member<FloatVectorData>( g_pixelFilterWeightsName );
+	if( pixelFilterBoundsData && pixelFilterWeightsData )
+	{
+		// Fast path using the filter weights precomputed in `sampleRegionsPlug()`.
+		// This is equivalent to the `FilterAlgo::sampleBox()` call below, but
+		// without evaluating the filter.
+		const int *bounds = &pixelFilterBoundsData->readable().front();
+		const float *weights = pixelFilterWeightsData->readable().data();
+		int i = 0;
+		V2i oP;
+		for( oP.y = 0; oP.y < ImagePlug::tileSize(); ++oP.y )
+		{
+			for( oP.x = 0; oP.x < ImagePlug::tileSize(); ++oP.x, ++i, bounds += 5 )
+			{
+				float v = 0;
+				if( BufferAlgo::contains( validPixelsRelativeToTile , oP ) && pixelInputPositions[i] != Engine::black )
+				{
+					const int xMin = bounds[0];
+					const int yMin = bounds[1];
+					const int xWidth = bounds[2];
+					const int yWidth = bounds[3];
+					const float totalW = weights[bounds[4]];
+					const float *xWeights = weights + bounds[4] + 1;
+					const float *yWeights = xWeights + xWidth;
+
+					for( int y = 0; y < yWidth; ++y )
+					{
+						const float yWeight = yWeights[y];
+						for( int x = 0; x < xWidth; ++x )
+						{
+							v += xWeights[x] * yWeight * sampler.sample( xMin + x, yMin + y );
+						}
+					}
+
+					if( totalW != 0.0f )
+					{
+						v /= totalW;
+					}
+				}
+				result.push_back( v );
+			}
+		}
+		return resultData;
+	}
+
 	std::vector<float> scratchMemory;
 	int i = 0;
 	V2i oP;
@@ -181,6 +181,22 @@ IECore::FloatVectorDataPtr whiteTile( bool copy )
 	return copy ? d->copy() : boost::const_pointer_cast<IECore::FloatVectorData>( d );
 }
 
+IECore::FloatVectorDataPtr uniformTile( float value, bool copy )
+{
+	IECore::ConstFloatVectorDataPtr d = ImagePlug::uniformTile( value );
+	return copy ? d->copy() : boost::const_pointer_cast<IECore::FloatVectorData>( d );
+}
+
+object uniformTileValue( const IECore::FloatVectorData *tile )
+{
+	float value;
+	if( ImagePlug::uniformTileValue( tile, value ) )
+	{
+		return object( value );
+	}
+	return object();
+}
+
 boost::python::list registeredFormats()
 {
 	std::vector<std::string> names;
@@ -305,6 +321,8 @@ void GafferImageModule::bindCore()
 		.def( "emptyTile", &emptyTile, ( arg( "_copy" ) = true ) ).staticmethod( "emptyTile" )
 		.def( "blackTile", &blackTile, ( arg( "_copy" ) = true ) ).staticmethod( "blackTile" )
 		.def( "whiteTile", &whiteTile, ( arg( "_copy" ) = true ) ).staticmethod( "whiteTile" )
+		.def( "uniformTile", &uniformTile, ( arg( "value" ), arg( "_copy" ) = true ) ).staticmethod( "uniformTile" )
+		.def( "uniformTileValue", &uniformTileValue ).staticmethod( "uniformTileValue" )
 	;
 
 	typedef ComputeNodeWrapper<ImageNode> ImageNodeWrapper;
@@ -329,6 +329,20 @@ list nodesWithMetadata( GraphComponent *root, const std::string &key, bool insta
 	return result;
 }
 
+list plugValues( const GraphComponent &root, IECore::InternedString key, bool instanceOnly, bool copy )
+{
+	const Metadata::PlugValues values = Metadata::plugValues( &root, key, instanceOnly );
+	list result;
+	for( const auto &v : values )
+	{
+		result.append(
+			boost::python::make_tuple( PlugPtr( const_cast<Plug *>( v.first ) ), dataToPython( v.second.get(), copy ) )
+		);
+	}
+
+	return result;
+}
+
 } // namespace
 
 void GafferModule::bindMetadata()
@@ -401,6 +415,16 @@ void GafferModule::bindMetadata()
 		)
 		.staticmethod( "plugsWithMetadata" )
 
+		.def( "plugValues", &plugValues,
+			(
+				boost::python::arg( "root" ),
+				boost::python::arg( "key" ),
+				boost::python::arg( "instanceOnly" ) = false,
+				boost::python::arg( "_copy" ) = true
+			)
+		)
+		.staticmethod( "plugValues" )
+
 		.def( "nodesWithMetadata", &nodesWithMetadata,
 			(
 				boost::python::arg( "root" ),
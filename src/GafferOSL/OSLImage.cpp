@@ -41,6 +41,8 @@
 #include "GafferOSL/OSLShader.h"
 #include "GafferOSL/ShadingEngine.h"
 
+#include "GafferImage/BufferAlgo.h"
+
 #include "Gaffer/Context.h"
 #include "Gaffer/NameValuePlug.h"
 #include "Gaffer/ScriptNode.h"
@@ -48,7 +50,9 @@
 #include "Gaffer/UndoScope.h"
 
 #include "IECore/CompoundData.h"
+#include "IECore/CompoundObject.h"
 #include "IECore/MessageHandler.h"
+#include "IECore/ObjectVector.h"
 
 #include "boost/bind.hpp"
 
@@ -59,6 +63,62 @@ using namespace Gaffer;
 using namespace GafferImage;
 using namespace GafferOSL;
 
+//////////////////////////////////////////////////////////////////////////
+// Shading batches
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Shading a single tile gives the ShadingEngine too few points to
+// amortise its setup costs or to parallelise over, so we shade tiles
+// in horizontal batches. Batches are aligned to multiples of this many
+// tiles, and clipped to the tiles covered by the data window, so that
+// we never shade tiles outside it. The shadingPlug() is evaluated with
+// the tile origin set to the first tile in the batch.
+const int g_batchTiles = 16;
+
+int floorDivide( int a, int b )
+{
+	return a >= 0 ? a / b : ( a - b + 1 ) / b;
+}
+
+int batchStart( const V2i &tileOrigin )
+{
+	const int batchIndex = floorDivide( ImagePlug::tileIndex( tileOrigin ).x, g_batchTiles );
+	return batchIndex * g_batchTiles * ImagePlug::tileSize();
+}
+
+// Returns the origin of the first tile in the batch containing `tileOrigin`.
+V2i batchOrigin( const V2i &tileOrigin, const Box2i &dataWindow )
+{
+	return V2i(
+		std::max( batchStart( tileOrigin ), ImagePlug::tileOrigin( dataWindow.min ).x ),
+		tileOrigin.y
+	);
+}
+
+// Returns the x coordinate one past the end of the last tile in the
+// batch starting at `batchOrigin`.
+int batchEnd( const V2i &batchOrigin, const Box2i &dataWindow )
+{
+	return std::min(
+		batchStart( batchOrigin ) + g_batchTiles * ImagePlug::tileSize(),
+		ImagePlug::tileOrigin( dataWindow.max - V2i( 1 ) ).x + ImagePlug::tileSize()
+	);
+}
+
+bool tileInDataWindow( const V2i &tileOrigin, const Box2i &dataWindow )
+{
+	return BufferAlgo::intersects( dataWindow, Box2i( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) ) );
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// OSLImage
+//////////////////////////////////////////////////////////////////////////
+
 GAFFER_GRAPHCOMPONENT_DEFINE_TYPE( OSLImage );
 
 size_t OSLImage::g_firstPlugIndex = 0;
@@ -71,7 +131,7 @@ OSLImage::OSLImage( const std::string &name )
 	addChild( new GafferImage::FormatPlug( "defaultFormat" ) );
 	addChild( new GafferScene::ShaderPlug( "__shader", Plug::In, Plug::Default & ~Plug::Serialisable ) );
 
-	addChild( new Gaffer::ObjectPlug( "__shading", Gaffer::Plug::Out, new CompoundData() ) );
+	addChild( new Gaffer::ObjectPlug( "__shading", Gaffer::Plug::Out, new CompoundObject() ) );
 
 	addChild( new Plug( "channels", Plug::In, Plug::Default & ~Plug::AcceptsInputs ) );
 	addChild( new OSLCode( "__oslCode" ) );
@@ -187,6 +247,8 @@ void OSLImage::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outpu
 		input == defaultInPlug()->formatPlug() ||
 		input == inPlug()->channelNamesPlug() ||
 		input == inPlug()->channelDataPlug() ||
+		input == inPlug()->dataWindowPlug() ||
+		input == defaultInPlug()->dataWindowPlug() ||
 		input == inPlug()->deepPlug() ||
 		input == inPlug()->sampleOffsetsPlug()
 	)
@@ -258,6 +320,13 @@ Gaffer::ValuePlug::CachePolicy OSLImage::computeCachePolicy( const Gaffer::Value
 		// be cached. We don't want to count the memory usage for that twice.
 		return ValuePlug::CachePolicy::Uncached;
 	}
+	else if( output == shadingPlug() )
+	{
+		// Each batch is shared by many tiles, and the ShadingEngine
+		// shades it using TBB, so we want waiting threads to collaborate
+		// on the compute rather than shade the same batch redundantly.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
 
 	return ImageProcessor::computeCachePolicy( output );
 }
@@ -271,7 +340,8 @@ void OSLImage::hashChannelNames( const GafferImage::ImagePlug *output, const Gaf
 	if( !dataWindow.isEmpty() )
 	{
 		ImagePlug::ChannelDataScope channelDataScope( context );
-		channelDataScope.setTileOrigin( ImagePlug::tileOrigin( dataWindow.min ) );
+		channelDataScope.remove( ImagePlug::channelNameContextName );
+		channelDataScope.setTileOrigin( batchOrigin( ImagePlug::tileOrigin( dataWindow.min ), dataWindow ) );
 		shadingPlug()->hash( h );
 	}
 }
@@ -286,10 +356,11 @@ IECore::ConstStringVectorDataPtr OSLImage::computeChannelNames( const Gaffer::Co
 	if( !dataWindow.isEmpty() )
 	{
 		ImagePlug::ChannelDataScope channelDataScope( context );
-		channelDataScope.setTileOrigin( ImagePlug::tileOrigin( dataWindow.min ) );
+		channelDataScope.remove( ImagePlug::channelNameContextName );
+		channelDataScope.setTileOrigin( batchOrigin( ImagePlug::tileOrigin( dataWindow.min ), dataWindow ) );
 
-		ConstCompoundDataPtr shading = runTimeCast<const CompoundData>( shadingPlug()->getValue() );
-		for( CompoundDataMap::const_iterator it = shading->readable().begin(), eIt = shading->readable().end(); it != eIt; ++it )
+		ConstCompoundObjectPtr shading = runTimeCast<const CompoundObject>( shadingPlug()->getValue() );
+		for( CompoundObject::ObjectMap::const_iterator it = shading->members().begin(), eIt = shading->members().end(); it != eIt; ++it )
 		{
 			result.insert( it->first );
 		}
@@ -302,19 +373,48 @@ void OSLImage::hashChannelData( const GafferImage::ImagePlug *output, const Gaff
 {
 	ImageProcessor::hashChannelData( output, context, h );
 	const std::string &channelName = context->get<std::string>( ImagePlug::channelNameContextName );
-	h.append( channelName );
-	shadingPlug()->hash( h );
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 
 	ConstStringVectorDataPtr channelNamesData;
+	Box2i dataWindow;
+	bool deep;
 	{
 		ImagePlug::GlobalScope c( context );
 		channelNamesData = defaultedInPlug()->channelNamesPlug()->getValue();
+		dataWindow = defaultedInPlug()->dataWindowPlug()->getValue();
+		deep = defaultedInPlug()->deepPlug()->getValue();
 	}
 
-	if(
-		std::find( channelNamesData->readable().begin(), channelNamesData->readable().end(), channelName ) != 
+	const bool inputHasChannel =
+		std::find( channelNamesData->readable().begin(), channelNamesData->readable().end(), channelName ) !=
 		channelNamesData->readable().end()
-	)
+	;
+
+	if( !tileInDataWindow( tileOrigin, dataWindow ) )
+	{
+		// We don't shade tiles outside the data window.
+		if( inputHasChannel )
+		{
+			h = defaultedInPlug()->channelDataPlug()->hash();
+		}
+		else
+		{
+			h = deep ? ImagePlug::emptyTile()->Object::hash() : ImagePlug::blackTile()->Object::hash();
+		}
+		return;
+	}
+
+	h.append( channelName );
+	h.append( tileOrigin );
+
+	{
+		ImagePlug::ChannelDataScope c( context );
+		c.remove( ImagePlug::channelNameContextName );
+		c.setTileOrigin( batchOrigin( tileOrigin, dataWindow ) );
+		shadingPlug()->hash( h );
+	}
+
+	if( inputHasChannel )
 	{
 		defaultedInPlug()->channelDataPlug()->hash( h );
 	}
@@ -322,15 +422,48 @@ void OSLImage::hashChannelData( const GafferImage::ImagePlug *output, const Gaff
 
 IECore::ConstFloatVectorDataPtr OSLImage::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const GafferImage::ImagePlug *parent ) const
 {
-	ConstCompoundDataPtr shadedPoints = runTimeCast<const CompoundData>( shadingPlug()->getValue() );
-	ConstFloatVectorDataPtr result = shadedPoints->member<FloatVectorData>( channelName );
+	Box2i dataWindow;
+	{
+		ImagePlug::GlobalScope c( context );
+		dataWindow = defaultedInPlug()->dataWindowPlug()->getValue();
+	}
 
-	if( !result )
+	if( !tileInDataWindow( tileOrigin, dataWindow ) )
 	{
-		result = defaultedInPlug()->channelDataPlug()->getValue();
+		ConstStringVectorDataPtr channelNamesData;
+		bool deep;
+		{
+			ImagePlug::GlobalScope c( context );
+			channelNamesData = defaultedInPlug()->channelNamesPlug()->getValue();
+			deep = defaultedInPlug()->deepPlug()->getValue();
+		}
+
+		if(
+			std::find( channelNamesData->readable().begin(), channelNamesData->readable().end(), channelName ) !=
+			channelNamesData->readable().end()
+		)
+		{
+			return defaultedInPlug()->channelDataPlug()->getValue();
+		}
+		return deep ? ImagePlug::emptyTile() : ImagePlug::blackTile();
 	}
 
-	return result;
+	const V2i shadingOrigin = batchOrigin( tileOrigin, dataWindow );
+	ConstCompoundObjectPtr shading;
+	{
+		ImagePlug::ChannelDataScope c( context );
+		c.remove( ImagePlug::channelNameContextName );
+		c.setTileOrigin( shadingOrigin );
+		shading = runTimeCast<const CompoundObject>( shadingPlug()->getValue() );
+	}
+
+	if( const ObjectVector *tiles = shading->member<ObjectVector>( channelName ) )
+	{
+		const size_t tileIndex = ( tileOrigin.x - shadingOrigin.x ) / ImagePlug::tileSize();
+		return static_cast<const FloatVectorData *>( tiles->members()[tileIndex].get() );
+	}
+
+	return defaultedInPlug()->channelDataPlug()->getValue();
 }
 
 void OSLImage::hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -368,31 +501,41 @@ void OSLImage::hashShading( const Gaffer::Context *context, IECore::MurmurHash &
 		return;
 	}
 
-	h.append( context->get<V2i>( ImagePlug::tileOriginContextName ) );
+	const V2i batchOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 
 	ConstStringVectorDataPtr channelNamesData;
+	Box2i dataWindow;
 	bool deep;
 	{
 		ImagePlug::GlobalScope c( context );
 		defaultedInPlug()->formatPlug()->hash( h );
 		channelNamesData = defaultedInPlug()->channelNamesPlug()->getValue();
+		dataWindow = defaultedInPlug()->dataWindowPlug()->getValue();
 		deep = defaultedInPlug()->deepPlug()->getValue();
 	}
 
+	const int batchEnd = ::batchEnd( batchOrigin, dataWindow );
+	h.append( batchOrigin );
+	h.append( batchEnd );
+
 	{
 		ImagePlug::ChannelDataScope c( context );
-		if( deep )
+		for( V2i tileOrigin = batchOrigin; tileOrigin.x < batchEnd; tileOrigin.x += ImagePlug::tileSize() )
 		{
-			c.remove( ImagePlug::channelNameContextName );
-			defaultedInPlug()->sampleOffsetsPlug()->hash( h );
-		}
+			c.setTileOrigin( tileOrigin );
+			if( deep )
+			{
+				c.remove( ImagePlug::channelNameContextName );
+				defaultedInPlug()->sampleOffsetsPlug()->hash( h );
+			}
 
-		for( const auto &channelName : channelNamesData->readable() )
-		{
-			if( shadingEngine->needsAttribute( channelName ) )
+			for( const auto &channelName : channelNamesData->readable() )
 			{
-				c.setChannelName( channelName );
-				defaultedInPlug()->channelDataPlug()->hash( h );
+				if( shadingEngine->needsAttribute( channelName ) )
+				{
+					c.setChannelName( channelName );
+					defaultedInPlug()->channelDataPlug()->hash( h );
+				}
 			}
 		}
 	}
@@ -400,7 +543,7 @@ void OSLImage::hashShading( const Gaffer::Context *context, IECore::MurmurHash &
 	shadingEngine->hash( h );
 }
 
-IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *context ) const
+IECore::ConstCompoundObjectPtr OSLImage::computeShading( const Gaffer::Context *context ) const
 {
 	ConstShadingEnginePtr shadingEngine;
 	if( auto shader = runTimeCast<const OSLShader>( shaderPlug()->source()->node() ) )
@@ -411,46 +554,43 @@ IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *co
 
 	if( !shadingEngine )
 	{
-		return static_cast<const CompoundData *>( shadingPlug()->defaultValue() );
+		return static_cast<const CompoundObject *>( shadingPlug()->defaultValue() );
 	}
 
-	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	const V2i batchOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	Format format;
 	ConstStringVectorDataPtr channelNamesData;
+	Box2i dataWindow;
 	bool deep;
 	{
 		ImagePlug::GlobalScope c( context );
 		format = defaultedInPlug()->formatPlug()->getValue();
 		channelNamesData = defaultedInPlug()->channelNamesPlug()->getValue();
+		dataWindow = defaultedInPlug()->dataWindowPlug()->getValue();
 		deep = defaultedInPlug()->deepPlug()->getValue();
 	}
 
-	CompoundDataPtr shadingPoints = new CompoundData();
-	ConstIntVectorDataPtr sampleOffsetsData;
+	const int batchEnd = ::batchEnd( batchOrigin, dataWindow );
+	const size_t batchPixels = ( ( batchEnd - batchOrigin.x ) / ImagePlug::tileSize() ) * ImagePlug::tilePixels();
 
+	CompoundDataPtr shadingPoints = new CompoundData();
 
+	vector<FloatVectorDataPtr> channelPoints;
+	for( const auto &channelName : channelNamesData->readable() )
 	{
-		ImagePlug::ChannelDataScope c( context );
-		if( deep )
+		if( shadingEngine->needsAttribute( channelName ) )
 		{
-			c.remove( ImagePlug::channelNameContextName );
-			sampleOffsetsData = defaultedInPlug()->sampleOffsetsPlug()->getValue();
+			FloatVectorDataPtr channelData = new FloatVectorData;
+			channelData->writable().reserve( batchPixels );
+			shadingPoints->writable()[channelName] = channelData;
+			channelPoints.push_back( channelData );
 		}
-
-		for( const auto &channelName : channelNamesData->readable() )
+		else
 		{
-			if( shadingEngine->needsAttribute( channelName ) )
-			{
-				c.setChannelName( channelName );
-				shadingPoints->writable()[channelName] = boost::const_pointer_cast<FloatVectorData>(
-					defaultedInPlug()->channelDataPlug()->getValue()
-				);
-			}
+			channelPoints.push_back( nullptr );
 		}
 	}
 
-	int numSamples = sampleOffsetsData ? sampleOffsetsData->readable().back() : ImagePlug::tilePixels();
-
 	V3fVectorDataPtr pData = new V3fVectorData;
 	FloatVectorDataPtr uData = new FloatVectorData;
 	FloatVectorDataPtr vData = new FloatVectorData;
@@ -459,50 +599,83 @@ IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *co
 	vector<float> &uWritable = uData->writable();
 	vector<float> &vWritable = vData->writable();
 
-	pWritable.reserve( numSamples );
-	uWritable.reserve( numSamples );
-	vWritable.reserve( numSamples );
+	pWritable.reserve( batchPixels );
+	uWritable.reserve( batchPixels );
+	vWritable.reserve( batchPixels );
 
 	const V2f uvStep = V2f( 1.0f ) / format.getDisplayWindow().size();
 	// UV value for the pixel at 0,0
 	const V2f uvOrigin = (V2f(0.5) - format.getDisplayWindow().min) * uvStep;
-	const V2i pMax = tileOrigin + V2i( ImagePlug::tileSize() );
 
-	if( !deep )
+	// The points for each tile are stored contiguously, with
+	// `tileOffsets[i]` holding the index of the first point of tile `i`.
+	vector<size_t> tileOffsets( 1, 0 );
+
 	{
-		V2i p;
-		for( p.y = tileOrigin.y; p.y < pMax.y; ++p.y )
+		ImagePlug::ChannelDataScope c( context );
+		for( V2i tileOrigin = batchOrigin; tileOrigin.x < batchEnd; tileOrigin.x += ImagePlug::tileSize() )
 		{
-			const float v = uvOrigin.y + p.y * uvStep.y;
-			for( p.x = tileOrigin.x; p.x < pMax.x; ++p.x )
+			c.setTileOrigin( tileOrigin );
+
+			ConstIntVectorDataPtr sampleOffsetsData;
+			if( deep )
 			{
-				uWritable.push_back( uvOrigin.x + p.x * uvStep.x );
-				vWritable.push_back( v );
-				pWritable.push_back( V3f( p.x + 0.5f, p.y + 0.5f, 0.0f ) );
+				c.remove( ImagePlug::channelNameContextName );
+				sampleOffsetsData = defaultedInPlug()->sampleOffsetsPlug()->getValue();
 			}
-		}
-	}
-	else
-	{
-		const std::vector< int > &sampleOffsets = sampleOffsetsData->readable();
-		int prevOffset = 0;
-		int index = 0;
-		V2i p;
-		for( p.y = tileOrigin.y; p.y < pMax.y; ++p.y )
-		{
-			const float v = uvOrigin.y + p.y * uvStep.y;
-			for( p.x = tileOrigin.x; p.x < pMax.x; ++p.x )
+
+			for( size_t i = 0, e = channelNamesData->readable().size(); i < e; ++i )
+			{
+				if( channelPoints[i] )
+				{
+					c.setChannelName( channelNamesData->readable()[i] );
+					ConstFloatVectorDataPtr tileData = defaultedInPlug()->channelDataPlug()->getValue();
+					vector<float> &points = channelPoints[i]->writable();
+					points.insert( points.end(), tileData->readable().begin(), tileData->readable().end() );
+				}
+			}
+
+			const V2i pMax = tileOrigin + V2i( ImagePlug::tileSize() );
+
+			if( !deep )
+			{
+				V2i p;
+				for( p.y = tileOrigin.y; p.y < pMax.y; ++p.y )
+				{
+					const float v = uvOrigin.y + p.y * uvStep.y;
+					for( p.x = tileOrigin.x; p.x < pMax.x; ++p.x )
+					{
+						uWritable.push_back( uvOrigin.x + p.x * uvStep.x );
+						vWritable.push_back( v );
+						pWritable.push_back( V3f( p.x + 0.5f, p.y + 0.5f, 0.0f ) );
+					}
+				}
+			}
+			else
 			{
-				int offset = sampleOffsets[index];
-				for( int j = 0; j < offset - prevOffset; j++ )
+				const std::vector< int > &sampleOffsets = sampleOffsetsData->readable();
+				int prevOffset = 0;
+				int index = 0;
+				V2i p;
+				for( p.y = tileOrigin.y; p.y < pMax.y; ++p.y )
 				{
-					uWritable.push_back( uvOrigin.x + p.x * uvStep.x );
-					vWritable.push_back( v );
-					pWritable.push_back( V3f( p.x + 0.5f, p.y + 0.5f, j ) );
+					const float v = uvOrigin.y + p.y * uvStep.y;
+					for( p.x = tileOrigin.x; p.x < pMax.x; ++p.x )
+					{
+						int offset = sampleOffsets[index];
+						for( int j = 0; j < offset - prevOffset; j++ )
+						{
+							uWritable.push_back( uvOrigin.x + p.x * uvStep.x );
+							vWritable.push_back( v );
+							pWritable.push_back( V3f( p.x + 0.5f, p.y + 0.5f, j ) );
+						}
+						prevOffset = offset;
+						index++;
+					}
 				}
-				prevOffset = offset;
-				index++;
 			}
+
+			tileOffsets.push_back( pWritable.size() );
 		}
 	}
 
@@ -510,18 +683,36 @@ IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *co
 	shadingPoints->writable()["u"] = uData;
 	shadingPoints->writable()["v"] = vData;
 
+	CompoundDataPtr shadedPoints = shadingEngine->shade( shadingPoints.get() );
 
-	CompoundDataPtr result = shadingEngine->shade( shadingPoints.get() );
-
-	// remove results that aren't suitable to become channels
-	for( CompoundDataMap::iterator it = result->writable().begin(); it != result->writable().end();  )
+	// Split the results into individual tiles, so that computeChannelData()
+	// can return them without copying. Results that aren't suitable to become
+	// channels are discarded.
+	CompoundObjectPtr result = new CompoundObject;
+	for( const auto &shadedPoint : shadedPoints->readable() )
 	{
-		CompoundDataMap::iterator nextIt = it; nextIt++;
-		if( !runTimeCast<FloatVectorData>( it->second ) )
+		FloatVectorData *channelData = runTimeCast<FloatVectorData>( shadedPoint.second.get() );
+		if( !channelData )
+		{
+			continue;
+		}
+
+		ObjectVectorPtr tiles = new ObjectVector;
+		if( tileOffsets.size() == 2 )
+		{
+			tiles->members().push_back( channelData );
+		}
+		else
 		{
-			result->writable().erase( it );
+			const vector<float> &channel = channelData->readable();
+			for( size_t i = 0; i < tileOffsets.size() - 1; ++i )
+			{
+				tiles->members().push_back(
+					new FloatVectorData( vector<float>( channel.begin() + tileOffsets[i], channel.begin() + tileOffsets[i+1] ) )
+				);
+			}
 		}
-		it = nextIt;
+		result->members()[shadedPoint.first] = tiles;
 	}
 
 	return result;
@@ -37,14 +37,20 @@
 #include "GafferOSL/OSLShader.h"
 
 #include "GafferOSL/ClosurePlug.h"
+#include "GafferOSL/OSLImage.h"
+#include "GafferOSL/OSLObject.h"
 #include "GafferOSL/ShadingEngine.h"
 
 #include "GafferScene/RendererAlgo.h"
+#include "GafferScene/ShaderPlug.h"
 
+#include "Gaffer/BackgroundTask.h"
 #include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/Metadata.h"
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/ParallelAlgo.h"
 #include "Gaffer/PlugAlgo.h"
+#include "Gaffer/ScriptNode.h"
 #include "Gaffer/SplinePlug.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/Private/IECorePreview/LRUCache.h"
@@ -60,6 +66,7 @@
 #include "boost/algorithm/string/predicate.hpp"
 
 #include "tbb/mutex.h"
+#include "tbb/parallel_for_each.h"
 
 using namespace std;
 using namespace Imath;
@@ -179,6 +186,61 @@ ConstShadingEnginePtr OSLShader::shadingEngine() const
 	return g_shadingEngineCache.get( ShadingEngineCacheGetterKey( this ) );
 }
 
+std::unique_ptr<Gaffer::BackgroundTask> OSLShader::prewarmShadingEngines( const Gaffer::ScriptNode *script )
+{
+	// Find the shaders on the calling thread, since it isn't
+	// safe to traverse the graph concurrently with edits.
+	std::vector<ConstOSLShaderPtr> shaders;
+	for( RecursiveNodeIterator it( script ); !it.done(); ++it )
+	{
+		if( !runTimeCast<const OSLObject>( it->get() ) && !runTimeCast<const OSLImage>( it->get() ) )
+		{
+			continue;
+		}
+		for( PlugIterator plugIt( it->get() ); !plugIt.done(); ++plugIt )
+		{
+			const ShaderPlug *shaderPlug = runTimeCast<const ShaderPlug>( plugIt->get() );
+			if( !shaderPlug || !shaderPlug->getInput() )
+			{
+				continue;
+			}
+			if( auto shader = runTimeCast<const OSLShader>( shaderPlug->source()->node() ) )
+			{
+				shaders.push_back( shader );
+			}
+		}
+	}
+
+	Context::Scope scriptContextScope( script->context() );
+	return ParallelAlgo::callOnBackgroundThread(
+		script->fileNamePlug(),
+		[shaders] {
+			const ThreadState &threadState = ThreadState::current();
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for_each(
+				shaders.begin(), shaders.end(),
+				[&threadState] ( const ConstOSLShaderPtr &shader ) {
+					ThreadState::Scope threadStateScope( threadState );
+					try
+					{
+						shader->shadingEngine();
+					}
+					catch( const IECore::Cancelled & )
+					{
+						throw;
+					}
+					catch( ... )
+					{
+						// Errors will be reported when the
+						// network is used for real.
+					}
+				},
+				taskGroupContext
+			);
+		}
+	);
+}
+
 bool OSLShader::acceptsInput( const Plug *plug, const Plug *inputPlug ) const
 {
 	if( !Shader::acceptsInput( plug, inputPlug ) )
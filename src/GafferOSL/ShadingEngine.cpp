@@ -701,6 +701,36 @@ class ShadingResults
 			addResult( pointIndex, result, Color3f( 1.0f ), threadCache );
 		}
 
+		// Copies the results for the first point to all the others.
+		void broadcastFirstPoint()
+		{
+			if( m_ci->size() < 2 )
+			{
+				return;
+			}
+
+			std::fill( m_ci->begin() + 1, m_ci->end(), m_ci->front() );
+
+			for( const auto &debugResult : m_debugResults )
+			{
+				const DebugResult &r = debugResult.second;
+				if( r.type.basetype == TypeDesc::STRING )
+				{
+					std::string *strings = static_cast<std::string *>( r.basePointer );
+					std::fill( strings + 1, strings + m_ci->size(), strings[0] );
+				}
+				else
+				{
+					const size_t elementSize = r.type.elementsize();
+					char *data = static_cast<char *>( r.basePointer );
+					for( size_t i = 1, e = m_ci->size(); i < e; ++i )
+					{
+						memcpy( data + i * elementSize, data, elementSize );
+					}
+				}
+			}
+		}
+
 		CompoundDataPtr results()
 		{
 			return m_results;
@@ -1266,6 +1296,16 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 		}
 	};
 
+	if( !varyingInputsNeeded( points ) )
+	{
+		// The shader reads nothing that varies from point to point,
+		// so every point will have the same result. Shade just one and
+		// copy its result to the rest.
+		f( tbb::blocked_range<size_t>( 0, std::min<size_t>( numPoints, 1 ) ) );
+		results.broadcastFirstPoint();
+		return results.results();
+	}
+
 	// Use `task_group_context::isolated` to prevent TBB cancellation in outer
 	// tasks from propagating down and stopping our tasks from being started.
 	// Otherwise we silently return results with black gaps where tasks were omitted.
@@ -1275,6 +1315,43 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 	return results.results();
 }
 
+bool ShadingEngine::varyingInputsNeeded( const IECore::CompoundData *points ) const
+{
+	if( m_unknownAttributesNeeded )
+	{
+		return true;
+	}
+
+	for( const auto &name : m_attributesNeeded )
+	{
+		if( name == gIndex.string() )
+		{
+			return true;
+		}
+		else if( name == "u" || name == "v" )
+		{
+			// May be provided via "uv".
+			if( points->member<V2fVectorData>( "uv" ) )
+			{
+				return true;
+			}
+		}
+
+		const Data *data = points->member<Data>( name );
+		if( !data )
+		{
+			continue;
+		}
+
+		if( IECoreImage::OpenImageIOAlgo::DataView( data ).type.arraylen )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 bool ShadingEngine::needsAttribute( const std::string &name ) const
 {
 	if( name == "P" )
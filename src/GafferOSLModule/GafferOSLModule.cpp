@@ -50,7 +50,9 @@
 #include "GafferBindings/PlugBinding.h"
 #include "GafferBindings/SignalBinding.h"
 
+#include "Gaffer/BackgroundTask.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/ScriptNode.h"
 
 #include "IECorePython/IECoreBinding.h"
 #include "IECorePython/ScopedGILRelease.h"
@@ -74,6 +76,20 @@ object parameterMetadata( const OSLShader &s, const Gaffer::Plug *plug, const ch
 	return dataToPython( s.parameterMetadata( plug, key ), copy );
 }
 
+std::shared_ptr<Gaffer::BackgroundTask> prewarmShadingEngines( const Gaffer::ScriptNode &script )
+{
+	return std::shared_ptr<Gaffer::BackgroundTask>(
+		OSLShader::prewarmShadingEngines( &script ).release(),
+		// Custom deleter. We need to release the GIL when deleting,
+		// because the destructor waits on the background task, and
+		// the task might need the GIL to evaluate expressions.
+		[]( Gaffer::BackgroundTask *t ) {
+			IECorePython::ScopedGILRelease gilRelease;
+			delete t;
+		}
+	);
+}
+
 int oslLibraryVersionMajor()
 {
 	return OSL_LIBRARY_VERSION_MAJOR;
@@ -161,6 +177,7 @@ BOOST_PYTHON_MODULE( _GafferOSL )
 	GafferBindings::DependencyNodeClass<OSLShader>()
 		.def( "shaderMetadata", &shaderMetadata, ( boost::python::arg_( "_copy" ) = true ) )
 		.def( "parameterMetadata", &parameterMetadata, ( boost::python::arg_( "plug" ), boost::python::arg_( "_copy" ) = true ) )
+		.def( "prewarmShadingEngines", &prewarmShadingEngines ).staticmethod( "prewarmShadingEngines" )
 	;
 
 	GafferBindings::DependencyNodeClass<OSLImage>();
@@ -0,0 +1,468 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/IECoreGLPreview/BoundingVolumeHierarchy.h"
+
+#include "OpenEXR/ImathVec.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace Imath;
+using namespace IECoreGLPreview;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const size_t g_invalidIndex = std::numeric_limits<size_t>::max();
+const size_t g_maxLeafItems = 4;
+
+enum class Containment
+{
+	Outside,
+	Intersecting,
+	Inside
+};
+
+Containment containment( const Box3f &box, const BoundingVolumeHierarchy::Planes &planes )
+{
+	Containment result = Containment::Inside;
+	for( const auto &plane : planes )
+	{
+		const V3f &n = plane.normal;
+		const V3f nearest(
+			n.x >= 0 ? box.max.x : box.min.x,
+			n.y >= 0 ? box.max.y : box.min.y,
+			n.z >= 0 ? box.max.z : box.min.z
+		);
+		if( plane.distanceTo( nearest ) < 0 )
+		{
+			return Containment::Outside;
+		}
+
+		const V3f farthest(
+			n.x >= 0 ? box.min.x : box.max.x,
+			n.y >= 0 ? box.min.y : box.max.y,
+			n.z >= 0 ? box.min.z : box.max.z
+		);
+		if( plane.distanceTo( farthest ) < 0 )
+		{
+			result = Containment::Intersecting;
+		}
+	}
+	return result;
+}
+
+void appendPlane( const V4f &p, BoundingVolumeHierarchy::Planes &planes )
+{
+	const V3f normal( p.x, p.y, p.z );
+	const float length = normal.length();
+	if( length > 0 )
+	{
+		planes.push_back( Plane3f( normal / length, -p.w / length ) );
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// BoundingVolumeHierarchy
+//////////////////////////////////////////////////////////////////////////
+
+BoundingVolumeHierarchy::Statistics::Statistics()
+	:	items( 0 ), itemsReturned( 0 ), itemsTested( 0 ), nodesTested( 0 )
+{
+}
+
+BoundingVolumeHierarchy::Item::Item()
+	:	leaf( g_invalidIndex ), state( State::Absent ), pendingListed( false ), unboundedListed( false )
+{
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+	:	m_size( 0 ), m_treeSize( 0 ), m_staleLeafItems( 0 )
+{
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+}
+
+void BoundingVolumeHierarchy::set( size_t id, const Imath::Box3f &bound )
+{
+	if( id >= m_items.size() )
+	{
+		m_items.resize( id + 1 );
+	}
+
+	Item &item = m_items[id];
+	if( item.state == State::Absent )
+	{
+		m_size++;
+	}
+
+	item.bound = bound;
+
+	if( bound.isEmpty() )
+	{
+		if( item.state == State::Tree )
+		{
+			removeFromTree( id );
+		}
+		item.state = State::Unbounded;
+		if( !item.unboundedListed )
+		{
+			m_unbounded.push_back( id );
+			item.unboundedListed = true;
+		}
+		return;
+	}
+
+	if( item.state == State::Tree )
+	{
+		// Bound edits are cheap, so that objects can be moved
+		// interactively without the tree being rebuilt.
+		refit( item.leaf );
+		return;
+	}
+
+	item.state = State::Pending;
+	if( !item.pendingListed )
+	{
+		m_pending.push_back( id );
+		item.pendingListed = true;
+	}
+}
+
+void BoundingVolumeHierarchy::remove( size_t id )
+{
+	if( id >= m_items.size() || m_items[id].state == State::Absent )
+	{
+		return;
+	}
+
+	if( m_items[id].state == State::Tree )
+	{
+		removeFromTree( id );
+	}
+	m_items[id].state = State::Absent;
+	m_size--;
+}
+
+void BoundingVolumeHierarchy::clear()
+{
+	m_items.clear();
+	m_nodes.clear();
+	m_leafItems.clear();
+	m_pending.clear();
+	m_unbounded.clear();
+	m_size = m_treeSize = m_staleLeafItems = 0;
+}
+
+size_t BoundingVolumeHierarchy::size() const
+{
+	return m_size;
+}
+
+BoundingVolumeHierarchy::Planes BoundingVolumeHierarchy::frustumPlanes( const Imath::M44f &worldToClip, const Imath::Box2f &region )
+{
+	// Clip coordinates are given by `p * worldToClip`, so each coordinate
+	// is the dot product of `p` with one column of the matrix. A point is
+	// inside the volume if `x / w` and `y / w` are within `region` and `z / w`
+	// is within `[-1, 1]`, which we rearrange into plane equations.
+
+	const M44f &m = worldToClip;
+	const V4f x( m[0][0], m[1][0], m[2][0], m[3][0] );
+	const V4f y( m[0][1], m[1][1], m[2][1], m[3][1] );
+	const V4f z( m[0][2], m[1][2], m[2][2], m[3][2] );
+	const V4f w( m[0][3], m[1][3], m[2][3], m[3][3] );
+
+	Planes result;
+	appendPlane( x - w * region.min.x, result );
+	appendPlane( w * region.max.x - x, result );
+	appendPlane( y - w * region.min.y, result );
+	appendPlane( w * region.max.y - y, result );
+	appendPlane( z + w, result );
+	appendPlane( w - z, result );
+
+	return result;
+}
+
+void BoundingVolumeHierarchy::query( const Planes &planes, std::vector<size_t> &ids, Statistics *statistics )
+{
+	update();
+
+	ids.clear();
+	Statistics s;
+	s.items = m_size;
+
+	if( !m_nodes.empty() )
+	{
+		queryWalk( planes, ids, s );
+	}
+
+	for( auto id : m_pending )
+	{
+		s.itemsTested++;
+		if( containment( m_items[id].bound, planes ) != Containment::Outside )
+		{
+			ids.push_back( id );
+		}
+	}
+
+	ids.insert( ids.end(), m_unbounded.begin(), m_unbounded.end() );
+
+	std::sort( ids.begin(), ids.end() );
+	s.itemsReturned = ids.size();
+	if( statistics )
+	{
+		*statistics = s;
+	}
+}
+
+void BoundingVolumeHierarchy::update()
+{
+	// Remove list entries for items which have since changed state.
+
+	auto compact = [this]( std::vector<size_t> &list, State state, bool Item::*listed ) {
+		list.erase(
+			std::remove_if(
+				list.begin(), list.end(),
+				[this, state, listed]( size_t id ) {
+					Item &item = m_items[id];
+					if( item.state != state )
+					{
+						item.*listed = false;
+						return true;
+					}
+					return false;
+				}
+			),
+			list.end()
+		);
+	};
+
+	compact( m_pending, State::Pending, &Item::pendingListed );
+	compact( m_unbounded, State::Unbounded, &Item::unboundedListed );
+
+	// Pending items must be tested individually by every query, and stale
+	// leaf items waste time during traversal. Rebuild once either is
+	// significant relative to the size of the tree.
+
+	if( m_pending.size() > 32 + m_treeSize / 16 || m_staleLeafItems > 32 + m_treeSize / 4 )
+	{
+		build();
+	}
+}
+
+void BoundingVolumeHierarchy::build()
+{
+	std::vector<BuildItem> buildItems;
+	buildItems.reserve( m_size );
+	for( size_t id = 0, e = m_items.size(); id < e; ++id )
+	{
+		Item &item = m_items[id];
+		if( item.state == State::Tree || item.state == State::Pending )
+		{
+			item.state = State::Tree;
+			item.pendingListed = false;
+			buildItems.push_back( { item.bound, item.bound.center(), id } );
+		}
+	}
+
+	m_pending.clear();
+	m_nodes.clear();
+	m_leafItems.clear();
+	m_treeSize = buildItems.size();
+	m_staleLeafItems = 0;
+
+	if( !buildItems.empty() )
+	{
+		m_nodes.reserve( 2 * ( buildItems.size() / g_maxLeafItems + 1 ) );
+		m_leafItems.reserve( buildItems.size() );
+		buildWalk( buildItems.begin(), buildItems.end(), g_invalidIndex );
+	}
+}
+
+size_t BoundingVolumeHierarchy::buildWalk( std::vector<BuildItem>::iterator begin, std::vector<BuildItem>::iterator end, size_t parent )
+{
+	const size_t index = m_nodes.size();
+	m_nodes.push_back( Node() );
+
+	Box3f bound;
+	Box3f centroidBound;
+	for( auto it = begin; it != end; ++it )
+	{
+		bound.extendBy( it->bound );
+		centroidBound.extendBy( it->centroid );
+	}
+
+	Node &node = m_nodes[index];
+	node.bound = bound;
+	node.parent = parent;
+
+	const size_t count = end - begin;
+	if( count <= g_maxLeafItems )
+	{
+		node.first = m_leafItems.size();
+		node.count = count;
+		for( auto it = begin; it != end; ++it )
+		{
+			m_items[it->id].leaf = index;
+			m_leafItems.push_back( it->id );
+		}
+		return index;
+	}
+
+	// Split at the median centroid on the longest axis. If all the
+	// centroids coincide, any split is as good as another.
+
+	auto mid = begin + count / 2;
+	if( centroidBound.min != centroidBound.max )
+	{
+		const int axis = centroidBound.majorAxis();
+		std::nth_element(
+			begin, mid, end,
+			[axis]( const BuildItem &a, const BuildItem &b ) {
+				return a.centroid[axis] < b.centroid[axis];
+			}
+		);
+	}
+
+	// The first child immediately follows us, so we only need
+	// to store the index of the second.
+	buildWalk( begin, mid, index );
+	const size_t second = buildWalk( mid, end, index );
+
+	m_nodes[index].first = second;
+	m_nodes[index].count = 0;
+	return index;
+}
+
+void BoundingVolumeHierarchy::removeFromTree( size_t id )
+{
+	Item &item = m_items[id];
+	item.state = State::Absent;
+	m_treeSize--;
+	m_staleLeafItems++;
+	refit( item.leaf );
+}
+
+void BoundingVolumeHierarchy::refit( size_t leaf )
+{
+	const Node &leafNode = m_nodes[leaf];
+	Box3f bound;
+	for( size_t i = leafNode.first, e = leafNode.first + leafNode.count; i < e; ++i )
+	{
+		const Item &item = m_items[m_leafItems[i]];
+		if( item.state == State::Tree && item.leaf == leaf )
+		{
+			bound.extendBy( item.bound );
+		}
+	}
+	m_nodes[leaf].bound = bound;
+
+	for( size_t n = leafNode.parent; n != g_invalidIndex; n = m_nodes[n].parent )
+	{
+		Node &node = m_nodes[n];
+		node.bound = m_nodes[n+1].bound;
+		node.bound.extendBy( m_nodes[node.first].bound );
+	}
+}
+
+void BoundingVolumeHierarchy::queryWalk( const Planes &planes, std::vector<size_t> &ids, Statistics &statistics ) const
+{
+	// Nodes to visit, along with a flag specifying that they
+	// are known to be entirely inside the volume.
+	std::vector<std::pair<size_t, bool>> stack;
+	stack.push_back( std::make_pair( 0, false ) );
+
+	while( !stack.empty() )
+	{
+		const size_t index = stack.back().first;
+		bool inside = stack.back().second;
+		stack.pop_back();
+
+		const Node &node = m_nodes[index];
+		if( node.bound.isEmpty() )
+		{
+			continue;
+		}
+
+		if( !inside )
+		{
+			statistics.nodesTested++;
+			const Containment c = containment( node.bound, planes );
+			if( c == Containment::Outside )
+			{
+				continue;
+			}
+			inside = c == Containment::Inside;
+		}
+
+		if( node.count )
+		{
+			for( size_t i = node.first, e = node.first + node.count; i < e; ++i )
+			{
+				const size_t id = m_leafItems[i];
+				const Item &item = m_items[id];
+				if( item.state != State::Tree || item.leaf != index )
+				{
+					continue;
+				}
+				if( !inside )
+				{
+					statistics.itemsTested++;
+					if( containment( item.bound, planes ) == Containment::Outside )
+					{
+						continue;
+					}
+				}
+				ids.push_back( id );
+			}
+		}
+		else
+		{
+			stack.push_back( std::make_pair( node.first, inside ) );
+			stack.push_back( std::make_pair( index + 1, inside ) );
+		}
+	}
+}
@@ -37,6 +37,7 @@
 #include "GafferScene/Private/IECoreScenePreview/Renderer.h"
 
 #include "GafferScene/Private/IECoreGLPreview/AttributeVisualiser.h"
+#include "GafferScene/Private/IECoreGLPreview/BoundingVolumeHierarchy.h"
 #include "GafferScene/Private/IECoreGLPreview/LightVisualiser.h"
 #include "GafferScene/Private/IECoreGLPreview/LightFilterVisualiser.h"
 #include "GafferScene/Private/IECoreGLPreview/ObjectVisualiser.h"
@@ -50,20 +51,25 @@
 #include "IECoreGL/FrameBuffer.h"
 #include "IECoreGL/GL.h"
 #include "IECoreGL/Group.h"
+#include "IECoreGL/MeshPrimitive.h"
 #include "IECoreGL/PointsPrimitive.h"
 #include "IECoreGL/Primitive.h"
 #include "IECoreGL/Renderable.h"
 #include "IECoreGL/Selector.h"
+#include "IECoreGL/Shader.h"
+#include "IECoreGL/ShaderLoader.h"
 #include "IECoreGL/ShaderStateComponent.h"
 #include "IECoreGL/State.h"
 #include "IECoreGL/ToGLCameraConverter.h"
 #include "IECoreGL/IECoreGL.h"
 
+#include "IECore/CompoundData.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/PathMatcherData.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/StringAlgo.h"
+#include "IECore/VectorTypedData.h"
 #include "IECore/Writer.h"
 
 #include "OpenEXR/ImathBoxAlgo.h"
@@ -71,10 +77,13 @@
 
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/format.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "tbb/concurrent_queue.h"
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 
@@ -91,6 +100,9 @@ using namespace IECoreGLPreview;
 
 namespace
 {
+
+const size_t g_invalidIndex = std::numeric_limits<size_t>::max();
+
 class ScopedTransform
 {
 	public:
@@ -148,13 +160,13 @@ void renderMatchingVisualisations( Visualisation::Scale scale, Visualisation::Ca
 }
 
 template <class... Vs>
-void accumulateVisualisationBounds( Box3f &target, Visualisation::Scale scale, Visualisation::Category category, const M44f &transform, const Vs & ... visualisations )
+void accumulateVisualisationBounds( Box3f &target, Visualisation::Scale scale, Visualisation::Category category, const M44f &transform, bool framingOnly, const Vs & ... visualisations )
 {
 	for( auto vs : { visualisations... } )
 	{
 		for( auto v : vs )
 		{
-			if( !v.affectsFramingBound || v.scale != scale || !(v.category & category) )
+			if( ( framingOnly && !v.affectsFramingBound ) || v.scale != scale || !(v.category & category) )
 			{
 				continue;
 			}
@@ -213,6 +225,82 @@ const IECoreGL::State &selectionState()
 	return *s;
 }
 
+// State used to draw the wireframe bounding boxes which replace the
+// objects in batches exceeding the bounding box threshold.
+const IECoreGL::State &boundingBoxState()
+{
+	static IECoreGL::StatePtr s;
+	if( !s )
+	{
+		s = new IECoreGL::State( false );
+		s->add( new IECoreGL::CurvesPrimitive::UseGLLines( true ) );
+	}
+	return *s;
+}
+
+// Vertex shader used to draw batches of meshes with a single instanced
+// draw call. This matches the default IECoreGL vertex shader, except that
+// each instance is transformed by a matrix provided as four per-instance
+// attributes, holding the rows of the object's transform.
+const std::string &instancingVertexSource()
+{
+	static const std::string s =
+		"#version 120\n"
+		""
+		"#if __VERSION__ <= 120\n"
+		"#define in attribute\n"
+		"#define out varying\n"
+		"#endif\n"
+		""
+		"uniform vec3 Cs = vec3( 1, 1, 1 );\n"
+		"uniform bool vertexCsActive = false;\n"
+		""
+		"in vec3 vertexP;\n"
+		"in vec3 vertexN;\n"
+		"in vec2 vertexuv;\n"
+		"in vec3 vertexCs;\n"
+		""
+		"in vec3 instanceX;\n"
+		"in vec3 instanceY;\n"
+		"in vec3 instanceZ;\n"
+		"in vec3 instanceP;\n"
+		""
+		"out vec3 fragmentI;\n"
+		"out vec3 fragmentP;\n"
+		"out vec3 fragmentN;\n"
+		"out vec2 fragmentuv;\n"
+		"out vec3 fragmentCs;\n"
+		""
+		"void main()\n"
+		"{\n"
+		"	mat4 instanceMatrix = mat4( vec4( instanceX, 0 ), vec4( instanceY, 0 ), vec4( instanceZ, 0 ), vec4( instanceP, 1 ) );\n"
+		"	vec4 pCam = gl_ModelViewMatrix * instanceMatrix * vec4( vertexP, 1 );\n"
+		"	gl_Position = gl_ProjectionMatrix * pCam;\n"
+		"	fragmentP = pCam.xyz;\n"
+		// GLSL 1.20 has no `inverse()`, so normals are only exact for
+		// instances without non-uniform scaling. This is good enough
+		// for the facing ratio shading they are used for.
+		"	fragmentN = normalize( gl_NormalMatrix * mat3( instanceX, instanceY, instanceZ ) * vertexN );\n"
+		"	if( gl_ProjectionMatrix[2][3] != 0.0 )\n"
+		"	{\n"
+		"		fragmentI = normalize( -pCam.xyz );\n"
+		"	}\n"
+		"	else\n"
+		"	{\n"
+		"		fragmentI = vec3( 0, 0, -1 );\n"
+		"	}\n"
+		"	fragmentuv = vertexuv;\n"
+		"	fragmentCs = mix( Cs, vertexCs, float( vertexCsActive ) );\n"
+		"}\n"
+	;
+	return s;
+}
+
+bool isDefaultSource( const std::string &source, const std::string &defaultSource )
+{
+	return source.empty() || source == defaultSource;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -344,15 +432,22 @@ namespace
 typedef std::function<void ()> Edit;
 typedef tbb::concurrent_queue<Edit> EditQueue;
 
+class OpenGLObject;
+// Objects whose bounds have been changed by Edits, and which must
+// therefore be updated in the renderer's BoundingVolumeHierarchy.
+typedef std::vector<OpenGLObject *> DirtyBounds;
+
 class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 {
 
 	public :
 
-		OpenGLObject( const std::string &name, const IECore::Object *object, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue )
+		OpenGLObject( const std::string &name, const IECore::Object *object, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue, DirtyBounds &dirtyBounds )
 			:	m_objectType( object ? object->typeId() : IECore::NullObjectTypeId ),
 				m_attributes( attributes ),
-				m_editQueue( editQueue )
+				m_index( g_invalidIndex ),
+				m_editQueue( editQueue ),
+				m_dirtyBounds( dirtyBounds )
 		{
 			IECore::StringAlgo::tokenize( name, '/', m_name );
 
@@ -383,6 +478,7 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			m_editQueue.push( [this, transform]() {
 				m_transform = transform;
 				m_transformSansScale = sansScalingAndShear( transform );
+				m_dirtyBounds.push_back( this );
 			} );
 		}
 
@@ -396,6 +492,7 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			ConstOpenGLAttributesPtr openGLAttributes = static_cast<const OpenGLAttributes *>( attributes );
 			m_editQueue.push( [this, openGLAttributes]() {
 				m_attributes = openGLAttributes;
+				m_dirtyBounds.push_back( this );
 			} );
 			return true;
 		}
@@ -404,7 +501,10 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 		{
 		}
 
-		Box3f transformedBound() const
+		// If `framingOnly` is true, visualisations which don't affect
+		// framing are omitted. Otherwise, the bound encloses everything
+		// drawn by `render()`, and is suitable for culling.
+		Box3f transformedBound( bool framingOnly = true ) const
 		{
 			Box3f b;
 
@@ -425,10 +525,10 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 
 			const Visualisations &attrVis = visualisations( *m_attributes );
 
-			accumulateVisualisationBounds( b, Visualisation::Scale::None, categories, m_transformSansScale, attrVis, m_objectVisualisations );
-			accumulateVisualisationBounds( b, Visualisation::Scale::Local, categories, m_transform, attrVis, m_objectVisualisations );
-			accumulateVisualisationBounds( b, Visualisation::Scale::Visualiser, categories, visualiserTransform( false ), attrVis, m_objectVisualisations );
-			accumulateVisualisationBounds( b, Visualisation::Scale::LocalAndVisualiser, categories, visualiserTransform( true ), attrVis, m_objectVisualisations );
+			accumulateVisualisationBounds( b, Visualisation::Scale::None, categories, m_transformSansScale, framingOnly, attrVis, m_objectVisualisations );
+			accumulateVisualisationBounds( b, Visualisation::Scale::Local, categories, m_transform, framingOnly, attrVis, m_objectVisualisations );
+			accumulateVisualisationBounds( b, Visualisation::Scale::Visualiser, categories, visualiserTransform( false ), framingOnly, attrVis, m_objectVisualisations );
+			accumulateVisualisationBounds( b, Visualisation::Scale::LocalAndVisualiser, categories, visualiserTransform( true ), framingOnly, attrVis, m_objectVisualisations );
 			return b;
 		}
 
@@ -489,11 +589,93 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			}
 		}
 
+		// Returns the renderable if the object consists of nothing else,
+		// in which case it may be drawn as part of a batch of objects
+		// sharing the same renderable and attributes. Returns null
+		// otherwise.
+		const IECoreGL::Renderable *batchRenderable() const
+		{
+			if( !m_renderable || !m_objectVisualisations.empty() || !visualisations( *m_attributes ).empty() )
+			{
+				return nullptr;
+			}
+			return m_renderable.get();
+		}
+
+		const OpenGLAttributes *attributes() const
+		{
+			return m_attributes.get();
+		}
+
+		// Draws the renderable of an object for which `batchRenderable()`
+		// is non-null, without binding its attribute state. This is the
+		// responsibility of the caller, which binds it once for the
+		// whole batch.
+		void renderBatched( IECoreGL::State *currentState ) const
+		{
+			ScopedTransform l( m_transform );
+			m_renderable->render( currentState );
+		}
+
+		// Appends the 12 edges of the transformed bound of the renderable
+		// to `p`, as pairs of points, so that the boxes for a whole batch
+		// may be drawn as a single set of lines.
+		void appendBoundingBox( vector<V3f> &p ) const
+		{
+			const Box3f b = m_renderable->bound();
+			if( b.isEmpty() )
+			{
+				return;
+			}
+
+			V3f corners[8];
+			for( int i = 0; i < 8; ++i )
+			{
+				const V3f c(
+					i & 1 ? b.max.x : b.min.x,
+					i & 2 ? b.max.y : b.min.y,
+					i & 4 ? b.max.z : b.min.z
+				);
+				corners[i] = c * m_transform;
+			}
+
+			// Each edge joins two corners whose indices
+			// differ in a single bit.
+			for( int i = 0; i < 8; ++i )
+			{
+				for( int bit = 1; bit < 8; bit <<= 1 )
+				{
+					if( !( i & bit ) )
+					{
+						p.push_back( corners[i] );
+						p.push_back( corners[i | bit] );
+					}
+				}
+			}
+		}
+
+		const M44f &getTransform() const
+		{
+			return m_transform;
+		}
+
 		IECore::TypeId objectType() const
 		{
 			return m_objectType;
 		}
 
+		// Index in the renderer's list of objects, which is also
+		// the id used for the object's BoundingVolumeHierarchy entry.
+		size_t getIndex() const
+		{
+			return m_index;
+		}
+
+		void setIndex( size_t index )
+		{
+			m_index = index;
+		}
+
 	protected :
 
 		EditQueue &editQueue()
@@ -526,7 +708,9 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 		IECoreGL::ConstRenderablePtr m_renderable;
 		Visualisations m_objectVisualisations;
 		vector<InternedString> m_name;
+		size_t m_index;
 		EditQueue &m_editQueue;
+		DirtyBounds &m_dirtyBounds;
 
 };
 
@@ -546,8 +730,8 @@ class OpenGLCamera : public OpenGLObject
 
 	public :
 
-		OpenGLCamera( const std::string &name, const IECoreScene::Camera *camera, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue )
-			:	OpenGLObject( name, camera, attributes, editQueue )
+		OpenGLCamera( const std::string &name, const IECoreScene::Camera *camera, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue, DirtyBounds &dirtyBounds )
+			:	OpenGLObject( name, camera, attributes, editQueue, dirtyBounds )
 		{
 			if( camera )
 			{
@@ -604,8 +788,8 @@ class OpenGLLight : public OpenGLObject
 
 	public :
 
-		OpenGLLight( const std::string &name, const IECore::Object *light, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue )
-			:	OpenGLObject( name, light, attributes, editQueue )
+		OpenGLLight( const std::string &name, const IECore::Object *light, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue, DirtyBounds &dirtyBounds )
+			:	OpenGLObject( name, light, attributes, editQueue, dirtyBounds )
 		{
 		}
 
@@ -625,8 +809,8 @@ class OpenGLLightFilter : public OpenGLObject
 
 	public :
 
-		OpenGLLightFilter( const std::string &name, const IECore::Object *object, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue )
-			:	OpenGLObject( name, object, attributes, editQueue )
+		OpenGLLightFilter( const std::string &name, const IECore::Object *object, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue, DirtyBounds &dirtyBounds )
+			:	OpenGLObject( name, object, attributes, editQueue, dirtyBounds )
 		{
 		}
 
@@ -655,7 +839,7 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 	public :
 
 		OpenGLRenderer( RenderType renderType, const std::string &fileName )
-			:	m_renderType( renderType ), m_baseStateOptions( new CompoundObject )
+			:	m_renderType( renderType ), m_baseStateOptions( new CompoundObject ), m_boundingBoxThreshold( 0 ), m_generation( 0 )
 		{
 			if( renderType == SceneDescription )
 			{
@@ -704,6 +888,18 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 				}
 				return;
 			}
+			else if( name == "gl:batch:boundingBoxThreshold" )
+			{
+				m_boundingBoxThreshold = 0;
+				if( value )
+				{
+					if( auto d = reportedCast<const IECore::IntData>( value, "option", name ) )
+					{
+						m_boundingBoxThreshold = std::max( d->readable(), 0 );
+					}
+				}
+				return;
+			}
 			else if(
 				boost::starts_with( name.string(), "gl:primitive:" ) ||
 				boost::starts_with( name.string(), "gl:pointsPrimitive:" ) ||
@@ -752,9 +948,9 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 
 		ObjectInterfacePtr camera( const std::string &name, const IECoreScene::Camera *camera, const AttributesInterface *attributes ) override
 		{
-			OpenGLCameraPtr result = new OpenGLCamera( name, camera, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue );
+			OpenGLCameraPtr result = new OpenGLCamera( name, camera, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue, m_dirtyBounds );
 			m_editQueue.push( [this, result, name]() {
-				m_objects.push_back( result );
+				addObject( result );
 				m_cameras[name] = result;
 			} );
 			return result;
@@ -762,22 +958,22 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 
 		ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
 		{
-			OpenGLLightPtr result = new OpenGLLight( name, object, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue );
-			m_editQueue.push( [this, result]() { m_objects.push_back( result ); } );
+			OpenGLLightPtr result = new OpenGLLight( name, object, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue, m_dirtyBounds );
+			m_editQueue.push( [this, result]() { addObject( result ); } );
 			return result;
 		}
 
 		ObjectInterfacePtr lightFilter( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
 		{
-			OpenGLLightFilterPtr result = new OpenGLLightFilter( name, object, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue );
-			m_editQueue.push( [this, result]() { m_objects.push_back( result ); } );
+			OpenGLLightFilterPtr result = new OpenGLLightFilter( name, object, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue, m_dirtyBounds );
+			m_editQueue.push( [this, result]() { addObject( result ); } );
 			return result;
 		}
 
 		Renderer::ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
 		{
-			OpenGLObjectPtr result = new OpenGLObject( name, object, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue );
-			m_editQueue.push( [this, result]() { m_objects.push_back( result ); } );
+			OpenGLObjectPtr result = new OpenGLObject( name, object, static_cast<const OpenGLAttributes *>( attributes ), m_editQueue, m_dirtyBounds );
+			m_editQueue.push( [this, result]() { addObject( result ); } );
 			return result;
 		}
 
@@ -816,12 +1012,74 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			{
 				return querySelectedObjects( parameters );
 			}
+			else if( name == "gl:queryCullingStatistics" )
+			{
+				return queryCullingStatistics();
+			}
+			else if( name == "gl:queryBatchStatistics" )
+			{
+				return queryBatchStatistics();
+			}
 
 			throw IECore::Exception( "Unknown command" );
 		}
 
 	private :
 
+		// Batches of visible objects which share a renderable and
+		// attributes, rebuilt by `renderObjects()` for each render.
+
+		struct BatchKey
+		{
+			const IECoreGL::Renderable *renderable;
+			const OpenGLAttributes *attributes;
+			bool selected;
+
+			bool operator == ( const BatchKey &other ) const
+			{
+				return renderable == other.renderable && attributes == other.attributes && selected == other.selected;
+			}
+		};
+
+		struct BatchKeyHash
+		{
+			size_t operator()( const BatchKey &key ) const
+			{
+				size_t result = 0;
+				boost::hash_combine( result, key.renderable );
+				boost::hash_combine( result, key.attributes );
+				boost::hash_combine( result, key.selected );
+				return result;
+			}
+		};
+
+		struct Batch
+		{
+			BatchKey key;
+			std::vector<size_t> objects;
+		};
+
+		// Data for drawing a batch with a single draw call, which
+		// is reused for as long as the scene is unchanged.
+		struct BatchCache
+		{
+			size_t generation = 0;
+			std::vector<size_t> objects;
+			bool used = false;
+			IECoreGL::CurvesPrimitivePtr boundingBoxes;
+			IECoreGL::Shader::SetupPtr instancingSetup;
+		};
+
+		struct BatchStatistics
+		{
+			size_t batches = 0;
+			size_t batchedObjects = 0;
+			size_t boundingBoxObjects = 0;
+			size_t instancedObjects = 0;
+			// Draw calls made for batched objects.
+			size_t drawCalls = 0;
+		};
+
 		void renderInteractive()
 		{
 			processQueue();
@@ -887,13 +1145,19 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			}
 			else
 			{
-				camera = new OpenGLCamera( "/defaultCamera", nullptr, nullptr, m_editQueue );
+				camera = new OpenGLCamera( "/defaultCamera", nullptr, nullptr, m_editQueue, m_dirtyBounds );
 			}
 
 			// We don't want to render the visualiser of the camera we're looking through.  For the viewport,
 			// we do this using SceneView::deleteObjectFilter, but here, instead of setting up a filter,
 			// we just delete the camera from the list of things to render.
-			m_objects.erase( std::remove( m_objects.begin(), m_objects.end(), camera), m_objects.end() );
+			const size_t cameraIndex = camera->getIndex();
+			if( cameraIndex != g_invalidIndex )
+			{
+				m_objects[cameraIndex] = nullptr;
+				m_bvh.remove( cameraIndex );
+				camera->setIndex( g_invalidIndex );
+			}
 
 			const V2i resolution = camera->getResolution();
 			IECoreGL::FrameBufferPtr frameBuffer = new FrameBuffer;
@@ -933,7 +1197,25 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			while( m_editQueue.try_pop( edit ) )
 			{
 				edit();
+				m_generation++;
+			}
+
+			for( auto o : m_dirtyBounds )
+			{
+				const size_t index = o->getIndex();
+				if( index != g_invalidIndex )
+				{
+					m_bvh.set( index, o->transformedBound( /* framingOnly = */ false ) );
+				}
 			}
+			m_dirtyBounds.clear();
+		}
+
+		void addObject( const OpenGLObjectPtr &object )
+		{
+			object->setIndex( m_objects.size() );
+			m_objects.push_back( object );
+			m_bvh.set( object->getIndex(), object->transformedBound( /* framingOnly = */ false ) );
 		}
 
 		// During interactive renders, the client code controls the lifetime
@@ -958,14 +1240,38 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 				}
 			}
 
-			m_objects.erase(
-				remove_if(
-					m_objects.begin(),
-					m_objects.end(),
-					[]( const OpenGLObjectPtr &o ) { return o->refCount() == 1; }
-				),
-				m_objects.end()
-			);
+			// Rather than erase objects immediately, we leave a gap, so that
+			// the indices of the remaining objects are unchanged, and only
+			// the removed objects need to be updated in `m_bvh`. When gaps
+			// make up half the list, we compact it and rebuild `m_bvh`
+			// from scratch.
+
+			size_t numGaps = 0;
+			for( size_t i = 0, e = m_objects.size(); i < e; ++i )
+			{
+				OpenGLObjectPtr &o = m_objects[i];
+				if( o && o->refCount() == 1 )
+				{
+					o = nullptr;
+					m_bvh.remove( i );
+					m_generation++;
+				}
+				numGaps += !o;
+			}
+
+			if( numGaps > m_objects.size() / 2 )
+			{
+				m_objects.erase(
+					remove( m_objects.begin(), m_objects.end(), nullptr ),
+					m_objects.end()
+				);
+				m_bvh.clear();
+				for( size_t i = 0, e = m_objects.size(); i < e; ++i )
+				{
+					m_objects[i]->setIndex( i );
+					m_bvh.set( i, m_objects[i]->transformedBound( /* framingOnly = */ false ) );
+				}
+			}
 
 			m_attributes.erase(
 				remove_if(
@@ -981,15 +1287,222 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 		{
 			IECoreGL::Selector *selector = IECoreGL::Selector::currentSelector();
 
-			GLuint i = 1;
-			for( const auto &o : m_objects )
+			// Cull objects outside the viewing frustum. During selection, the
+			// projection matrix is restricted to the selection region, so this
+			// also limits the objects rendered by the selector to those that
+			// could be selected.
+
+			M44f modelView;
+			M44f projection;
+			glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+			glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+
+			m_bvh.query( BoundingVolumeHierarchy::frustumPlanes( modelView * projection ), m_visibleObjects, &m_cullingStatistics );
+
+			// Objects consisting only of a renderable are grouped into batches
+			// which share the same renderable, attributes and selection state,
+			// so that the attribute state is bound once per batch rather than
+			// once per object. Where possible, each batch is then drawn with a
+			// single draw call. Everything else is rendered individually, and
+			// first, so that visualisations are drawn before geometry, as they
+			// are in `OpenGLObject::render()`.
+
+			m_batches.clear();
+			m_batchIndices.clear();
+			for( auto i : m_visibleObjects )
+			{
+				const OpenGLObject *object = m_objects[i].get();
+				const IECoreGL::Renderable *renderable = object->batchRenderable();
+				if( !renderable )
+				{
+					if( selector )
+					{
+						selector->loadName( i + 1 );
+					}
+					object->render( currentState, m_selection );
+					continue;
+				}
+
+				const BatchKey key = { renderable, object->attributes(), object->selected( m_selection ) };
+				auto inserted = m_batchIndices.insert( { key, m_batches.size() } );
+				if( inserted.second )
+				{
+					m_batches.push_back( Batch{ key, {} } );
+				}
+				m_batches[inserted.first->second].objects.push_back( i );
+			}
+
+			m_batchStatistics = BatchStatistics();
+			for( const auto &batch : m_batches )
+			{
+				IECoreGL::State::ScopedBinding scope( *batch.key.attributes->state(), *currentState );
+				IECoreGL::State::ScopedBinding selectionScope( selectionState(), *currentState, batch.key.selected );
+
+				m_batchStatistics.batches++;
+				m_batchStatistics.batchedObjects += batch.objects.size();
+
+				// During selection, every object must be drawn with its own
+				// name, so we can't combine their draw calls. We also always
+				// draw the real geometry, so that it is what the user actually
+				// clicks on.
+				if( !selector )
+				{
+					BatchCache &cache = batchCache( batch );
+
+					// Large batches may be drawn as bounding boxes, to keep
+					// the Viewer interactive.
+					if( m_boundingBoxThreshold && batch.objects.size() > (size_t)m_boundingBoxThreshold )
+					{
+						renderBoundingBoxes( batch, cache, currentState );
+						m_batchStatistics.boundingBoxObjects += batch.objects.size();
+						m_batchStatistics.drawCalls++;
+						continue;
+					}
+
+					if( batch.objects.size() > 1 && renderInstanced( batch, cache, currentState ) )
+					{
+						m_batchStatistics.instancedObjects += batch.objects.size();
+						m_batchStatistics.drawCalls++;
+						continue;
+					}
+				}
+
+				for( auto i : batch.objects )
+				{
+					if( selector )
+					{
+						selector->loadName( i + 1 );
+					}
+					m_objects[i]->renderBatched( currentState );
+				}
+				m_batchStatistics.drawCalls += batch.objects.size();
+			}
+
+			// Discard cached data for batches we didn't draw.
+			for( auto it = m_batchCaches.begin(); it != m_batchCaches.end(); )
+			{
+				if( it->second.used )
+				{
+					it->second.used = false;
+					++it;
+				}
+				else
+				{
+					it = m_batchCaches.erase( it );
+				}
+			}
+		}
+
+		// Returns the cached draw data for `batch`, cleared if the
+		// batch's objects, or anything else in the scene, has changed
+		// since the data was built.
+		BatchCache &batchCache( const Batch &batch )
+		{
+			BatchCache &cache = m_batchCaches[batch.key];
+			cache.used = true;
+			if( cache.generation != m_generation || cache.objects != batch.objects )
+			{
+				cache = BatchCache();
+				cache.used = true;
+				cache.generation = m_generation;
+				cache.objects = batch.objects;
+			}
+			return cache;
+		}
+
+		// Draws the bounding boxes of all the objects in `batch`
+		// using a single set of lines.
+		void renderBoundingBoxes( const Batch &batch, BatchCache &cache, IECoreGL::State *currentState )
+		{
+			if( !cache.boundingBoxes )
+			{
+				V3fVectorDataPtr pData = new V3fVectorData;
+				vector<V3f> &p = pData->writable();
+				p.reserve( batch.objects.size() * 24 );
+				for( auto i : batch.objects )
+				{
+					m_objects[i]->appendBoundingBox( p );
+				}
+
+				if( p.empty() )
+				{
+					return;
+				}
+
+				IntVectorDataPtr vertsPerCurve = new IntVectorData( vector<int>( p.size() / 2, 2 ) );
+				cache.boundingBoxes = new IECoreGL::CurvesPrimitive( CubicBasisf::linear(), false, vertsPerCurve );
+				cache.boundingBoxes->addPrimitiveVariable( "P", IECoreScene::PrimitiveVariable( IECoreScene::PrimitiveVariable::Vertex, pData ) );
+			}
+
+			IECoreGL::State::ScopedBinding boundingBoxScope( boundingBoxState(), *currentState );
+			cache.boundingBoxes->render( currentState );
+		}
+
+		// Draws all the objects in `batch` with a single instanced draw call,
+		// returning false without drawing anything if that isn't possible.
+		// This is the case unless the objects are meshes which are only drawn
+		// solid, using the default shaders, because we substitute our own vertex
+		// shader to apply the per-instance transforms.
+		bool renderInstanced( const Batch &batch, BatchCache &cache, IECoreGL::State *currentState )
+		{
+			const IECoreGL::MeshPrimitive *mesh = runTimeCast<const IECoreGL::MeshPrimitive>( batch.key.renderable );
+			if(
+				!mesh ||
+				!currentState->get<IECoreGL::Primitive::DrawSolid>()->value() ||
+				currentState->get<IECoreGL::Primitive::DrawWireframe>()->value() ||
+				currentState->get<IECoreGL::Primitive::DrawOutline>()->value() ||
+				currentState->get<IECoreGL::Primitive::DrawPoints>()->value() ||
+				currentState->get<IECoreGL::Primitive::DrawBound>()->value()
+			)
+			{
+				return false;
+			}
+
+			const IECoreGL::Shader *shader = currentState->get<IECoreGL::ShaderStateComponent>()->shaderSetup()->shader();
+			if(
+				!isDefaultSource( shader->vertexSource(), IECoreGL::Shader::defaultVertexSource() ) ||
+				!isDefaultSource( shader->geometrySource(), IECoreGL::Shader::defaultGeometrySource() ) ||
+				!isDefaultSource( shader->fragmentSource(), IECoreGL::Shader::defaultFragmentSource() )
+			)
+			{
+				return false;
+			}
+
+			if( !cache.instancingSetup )
 			{
-				if( selector )
+				static IECoreGL::ConstShaderPtr g_instancingShader = IECoreGL::ShaderLoader::defaultShaderLoader()->create(
+					instancingVertexSource(), "", IECoreGL::Shader::defaultFragmentSource()
+				);
+
+				V3fVectorDataPtr xData = new V3fVectorData;
+				V3fVectorDataPtr yData = new V3fVectorData;
+				V3fVectorDataPtr zData = new V3fVectorData;
+				V3fVectorDataPtr pData = new V3fVectorData;
+				for( auto &d : { xData, yData, zData, pData } )
 				{
-					selector->loadName( i++ );
+					d->writable().reserve( batch.objects.size() );
 				}
-				o->render( currentState, m_selection );
+
+				for( auto i : batch.objects )
+				{
+					const M44f &m = m_objects[i]->getTransform();
+					xData->writable().push_back( V3f( m[0][0], m[0][1], m[0][2] ) );
+					yData->writable().push_back( V3f( m[1][0], m[1][1], m[1][2] ) );
+					zData->writable().push_back( V3f( m[2][0], m[2][1], m[2][2] ) );
+					pData->writable().push_back( V3f( m[3][0], m[3][1], m[3][2] ) );
+				}
+
+				cache.instancingSetup = new IECoreGL::Shader::Setup( g_instancingShader );
+				mesh->addPrimitiveVariablesToShaderSetup( cache.instancingSetup.get() );
+				cache.instancingSetup->addVertexAttribute( "instanceX", xData, /* divisor = */ 1 );
+				cache.instancingSetup->addVertexAttribute( "instanceY", yData, /* divisor = */ 1 );
+				cache.instancingSetup->addVertexAttribute( "instanceZ", zData, /* divisor = */ 1 );
+				cache.instancingSetup->addVertexAttribute( "instanceP", pData, /* divisor = */ 1 );
 			}
+
+			IECoreGL::Shader::Setup::ScopedBinding instancingBinding( *cache.instancingSetup );
+			mesh->renderInstances( batch.objects.size() );
+			return true;
 		}
 
 		void writeOutputs( const FrameBuffer *frameBuffer )
@@ -1040,7 +1553,7 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			Box3f result;
 			for( const auto &o : m_objects )
 			{
-				if( selected && !o->selected( m_selection ) )
+				if( !o || ( selected && !o->selected( m_selection ) ) )
 				{
 					continue;
 				}
@@ -1086,7 +1599,11 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			PathMatcher result;
 			for( auto i : names->readable() )
 			{
-				const OpenGLObject *o = m_objects[i-1].get();
+				const OpenGLObject *o = i >= 1 && i <= m_objects.size() ? m_objects[i-1].get() : nullptr;
+				if( !o )
+				{
+					continue;
+				}
 				for( auto t : maskTypeIds )
 				{
 					if( t == o->objectType() || RunTimeTyped::inheritsFrom( o->objectType(), t ) )
@@ -1100,6 +1617,28 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			return new PathMatcherData( result );
 		}
 
+		DataPtr queryCullingStatistics()
+		{
+			CompoundDataPtr result = new CompoundData;
+			result->writable()["objects"] = new UInt64Data( m_cullingStatistics.items );
+			result->writable()["objectsRendered"] = new UInt64Data( m_cullingStatistics.itemsReturned );
+			result->writable()["objectsCulled"] = new UInt64Data( m_cullingStatistics.items - m_cullingStatistics.itemsReturned );
+			result->writable()["objectBoundsTested"] = new UInt64Data( m_cullingStatistics.itemsTested );
+			result->writable()["nodeBoundsTested"] = new UInt64Data( m_cullingStatistics.nodesTested );
+			return result;
+		}
+
+		DataPtr queryBatchStatistics()
+		{
+			CompoundDataPtr result = new CompoundData;
+			result->writable()["batches"] = new UInt64Data( m_batchStatistics.batches );
+			result->writable()["batchedObjects"] = new UInt64Data( m_batchStatistics.batchedObjects );
+			result->writable()["boundingBoxObjects"] = new UInt64Data( m_batchStatistics.boundingBoxObjects );
+			result->writable()["instancedObjects"] = new UInt64Data( m_batchStatistics.instancedObjects );
+			result->writable()["drawCalls"] = new UInt64Data( m_batchStatistics.drawCalls );
+			return result;
+		}
+
 		IECoreGL::State *baseState()
 		{
 			if( !m_baseState )
@@ -1119,6 +1658,7 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 		IECore::PathMatcher m_selection;
 		IECore::CompoundObjectPtr m_baseStateOptions;
 		IECoreGL::StatePtr m_baseState;
+		int m_boundingBoxThreshold;
 
 		// Queue used to pass edits from background threads to the render thread.
 		EditQueue m_editQueue;
@@ -1130,9 +1670,27 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 		typedef std::unordered_map<string, OpenGLCameraPtr> CameraMap;
 		CameraMap m_cameras;
 
+		// Objects removed by `removeDeletedObjects()` leave null
+		// entries in `m_objects` until it is compacted.
 		typedef std::vector<OpenGLObjectPtr> OpenGLObjectVector;
 		OpenGLObjectVector m_objects;
 
+		// Spatial index of `m_objects`, used for culling.
+		BoundingVolumeHierarchy m_bvh;
+		DirtyBounds m_dirtyBounds;
+		std::vector<size_t> m_visibleObjects;
+		BoundingVolumeHierarchy::Statistics m_cullingStatistics;
+
+		// Rebuilt by `renderObjects()` for each render.
+		std::vector<Batch> m_batches;
+		std::unordered_map<BatchKey, size_t, BatchKeyHash> m_batchIndices;
+		// Kept between renders, for the batches drawn by the last one.
+		std::unordered_map<BatchKey, BatchCache, BatchKeyHash> m_batchCaches;
+		BatchStatistics m_batchStatistics;
+		// Incremented whenever the scene is edited, to invalidate
+		// `m_batchCaches`.
+		size_t m_generation;
+
 		typedef std::vector<OpenGLAttributesPtr> OpenGLAttributesVector;
 		OpenGLAttributesVector m_attributes;
 
@@ -49,7 +49,7 @@ using namespace IECoreScenePreview;
 IECoreScenePreview::Renderer::TypeDescription<CapturingRenderer> CapturingRenderer::g_typeDescription( "Capturing" );
 
 CapturingRenderer::CapturingRenderer( RenderType type, const std::string &fileName )
-	:	m_rendering( false )
+	:	m_rendering( false ), m_nextObjectId( 0 )
 {
 }
 
@@ -169,7 +169,7 @@ const IECore::CompoundObject *CapturingRenderer::CapturedAttributes::attributes(
 //////////////////////////////////////////////////////////////////////////
 
 CapturingRenderer::CapturedObject::CapturedObject( CapturingRenderer *renderer, const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times )
-	:	m_renderer( renderer ), m_name( name ), m_capturedSamples( samples.begin(), samples.end() ), m_capturedSampleTimes( times ), m_numAttributeEdits( 0 )
+	:	m_renderer( renderer ), m_name( name ), m_id( renderer->m_nextObjectId++ ), m_capturedSamples( samples.begin(), samples.end() ), m_capturedSampleTimes( times ), m_numAttributeEdits( 0 )
 {
 }
 
@@ -219,6 +219,11 @@ int CapturingRenderer::CapturedObject::numLinkEdits( const IECore::InternedStrin
 	return it->second.second;
 }
 
+size_t CapturingRenderer::CapturedObject::id() const
+{
+	return m_id;
+}
+
 void CapturingRenderer::CapturedObject::transform( const Imath::M44f &transform )
 {
 	m_renderer->checkPaused();
@@ -46,12 +46,17 @@
 
 #include "IECore/NullObject.h"
 
+#include "OpenEXR/ImathBoxAlgo.h"
+
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/bind.hpp"
 #include "boost/make_unique.hpp"
 
+#include "tbb/parallel_for.h"
 #include "tbb/task.h"
 
+#include <limits>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -81,6 +86,48 @@ bool visible( const CompoundObject *attributes )
 	return d ? d->readable() : true;
 }
 
+// Returns false if `bound` is certain to be outside the view defined by
+// `worldToClip`, and true otherwise. Also fills `depth` with a value which
+// increases with distance from the camera, for prioritising nearer bounds.
+bool intersectsView( const Box3f &bound, const M44f &worldToClip, float &depth )
+{
+	if( bound.isEmpty() )
+	{
+		// Can't cull, so treat as if nearest.
+		depth = -std::numeric_limits<float>::max();
+		return true;
+	}
+
+	// Each bit of `outside` records whether all corners are
+	// outside one of the six planes of the clip volume.
+	unsigned outside = 63;
+	depth = std::numeric_limits<float>::max();
+	for( int i = 0; i < 8; ++i )
+	{
+		const V4f c = V4f(
+			i & 1 ? bound.max.x : bound.min.x,
+			i & 2 ? bound.max.y : bound.min.y,
+			i & 4 ? bound.max.z : bound.min.z,
+			1.0f
+		) * worldToClip;
+
+		unsigned cornerOutside = 0;
+		cornerOutside |= c.x < -c.w ? 1 : 0;
+		cornerOutside |= c.x > c.w ? 2 : 0;
+		cornerOutside |= c.y < -c.w ? 4 : 0;
+		cornerOutside |= c.y > c.w ? 8 : 0;
+		cornerOutside |= c.z < -c.w ? 16 : 0;
+		cornerOutside |= c.z > c.w ? 32 : 0;
+		outside &= cornerOutside;
+
+		// Clip space `z` increases monotonically with distance
+		// for both perspective and orthographic projections.
+		depth = std::min( depth, c.z );
+	}
+
+	return !outside;
+}
+
 bool cameraGlobalsChanged( const CompoundObject *globals, const CompoundObject *previousGlobals, const ScenePlug *scene )
 {
 	if( !previousGlobals )
@@ -203,7 +250,7 @@ class RenderController::SceneGraph
 		// Constructs the root of the scene graph.
 		// Children are constructed using updateChildren().
 		SceneGraph()
-			:	m_parent( nullptr ), m_fullAttributes( new CompoundObject ), m_dirtyComponents( AllComponents ), m_changedComponents( NoComponent )
+			:	m_parent( nullptr ), m_fullAttributes( new CompoundObject ), m_dirtyComponents( AllComponents ), m_changedComponents( NoComponent ), m_changeCount( 0 ), m_parentChangeCount( 0 )
 		{
 			clear();
 		}
@@ -237,6 +284,12 @@ class RenderController::SceneGraph
 		{
 			const unsigned originalChangedComponents = m_changedComponents;
 
+			// We may already have applied our parent's changes during a
+			// previous update of only the visible locations, while our
+			// parent was still waiting for its other children to be updated.
+			// In that case we mustn't apply them again.
+			const bool parentChangesPending = m_parent && m_parentChangeCount != m_parent->m_changeCount;
+
 			// Attributes
 
 			if( !m_parent )
@@ -247,18 +300,20 @@ class RenderController::SceneGraph
 					if( updateAttributes( controller->m_globals.get() ) )
 					{
 						m_changedComponents |= AttributesComponent;
+						m_changeCount++;
 					}
 				}
 			}
 			else
 			{
 				// Non-root - get attributes the standard way.
-				const bool parentAttributesChanged = m_parent->m_changedComponents & AttributesComponent;
+				const bool parentAttributesChanged = parentChangesPending && ( m_parent->m_changedComponents & AttributesComponent );
 				if( parentAttributesChanged || ( m_dirtyComponents & AttributesComponent ) )
 				{
 					if( updateAttributes( controller->m_scene->attributesPlug(), parentAttributesChanged ) )
 					{
 						m_changedComponents |= AttributesComponent;
+						m_changeCount++;
 					}
 				}
 			}
@@ -266,6 +321,7 @@ class RenderController::SceneGraph
 			if( !::visible( m_fullAttributes.get() ) )
 			{
 				clear();
+				parentChangesApplied();
 				return originalChangedComponents != m_changedComponents;
 			}
 
@@ -279,6 +335,7 @@ class RenderController::SceneGraph
 				if( updateRenderSets( path, controller->m_renderSets ) )
 				{
 					m_changedComponents |= AttributesComponent;
+					m_changeCount++;
 				}
 			}
 
@@ -286,12 +343,13 @@ class RenderController::SceneGraph
 
 			// Transform
 
-			const bool parentTransformChanged = m_parent && ( m_parent->m_changedComponents & TransformComponent );
+			const bool parentTransformChanged = parentChangesPending && ( m_parent->m_changedComponents & TransformComponent );
 			if( ( m_dirtyComponents & TransformComponent ) || parentTransformChanged )
 			{
 				if( updateTransform( controller->m_scene->transformPlug(), parentTransformChanged ) )
 				{
 					m_changedComponents |= TransformComponent;
+					m_changeCount++;
 				}
 			}
 
@@ -409,6 +467,7 @@ class RenderController::SceneGraph
 			clean( ExpansionComponent | BoundComponent );
 
 			m_cleared = false;
+			parentChangesApplied();
 
 			assert( m_dirtyComponents == NoComponent );
 
@@ -420,6 +479,11 @@ class RenderController::SceneGraph
 			return m_expanded;
 		}
 
+		const Imath::M44f &fullTransform() const
+		{
+			return m_fullTransform;
+		}
+
 		const std::vector<std::unique_ptr<SceneGraph>> &children()
 		{
 			return m_children;
@@ -459,7 +523,7 @@ class RenderController::SceneGraph
 	private :
 
 		SceneGraph( const InternedString &name, const SceneGraph *parent )
-			:	m_name( name ), m_parent( parent ), m_fullAttributes( new CompoundObject )
+			:	m_name( name ), m_parent( parent ), m_fullAttributes( new CompoundObject ), m_changedComponents( NoComponent ), m_changeCount( 0 ), m_parentChangeCount( 0 )
 		{
 			clear();
 		}
@@ -752,6 +816,11 @@ class RenderController::SceneGraph
 			m_dirtyComponents &= ~components;
 		}
 
+		void parentChangesApplied()
+		{
+			m_parentChangeCount = m_parent ? m_parent->m_changeCount : 0;
+		}
+
 		IECore::InternedString m_name;
 
 		const SceneGraph *m_parent;
@@ -794,6 +863,14 @@ class RenderController::SceneGraph
 		// We clear `m_changedComponents` once all children have
 		// been updated successfully, in `allChildrenUpdated()`.
 		unsigned m_changedComponents;
+		// Incremented whenever attributes or transform change,
+		// which are the changes our children must inherit. Each
+		// child records the count at which it last applied them
+		// in `m_parentChangeCount`, so that it applies them only
+		// once even if they stay in `m_changedComponents` for
+		// several updates.
+		size_t m_changeCount;
+		size_t m_parentChangeCount;
 
 		bool m_cleared;
 
@@ -813,7 +890,8 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 			const ThreadState &threadState,
 			const ScenePlug::ScenePath &scenePath,
 			const ProgressCallback &callback,
-			const PathMatcher *pathsToUpdate
+			const PathMatcher *pathsToUpdate,
+			const M44f *priorityView
 		)
 			:	m_controller( controller ),
 				m_sceneGraph( sceneGraph ),
@@ -822,7 +900,8 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 				m_threadState( threadState ),
 				m_scenePath( scenePath ),
 				m_callback( callback ),
-				m_pathsToUpdate( pathsToUpdate )
+				m_pathsToUpdate( pathsToUpdate ),
+				m_priorityView( priorityView )
 		{
 		}
 
@@ -869,20 +948,20 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 			// Spawn subtasks to apply updates to each child.
 
 			const auto &children = m_sceneGraph->children();
+			bool allChildrenVisited = true;
 			if( m_sceneGraph->expanded() && children.size() )
 			{
-				set_ref_count( 1 + children.size() );
-
-				ScenePlug::ScenePath childPath = m_scenePath;
-				childPath.push_back( IECore::InternedString() ); // space for the child name
-				for( const auto &child : children )
+				if( m_priorityView )
 				{
-					childPath.back() = child->name();
-					SceneGraphUpdateTask *t = new( allocate_child() ) SceneGraphUpdateTask( m_controller, child.get(), m_sceneGraphType, m_changedGlobalComponents, m_threadState, childPath, m_callback, m_pathsToUpdate );
-					spawn( *t );
+					vector<SceneGraph *> childrenInView;
+					visibleChildren( childrenInView );
+					allChildrenVisited = childrenInView.size() == children.size();
+					updateChildren( childrenInView );
+				}
+				else
+				{
+					updateChildren( children );
 				}
-
-				wait_for_all();
 			}
 			else
 			{
@@ -892,7 +971,10 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 				}
 			}
 
-			if( pathsToUpdateMatch & ( PathMatcher::AncestorMatch | PathMatcher::ExactMatch ) )
+			// Children skipped because they weren't visible may still need
+			// to know what changed here, so we can only consider our changes
+			// to be fully propagated when we have visited them all.
+			if( allChildrenVisited && ( pathsToUpdateMatch & ( PathMatcher::AncestorMatch | PathMatcher::ExactMatch ) ) )
 			{
 				m_sceneGraph->allChildrenUpdated();
 			}
@@ -902,11 +984,85 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 
 	private :
 
-		const ScenePlug *scene()
+		// Spawns subtasks to update `children`, and waits for them to complete.
+		// `Children` may contain either raw or unique pointers.
+		template<typename Children>
+		void updateChildren( const Children &children )
+		{
+			if( children.empty() )
+			{
+				return;
+			}
+
+			set_ref_count( 1 + children.size() );
+
+			ScenePlug::ScenePath childPath = m_scenePath;
+			childPath.push_back( IECore::InternedString() ); // space for the child name
+			for( const auto &child : children )
+			{
+				childPath.back() = child->name();
+				SceneGraphUpdateTask *t = new( allocate_child() ) SceneGraphUpdateTask( m_controller, &*child, m_sceneGraphType, m_changedGlobalComponents, m_threadState, childPath, m_callback, m_pathsToUpdate, m_priorityView );
+				spawn( *t );
+			}
+
+			wait_for_all();
+		}
+
+		const ScenePlug *scene() const
 		{
 			return m_controller->m_scene.get();
 		}
 
+		// Fills `children` with the children whose bounds intersect
+		// `m_priorityView`, in the order they should be spawned. TBB
+		// executes the most recently spawned task first on this thread,
+		// so we spawn the nearest children last.
+		void visibleChildren( vector<SceneGraph *> &children ) const
+		{
+			const auto &allChildren = m_sceneGraph->children();
+			vector<float> depths( allChildren.size() );
+			vector<char> inView( allChildren.size() );
+			const M44f &parentTransform = m_sceneGraph->fullTransform();
+
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, allChildren.size() ),
+				[&]( const tbb::blocked_range<size_t> &range ) {
+					ScenePlug::ScenePath childPath = m_scenePath;
+					childPath.push_back( IECore::InternedString() );
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						childPath.back() = allChildren[i]->name();
+						ScenePlug::PathScope pathScope( m_threadState, childPath );
+						const M44f transform = scene()->transformPlug()->getValue() * parentTransform;
+						const Box3f bound = Imath::transform( scene()->boundPlug()->getValue(), transform );
+						inView[i] = intersectsView( bound, *m_priorityView, depths[i] );
+					}
+				}
+			);
+
+			vector<size_t> indices;
+			for( size_t i = 0; i < allChildren.size(); ++i )
+			{
+				if( inView[i] )
+				{
+					indices.push_back( i );
+				}
+			}
+
+			std::sort(
+				indices.begin(), indices.end(),
+				[&depths]( size_t a, size_t b ) {
+					return depths[a] > depths[b];
+				}
+			);
+
+			children.clear();
+			for( auto i : indices )
+			{
+				children.push_back( allChildren[i].get() );
+			}
+		}
+
 		/// \todo Fast path for when sets were not dirtied.
 		unsigned sceneGraphMatch() const
 		{
@@ -944,6 +1100,7 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 		ScenePlug::ScenePath m_scenePath;
 		const ProgressCallback &m_callback;
 		const PathMatcher *m_pathsToUpdate;
+		const M44f *m_priorityView;
 
 };
 
@@ -954,6 +1111,7 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 RenderController::RenderController( const ConstScenePlugPtr &scene, const Gaffer::ConstContextPtr &context, const IECoreScenePreview::RendererPtr &renderer )
 	:	m_renderer( renderer ),
 		m_minimumExpansionDepth( 0 ),
+		m_priorityViewEnabled( false ),
 		m_updateRequired( false ),
 		m_updateRequested( false ),
 		m_dirtyGlobalComponents( NoGlobalComponent ),
@@ -1087,6 +1245,17 @@ size_t RenderController::getMinimumExpansionDepth() const
 	return m_minimumExpansionDepth;
 }
 
+void RenderController::setPriorityView( const Imath::M44f &worldToClip )
+{
+	m_priorityViewEnabled = true;
+	m_priorityView = worldToClip;
+}
+
+void RenderController::clearPriorityView()
+{
+	m_priorityViewEnabled = false;
+}
+
 RenderController::UpdateRequiredSignal &RenderController::updateRequiredSignal()
 {
 	return m_updateRequiredSignal;
@@ -1198,14 +1367,27 @@ std::shared_ptr<Gaffer::BackgroundTask> RenderController::updateInBackground( co
 	Context::EditableScope scopedContext( m_context.get() );
 	scopedContext.set( "scene:renderer", m_renderer->name().string() );
 
+	// Take a copy of the view, so that it may be changed
+	// while the update is running.
+	const bool priorityViewEnabled = m_priorityViewEnabled;
+	const M44f priorityView = m_priorityView;
+
 	m_backgroundTask = ParallelAlgo::callOnBackgroundThread(
 		// Subject
 		m_scene.get(),
-		[this, callback, priorityPaths] {
+		[this, callback, priorityPaths, priorityViewEnabled, priorityView] {
 			if( !priorityPaths.isEmpty() )
 			{
 				updateInternal( callback, &priorityPaths );
 			}
+			if( priorityViewEnabled )
+			{
+				// Update the visible parts of the scene first, so they
+				// are displayed as soon as possible. Locations completed
+				// here are clean, so are skipped quickly by the full
+				// update which follows.
+				updateInternal( callback, nullptr, &priorityView );
+			}
 			updateInternal( callback );
 		}
 	);
@@ -1226,7 +1408,7 @@ void RenderController::updateMatchingPaths( const IECore::PathMatcher &pathsToUp
 	updateInternal( callback, &pathsToUpdate );
 }
 
-void RenderController::updateInternal( const ProgressCallback &callback, const IECore::PathMatcher *pathsToUpdate )
+void RenderController::updateInternal( const ProgressCallback &callback, const IECore::PathMatcher *pathsToUpdate, const Imath::M44f *priorityView )
 {
 	try
 	{
@@ -1279,7 +1461,7 @@ void RenderController::updateInternal( const ProgressCallback &callback, const I
 
 			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 			SceneGraphUpdateTask *task = new( tbb::task::allocate_root( taskGroupContext ) ) SceneGraphUpdateTask(
-				this, sceneGraph, (SceneGraph::Type)i, m_changedGlobalComponents, ThreadState::current(), ScenePlug::ScenePath(), callback, pathsToUpdate
+				this, sceneGraph, (SceneGraph::Type)i, m_changedGlobalComponents, ThreadState::current(), ScenePlug::ScenePath(), callback, pathsToUpdate, priorityView
 			);
 			tbb::task::spawn_root_and_wait( *task );
 
@@ -1294,7 +1476,7 @@ void RenderController::updateInternal( const ProgressCallback &callback, const I
 			updateDefaultCamera();
 		}
 
-		if( !pathsToUpdate )
+		if( !pathsToUpdate && !priorityView )
 		{
 			// Only clear `m_changedGlobalComponents` when we
 			// know our entire scene has been updated successfully.
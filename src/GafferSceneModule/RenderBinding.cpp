@@ -398,6 +398,7 @@ void GafferSceneModule::bindRender()
 			.def( "capturedLinks", &capturedObjectCapturedLinks )
 			.def( "numAttributeEdits", &CapturingRenderer::CapturedObject::numAttributeEdits )
 			.def( "numLinkEdits", &CapturingRenderer::CapturedObject::numLinkEdits )
+			.def( "id", &CapturingRenderer::CapturedObject::id )
 		;
 
 	}
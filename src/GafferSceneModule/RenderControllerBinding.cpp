@@ -103,6 +103,12 @@ void updateMatchingPaths( RenderController &r, const IECore::PathMatcher &pathsT
 	r.updateMatchingPaths( pathsToUpdate );
 }
 
+std::shared_ptr<BackgroundTask> updateInBackground( RenderController &r, const IECore::PathMatcher &priorityPaths )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return r.updateInBackground( RenderController::ProgressCallback(), priorityPaths );
+}
+
 } // namespace
 
 void GafferSceneModule::bindRenderController()
@@ -119,9 +125,12 @@ void GafferSceneModule::bindRenderController()
 		.def( "getExpandedPaths", &RenderController::getExpandedPaths, return_value_policy<copy_const_reference>() )
 		.def( "setMinimumExpansionDepth", &setMinimumExpansionDepth )
 		.def( "getMinimumExpansionDepth", &RenderController::getMinimumExpansionDepth )
+		.def( "setPriorityView", &RenderController::setPriorityView )
+		.def( "clearPriorityView", &RenderController::clearPriorityView )
 		.def( "updateRequiredSignal", &RenderController::updateRequiredSignal, return_internal_reference<1>() )
 		.def( "update", &update )
 		.def( "updateMatchingPaths", &updateMatchingPaths )
+		.def( "updateInBackground", &updateInBackground, ( arg( "priorityPaths" ) = IECore::PathMatcher() ) )
 	;
 
 	SignalClass<RenderController::UpdateRequiredSignal>( "UpdateRequiredSignal" );
@@ -0,0 +1,235 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferSceneTest/BoundingVolumeHierarchyTest.h"
+
+#include "GafferScene/Private/IECoreGLPreview/BoundingVolumeHierarchy.h"
+
+#include "GafferTest/Assert.h"
+
+#include <random>
+
+using namespace std;
+using namespace Imath;
+using namespace IECoreGLPreview;
+
+namespace
+{
+
+// Equivalent to a camera at `position` looking down the negative
+// Z axis, with a perspective projection.
+M44f worldToClip( const V3f &position, float fieldOfView, float near, float far )
+{
+	M44f translate;
+	translate[3][0] = -position.x;
+	translate[3][1] = -position.y;
+	translate[3][2] = -position.z;
+
+	const float f = 1.0f / tan( fieldOfView / 2.0f );
+	M44f projection;
+	projection[0][0] = f;
+	projection[1][1] = f;
+	projection[2][2] = ( far + near ) / ( near - far );
+	projection[2][3] = -1;
+	projection[3][2] = 2 * far * near / ( near - far );
+	projection[3][3] = 0;
+
+	return translate * projection;
+}
+
+bool outside( const Box3f &box, const BoundingVolumeHierarchy::Planes &planes )
+{
+	for( const auto &plane : planes )
+	{
+		const V3f &n = plane.normal;
+		const V3f nearest(
+			n.x >= 0 ? box.max.x : box.min.x,
+			n.y >= 0 ? box.max.y : box.min.y,
+			n.z >= 0 ? box.max.z : box.min.z
+		);
+		if( plane.distanceTo( nearest ) < 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Checks the query results against a brute force test of every bound.
+void assertQuery( BoundingVolumeHierarchy &bvh, const vector<Box3f> &bounds, const vector<bool> &present, const BoundingVolumeHierarchy::Planes &planes )
+{
+	vector<size_t> expected;
+	for( size_t i = 0; i < bounds.size(); ++i )
+	{
+		if( present[i] && ( bounds[i].isEmpty() || !outside( bounds[i], planes ) ) )
+		{
+			expected.push_back( i );
+		}
+	}
+
+	vector<size_t> ids;
+	BoundingVolumeHierarchy::Statistics statistics;
+	bvh.query( planes, ids, &statistics );
+
+	GAFFERTEST_ASSERT( ids == expected );
+	GAFFERTEST_ASSERTEQUAL( statistics.items, bvh.size() );
+	GAFFERTEST_ASSERTEQUAL( statistics.itemsReturned, expected.size() );
+}
+
+Box3f randomBox( std::mt19937 &generator )
+{
+	std::uniform_real_distribution<float> position( -100, 100 );
+	std::uniform_real_distribution<float> size( 0.1, 2 );
+
+	const V3f p( position( generator ), position( generator ), position( generator ) );
+	return Box3f( p, p + V3f( size( generator ) ) );
+}
+
+} // namespace
+
+void GafferSceneTest::testBoundingVolumeHierarchy()
+{
+	std::mt19937 generator( 1 );
+	std::uniform_int_distribution<size_t> index( 0, 9999 );
+
+	vector<Box3f> bounds;
+	vector<bool> present;
+	BoundingVolumeHierarchy bvh;
+	for( size_t i = 0; i < 10000; ++i )
+	{
+		bounds.push_back( randomBox( generator ) );
+		present.push_back( true );
+		bvh.set( i, bounds.back() );
+	}
+	GAFFERTEST_ASSERTEQUAL( bvh.size(), 10000 );
+
+	const M44f camera = worldToClip( V3f( 0, 0, 150 ), M_PI / 4.0f, 0.1f, 1000.0f );
+	const BoundingVolumeHierarchy::Planes fullPlanes = BoundingVolumeHierarchy::frustumPlanes( camera );
+	const BoundingVolumeHierarchy::Planes boxPlanes = BoundingVolumeHierarchy::frustumPlanes( camera, Box2f( V2f( 0.1, 0.2 ), V2f( 0.3, 0.25 ) ) );
+	const BoundingVolumeHierarchy::Planes pixelPlanes = BoundingVolumeHierarchy::frustumPlanes( camera, Box2f( V2f( -0.001 ), V2f( 0.001 ) ) );
+	const BoundingVolumeHierarchy::Planes behindPlanes = BoundingVolumeHierarchy::frustumPlanes( worldToClip( V3f( 0, 0, -150 ), M_PI / 4.0f, 0.1f, 1000.0f ) );
+
+	auto assertAllQueries = [&]() {
+		assertQuery( bvh, bounds, present, fullPlanes );
+		assertQuery( bvh, bounds, present, boxPlanes );
+		assertQuery( bvh, bounds, present, pixelPlanes );
+		assertQuery( bvh, bounds, present, behindPlanes );
+	};
+
+	assertAllQueries();
+
+	// A small region should be answered without testing
+	// the majority of the items.
+
+	vector<size_t> ids;
+	BoundingVolumeHierarchy::Statistics statistics;
+	bvh.query( boxPlanes, ids, &statistics );
+	GAFFERTEST_ASSERT( ids.size() < 1000 );
+	GAFFERTEST_ASSERT( statistics.itemsTested < 1000 );
+	GAFFERTEST_ASSERT( statistics.nodesTested < 2000 );
+
+	// Edit bounds. These are refitted without rebuilding the tree.
+
+	for( size_t i = 0; i < 1000; ++i )
+	{
+		const size_t id = index( generator );
+		bounds[id] = randomBox( generator );
+		bvh.set( id, bounds[id] );
+	}
+	assertAllQueries();
+
+	// Remove items, add items and set empty bounds, both in
+	// small numbers which are accumulated without rebuilding,
+	// and in large numbers which trigger a rebuild.
+
+	for( size_t numEdits : { 10, 5000 } )
+	{
+		for( size_t i = 0; i < numEdits; ++i )
+		{
+			size_t id = index( generator );
+			bvh.remove( id );
+			present[id] = false;
+
+			id = index( generator );
+			bounds[id] = Box3f();
+			present[id] = true;
+			bvh.set( id, bounds[id] );
+
+			id = bounds.size();
+			bounds.push_back( randomBox( generator ) );
+			present.push_back( true );
+			bvh.set( id, bounds[id] );
+
+			// Items with empty bounds regaining a bound.
+			id = index( generator );
+			if( present[id] && bounds[id].isEmpty() )
+			{
+				bounds[id] = randomBox( generator );
+				bvh.set( id, bounds[id] );
+			}
+		}
+
+		GAFFERTEST_ASSERTEQUAL( bvh.size(), (size_t)std::count( present.begin(), present.end(), true ) );
+		assertAllQueries();
+	}
+
+	bvh.clear();
+	GAFFERTEST_ASSERTEQUAL( bvh.size(), 0 );
+	bvh.query( fullPlanes, ids );
+	GAFFERTEST_ASSERT( ids.empty() );
+}
+
+void GafferSceneTest::testBoundingVolumeHierarchyPerformance( size_t numItems )
+{
+	std::mt19937 generator( 1 );
+
+	BoundingVolumeHierarchy bvh;
+	for( size_t i = 0; i < numItems; ++i )
+	{
+		bvh.set( i, randomBox( generator ) );
+	}
+
+	const M44f camera = worldToClip( V3f( 0, 0, 150 ), M_PI / 4.0f, 0.1f, 1000.0f );
+	const BoundingVolumeHierarchy::Planes planes = BoundingVolumeHierarchy::frustumPlanes( camera, Box2f( V2f( -0.1 ), V2f( 0.1 ) ) );
+
+	// The first query builds the tree, and subsequent ones
+	// are representative of redraws.
+	vector<size_t> ids;
+	for( int i = 0; i < 100; ++i )
+	{
+		bvh.query( planes, ids );
+	}
+}
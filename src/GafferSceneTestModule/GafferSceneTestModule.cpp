@@ -37,6 +37,7 @@
 
 #include "boost/python.hpp"
 
+#include "GafferSceneTest/BoundingVolumeHierarchyTest.h"
 #include "GafferSceneTest/ContextSanitiser.h"
 #include "GafferSceneTest/CompoundObjectSource.h"
 #include "GafferSceneTest/ScenePlugTest.h"
@@ -74,5 +75,7 @@ BOOST_PYTHON_MODULE( _GafferSceneTest )
 	def( "connectTraverseSceneToPreDispatchSignal", &connectTraverseSceneToPreDispatchSignal );
 
 	def( "testManyStringToPathCalls", &testManyStringToPathCalls );
+	def( "testBoundingVolumeHierarchy", &testBoundingVolumeHierarchy );
+	def( "testBoundingVolumeHierarchyPerformance", &testBoundingVolumeHierarchyPerformance );
 
 }
@@ -472,6 +472,14 @@ void SceneGadget::doRenderLayer( Layer layer, const GafferUI::Style *style ) con
 		return;
 	}
 
+	// Prioritise updates to the part of the scene we're looking at,
+	// so that it fills in first when the scene is large.
+	M44f modelView;
+	M44f projection;
+	glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+	glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+	m_controller.setPriorityView( modelView * projection );
+
 	const_cast<SceneGadget *>( this )->updateRenderer();
 	renderScene();
 }
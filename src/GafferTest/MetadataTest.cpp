@@ -38,6 +38,7 @@
 
 #include "GafferTest/Assert.h"
 
+#include "Gaffer/FilteredRecursiveChildIterator.h"
 #include "Gaffer/Metadata.h"
 #include "Gaffer/Node.h"
 #include "Gaffer/Plug.h"
@@ -81,3 +82,21 @@ void GafferTest::testMetadataThreading()
 	TestThreading t;
 	parallel_for( blocked_range<size_t>( 0, 10000 ), t );
 }
+
+size_t GafferTest::testMetadataValuePerformance( const Gaffer::GraphComponent *root, IECore::InternedString key, bool bulk )
+{
+	if( bulk )
+	{
+		return Metadata::plugValues( root, key ).size();
+	}
+
+	size_t result = 0;
+	for( FilteredRecursiveChildIterator<TypePredicate<Plug>> it( root ); !it.done(); ++it )
+	{
+		if( Metadata::value<Data>( it->get(), key ) )
+		{
+			result++;
+		}
+	}
+	return result;
+}
@@ -45,7 +45,9 @@
 #include "GafferTest/MultiplyNode.h"
 #include "GafferTest/RecursiveChildIteratorTest.h"
 
+#include "GraphComponentTest.h"
 #include "LRUCacheTest.h"
+#include "SpreadsheetTest.h"
 #include "TaskMutexTest.h"
 #include "ValuePlugTest.h"
 
@@ -61,6 +63,12 @@ static void testMetadataThreadingWrapper()
 	testMetadataThreading();
 }
 
+static size_t testMetadataValuePerformanceWrapper( const Gaffer::GraphComponent &root, const std::string &key, bool bulk )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return testMetadataValuePerformance( &root, key, bulk );
+}
+
 BOOST_PYTHON_MODULE( _GafferTest )
 {
 
@@ -69,6 +77,7 @@ BOOST_PYTHON_MODULE( _GafferTest )
 	def( "testRecursiveChildIterator", &testRecursiveChildIterator );
 	def( "testFilteredRecursiveChildIterator", &testFilteredRecursiveChildIterator );
 	def( "testMetadataThreading", &testMetadataThreadingWrapper );
+	def( "testMetadataValuePerformance", &testMetadataValuePerformanceWrapper );
 	def( "testManyContexts", &testManyContexts );
 	def( "testManySubstitutions", &testManySubstitutions );
 	def( "testManyEnvironmentSubstitutions", &testManyEnvironmentSubstitutions );
@@ -80,5 +89,7 @@ BOOST_PYTHON_MODULE( _GafferTest )
 	bindTaskMutexTest();
 	bindLRUCacheTest();
 	bindValuePlugTest();
+	bindGraphComponentTest();
+	bindSpreadsheetTest();
 
 }
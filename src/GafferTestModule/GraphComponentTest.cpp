@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+#include "boost/python.hpp"
+
+#include "GraphComponentTest.h"
+
+#include "GafferTest/Assert.h"
+
+#include "Gaffer/GraphComponent.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+
+namespace
+{
+
+void testGraphComponentGetChildPerformance( int numChildren, int numIterations )
+{
+	GraphComponentPtr parent = new GraphComponent;
+	std::vector<IECore::InternedString> names;
+	for( int i = 0; i < numChildren; ++i )
+	{
+		names.push_back( "child" + std::to_string( i ) );
+		parent->addChild( new GraphComponent( names.back() ) );
+	}
+
+	for( int j = 0; j < numIterations; ++j )
+	{
+		for( int i = 0; i < numChildren; ++i )
+		{
+			GAFFERTEST_ASSERT( parent->getChild( names[i] ) == parent->getChild( i ) );
+		}
+	}
+}
+
+void testGraphComponentUniqueNamesPerformance( int numChildren )
+{
+	GraphComponentPtr parent = new GraphComponent;
+	for( int i = 0; i < numChildren; ++i )
+	{
+		GraphComponentPtr child = new GraphComponent( "child" );
+		parent->addChild( child );
+		GAFFERTEST_ASSERTEQUAL( child->getName().string(), i ? "child" + std::to_string( i ) : "child" );
+	}
+}
+
+} // namespace
+
+void GafferTestModule::bindGraphComponentTest()
+{
+	def( "testGraphComponentGetChildPerformance", &testGraphComponentGetChildPerformance );
+	def( "testGraphComponentUniqueNamesPerformance", &testGraphComponentUniqueNamesPerformance );
+}
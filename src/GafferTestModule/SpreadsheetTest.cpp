@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2020, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+#include "boost/python.hpp"
+
+#include "SpreadsheetTest.h"
+
+#include "GafferTest/Assert.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Spreadsheet.h"
+#include "Gaffer/StringPlug.h"
+
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "tbb/parallel_for.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+
+namespace
+{
+
+// Emulates a spreadsheet driven by `${scene:path}`, with
+// `numLookups` distinct selector values.
+void testSpreadsheetSelectorPerformance( int numRows, int numLookups )
+{
+	SpreadsheetPtr spreadsheet = new Spreadsheet;
+	spreadsheet->selectorPlug()->setValue( "${testSelector}" );
+	spreadsheet->rowsPlug()->addColumn( new IntPlug( "value" ) );
+	for( int i = 1; i <= numRows; ++i )
+	{
+		Spreadsheet::RowPlug *row = spreadsheet->rowsPlug()->addRow();
+		row->namePlug()->setValue( "/row" + std::to_string( i ) );
+		row->cellsPlug()->getChild<Spreadsheet::CellPlug>( 0 )->valuePlug<IntPlug>()->setValue( i );
+	}
+
+	const IntPlug *out = spreadsheet->outPlug()->getChild<IntPlug>( 0 );
+
+	IECorePython::ScopedGILRelease gilRelease;
+
+	const ThreadState &threadState = ThreadState::current();
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, numLookups ),
+		[&threadState, out, numRows]( const tbb::blocked_range<int> &r ) {
+			Context::EditableScope scope( threadState );
+			for( int i = r.begin(); i < r.end(); ++i )
+			{
+				// Every other lookup misses, selecting the default row.
+				const int row = i % ( numRows * 2 );
+				scope.set( "testSelector", std::string( row <= numRows ? "/row" : "/missing" ) + std::to_string( row ) );
+				GAFFERTEST_ASSERTEQUAL( out->getValue(), row && row <= numRows ? row : 0 );
+			}
+		}
+	);
+}
+
+} // namespace
+
+void GafferTestModule::bindSpreadsheetTest()
+{
+	def( "testSpreadsheetSelectorPerformance", &testSpreadsheetSelectorPerformance );
+}
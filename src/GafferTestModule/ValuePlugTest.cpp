@@ -40,8 +40,13 @@
 
 #include "GafferTest/MultiplyNode.h"
 
+#include "Gaffer/Context.h"
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/StringPlug.h"
 #include "Gaffer/ValuePlug.h"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "tbb/parallel_for.h"
 
 using namespace boost::python;
@@ -66,9 +71,50 @@ void testValuePlugContentionForOneItem()
 	);
 }
 
+template<typename PlugType>
+void parallelGetValueInternal( const PlugType *plug, int iterations, const IECore::InternedString &iterationVar )
+{
+	const ThreadState &threadState = ThreadState::current();
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, iterations ),
+		[&threadState, plug, &iterationVar]( const tbb::blocked_range<int> &r ) {
+			Context::EditableScope scope( threadState );
+			for( int i = r.begin(); i < r.end(); ++i )
+			{
+				scope.set( iterationVar, i );
+				plug->getValue();
+			}
+		}
+	);
+}
+
+// Evaluates `plug` in parallel, once for each of `iterations` contexts
+// with distinct values for the `iterationVar` variable.
+void parallelGetValue( const ValuePlug *plug, int iterations, const std::string &iterationVar )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	if( auto intPlug = IECore::runTimeCast<const IntPlug>( plug ) )
+	{
+		parallelGetValueInternal( intPlug, iterations, iterationVar );
+	}
+	else if( auto floatPlug = IECore::runTimeCast<const FloatPlug>( plug ) )
+	{
+		parallelGetValueInternal( floatPlug, iterations, iterationVar );
+	}
+	else if( auto stringPlug = IECore::runTimeCast<const StringPlug>( plug ) )
+	{
+		parallelGetValueInternal( stringPlug, iterations, iterationVar );
+	}
+	else
+	{
+		throw IECore::Exception( "Unsupported plug type" );
+	}
+}
+
 } // namespace
 
 void GafferTestModule::bindValuePlugTest()
 {
 	def( "testValuePlugContentionForOneItem", &testValuePlugContentionForOneItem );
+	def( "parallelGetValue", &parallelGetValue, ( arg( "plug" ), arg( "iterations" ), arg( "iterationVar" ) = "iteration" ) );
 }
@@ -36,6 +36,8 @@
 
 #include "GafferVDB/LevelSetOffset.h"
 
+#include "GafferVDB/Interrupter.h"
+
 #include "IECoreVDB/VDBObject.h"
 
 #include "Gaffer/StringPlug.h"
@@ -50,6 +52,36 @@ using namespace IECoreVDB;
 using namespace Gaffer;
 using namespace GafferVDB;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+template<typename GridType>
+openvdb::GridBase::Ptr offsetGrid( const GridType &grid, float offset, const IECore::Canceller *canceller )
+{
+	// The offset modifies every active voxel, so unlike the other
+	// grids in the object, this one can't be shared with the input.
+	typename GridType::Ptr result = grid.deepCopy();
+
+	Interrupter interrupter( canceller );
+	openvdb::tools::LevelSetFilter<GridType, typename GridType::template ValueConverter<float>::Type, Interrupter> filter( *result, &interrupter );
+	filter.offset( offset );
+
+	// If we were interrupted, the grid is incomplete and must not be returned.
+	Canceller::check( canceller );
+
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// LevelSetOffset
+//////////////////////////////////////////////////////////////////////////
+
 GAFFER_GRAPHCOMPONENT_DEFINE_TYPE( LevelSetOffset );
 
 size_t LevelSetOffset::g_firstPlugIndex = 0;
@@ -105,6 +137,14 @@ bool LevelSetOffset::processesObject() const
 
 void LevelSetOffset::hashProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
+	if( offsetPlug()->getValue() == 0.0f )
+	{
+		// We pass the input object through unchanged. Using the input
+		// hash means we share its cache entry rather than duplicating it.
+		h = inPlug()->objectPlug()->hash();
+		return;
+	}
+
 	SceneElementProcessor::hashProcessedObject( path, context, h );
 
 	gridPlug()->hash( h );
@@ -119,6 +159,12 @@ IECore::ConstObjectPtr LevelSetOffset::computeProcessedObject( const ScenePath &
 		return inputObject;
 	}
 
+	const float offset = offsetPlug()->getValue();
+	if( offset == 0.0f )
+	{
+		return inputObject;
+	}
+
 	std::string gridName = gridPlug()->getValue();
 
 	openvdb::GridBase::ConstPtr gridBase = vdbObject->findGrid( gridName );
@@ -132,23 +178,19 @@ IECore::ConstObjectPtr LevelSetOffset::computeProcessedObject( const ScenePath &
 
 	if ( openvdb::FloatGrid::ConstPtr floatGrid = openvdb::GridBase::constGrid<openvdb::FloatGrid>( gridBase ) )
 	{
-		openvdb::FloatGrid::Ptr newFloatGrid = openvdb::GridBase::grid<openvdb::FloatGrid> ( floatGrid->deepCopyGrid() );
-		newGrid = newFloatGrid;
-		openvdb::tools::LevelSetFilter <openvdb::FloatGrid> filter( *newFloatGrid );
-		filter.offset( offsetPlug()->getValue() );
+		newGrid = offsetGrid( *floatGrid, offset, context->canceller() );
 	}
-	else if ( openvdb::DoubleGrid::ConstPtr doubleGrid = openvdb::GridBase::constGrid<openvdb::DoubleGrid>( newGrid ) )
+	else if ( openvdb::DoubleGrid::ConstPtr doubleGrid = openvdb::GridBase::constGrid<openvdb::DoubleGrid>( gridBase ) )
 	{
-		openvdb::DoubleGrid::Ptr newDoubleGrid = openvdb::GridBase::grid<openvdb::DoubleGrid>( doubleGrid->deepCopyGrid() );
-		newGrid = newDoubleGrid;
-		openvdb::tools::LevelSetFilter <openvdb::DoubleGrid> filter( *newDoubleGrid );
-		filter.offset( offsetPlug()->getValue() );
+		newGrid = offsetGrid( *doubleGrid, offset, context->canceller() );
 	}
 	else
 	{
-		throw IECore::Exception( boost::str( boost::format( "Unable to Offset LevelSet grid: '%1%' with type: %2% " ) % gridName % newGrid->type()) );
+		throw IECore::Exception( boost::str( boost::format( "Unable to Offset LevelSet grid: '%1%' with type: %2% " ) % gridName % gridBase->type()) );
 	}
 
+	// Copying the VDBObject only copies pointers to its grids, so all
+	// grids other than the one we're replacing are shared with the input.
 	VDBObjectPtr newVDBObject = vdbObject->copy();
 
 	newVDBObject->insertGrid( newGrid );
@@ -43,6 +43,7 @@
 #include "IECoreScene/MeshPrimitive.h"
 
 #include "openvdb/openvdb.h"
+#include "openvdb/tools/Clip.h"
 #include "openvdb/tools/VolumeToMesh.h"
 
 #include "boost/mpl/for_each.hpp"
@@ -65,7 +66,7 @@ namespace
 
 struct MesherDispatch
 {
-	MesherDispatch( openvdb::GridBase::ConstPtr grid, openvdb::tools::VolumeToMesh &mesher ) : m_grid( grid ), m_mesher( mesher )
+	MesherDispatch( openvdb::GridBase::ConstPtr grid, openvdb::tools::VolumeToMesh &mesher, const openvdb::BBoxd *clipBound ) : m_grid( grid ), m_mesher( mesher ), m_clipBound( clipBound )
 	{
 	}
 
@@ -74,12 +75,23 @@ struct MesherDispatch
 	{
 		if( typename GridType::ConstPtr t = openvdb::GridBase::constGrid<GridType>( m_grid ) )
 		{
-			m_mesher( *t );
+			if( m_clipBound )
+			{
+				// Clipping only visits the parts of the tree overlapping the
+				// bound, so leaves outside it are never loaded or meshed.
+				typename GridType::Ptr clipped = openvdb::tools::clip( *t, *m_clipBound );
+				m_mesher( *clipped );
+			}
+			else
+			{
+				m_mesher( *t );
+			}
 		}
 	}
 
 	openvdb::GridBase::ConstPtr m_grid;
 	openvdb::tools::VolumeToMesh &m_mesher;
+	const openvdb::BBoxd *m_clipBound;
 };
 
 static std::map<std::string, std::function<void( MesherDispatch& dispatch )> > meshers =
@@ -92,10 +104,10 @@ static std::map<std::string, std::function<void( MesherDispatch& dispatch )> > m
 };
 
 
-IECoreScene::MeshPrimitivePtr volumeToMesh( openvdb::GridBase::ConstPtr grid, double isoValue, double adaptivity )
+IECoreScene::MeshPrimitivePtr volumeToMesh( openvdb::GridBase::ConstPtr grid, double isoValue, double adaptivity, const openvdb::BBoxd *clipBound )
 {
 	openvdb::tools::VolumeToMesh mesher( isoValue, adaptivity );
-	MesherDispatch dispatch( grid, mesher );
+	MesherDispatch dispatch( grid, mesher, clipBound );
 
 	const auto it = meshers.find( grid->valueType() );
 	if( it != meshers.end() )
@@ -182,7 +194,8 @@ LevelSetToMesh::LevelSetToMesh( const std::string &name )
 	addChild( new StringPlug( "grid", Plug::In, "surface" ) );
 	addChild( new FloatPlug( "isoValue", Plug::In, 0.0f ) );
 	addChild( new FloatPlug( "adaptivity", Plug::In, 0.0f, 0.0f, 1.0f ) );
-
+	addChild( new BoolPlug( "clip", Plug::In, false ) );
+	addChild( new Box3fPlug( "clipBound", Plug::In, Box3f( V3f( -1 ), V3f( 1 ) ) ) );
 }
 
 LevelSetToMesh::~LevelSetToMesh()
@@ -220,6 +233,26 @@ const Gaffer::FloatPlug *LevelSetToMesh::adaptivityPlug() const
 	return getChild<FloatPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::BoolPlug *LevelSetToMesh::clipPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::BoolPlug *LevelSetToMesh::clipPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+Gaffer::Box3fPlug *LevelSetToMesh::clipBoundPlug()
+{
+	return getChild<Box3fPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::Box3fPlug *LevelSetToMesh::clipBoundPlug() const
+{
+	return getChild<Box3fPlug>( g_firstPlugIndex + 4 );
+}
+
 void LevelSetToMesh::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
@@ -227,11 +260,18 @@ void LevelSetToMesh::affects( const Gaffer::Plug *input, AffectedPlugsContainer
 	if(
 		input == isoValuePlug() ||
 		input == adaptivityPlug() ||
-		input == gridPlug()
+		input == gridPlug() ||
+		input == clipPlug() ||
+		clipBoundPlug()->isAncestorOf( input )
 	)
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
+
+	if( input == clipPlug() || clipBoundPlug()->isAncestorOf( input ) )
+	{
+		outputs.push_back( outPlug()->boundPlug() );
+	}
 }
 
 bool LevelSetToMesh::processesObject() const
@@ -246,6 +286,11 @@ void LevelSetToMesh::hashProcessedObject( const ScenePath &path, const Gaffer::C
 	gridPlug()->hash( h );
 	isoValuePlug()->hash( h );
 	adaptivityPlug()->hash( h );
+	clipPlug()->hash( h );
+	if( clipPlug()->getValue() )
+	{
+		clipBoundPlug()->hash( h );
+	}
 }
 
 IECore::ConstObjectPtr LevelSetToMesh::computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const
@@ -263,7 +308,17 @@ IECore::ConstObjectPtr LevelSetToMesh::computeProcessedObject( const ScenePath &
 		return inputObject;
 	}
 
-	return volumeToMesh( grid, isoValuePlug()->getValue(), adaptivityPlug()->getValue() );
+	if( clipPlug()->getValue() )
+	{
+		const Box3f clipBound = clipBoundPlug()->getValue();
+		const openvdb::BBoxd vdbClipBound(
+			openvdb::Vec3d( clipBound.min.x, clipBound.min.y, clipBound.min.z ),
+			openvdb::Vec3d( clipBound.max.x, clipBound.max.y, clipBound.max.z )
+		);
+		return volumeToMesh( grid, isoValuePlug()->getValue(), adaptivityPlug()->getValue(), &vdbClipBound );
+	}
+
+	return volumeToMesh( grid, isoValuePlug()->getValue(), adaptivityPlug()->getValue(), nullptr );
 }
 
 bool LevelSetToMesh::processesBound() const
@@ -277,6 +332,11 @@ void LevelSetToMesh::hashProcessedBound( const ScenePath &path, const Gaffer::Co
 
 	gridPlug()->hash( h );
 	isoValuePlug()->hash( h );
+	clipPlug()->hash( h );
+	if( clipPlug()->getValue() )
+	{
+		clipBoundPlug()->hash( h );
+	}
 }
 
 Imath::Box3f LevelSetToMesh::computeProcessedBound( const ScenePath &path, const Gaffer::Context *context, const Imath::Box3f &inputBound ) const
@@ -287,5 +347,19 @@ Imath::Box3f LevelSetToMesh::computeProcessedBound( const ScenePath &path, const
 	newBound.min -= Imath::V3f(offset, offset, offset);
 	newBound.max += Imath::V3f(offset, offset, offset);
 
+	if( clipPlug()->getValue() )
+	{
+		const Box3f clipBound = clipBoundPlug()->getValue();
+		for( int i = 0; i < 3; ++i )
+		{
+			newBound.min[i] = std::max( newBound.min[i], clipBound.min[i] );
+			newBound.max[i] = std::min( newBound.max[i], clipBound.max[i] );
+		}
+		if( newBound.isEmpty() )
+		{
+			return Box3f();
+		}
+	}
+
 	return newBound;
 }
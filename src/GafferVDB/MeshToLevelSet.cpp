@@ -36,6 +36,10 @@
 
 #include "GafferVDB/MeshToLevelSet.h"
 
+#include "GafferVDB/Interrupter.h"
+
+#include "GafferScene/SceneAlgo.h"
+
 #include "IECoreVDB/VDBObject.h"
 
 #include "Gaffer/StringPlug.h"
@@ -45,12 +49,16 @@
 #include "openvdb/openvdb.h"
 #include "openvdb/tools/MeshToVolume.h"
 
+#include "tbb/concurrent_vector.h"
+#include "tbb/parallel_for.h"
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
 using namespace IECoreVDB;
 using namespace Gaffer;
+using namespace GafferScene;
 using namespace GafferVDB;
 
 //////////////////////////////////////////////////////////////////////////
@@ -60,36 +68,87 @@ using namespace GafferVDB;
 namespace
 {
 
+struct MeshLocation
+{
+	ScenePlug::ScenePath path;
+	IECoreScene::ConstMeshPrimitivePtr mesh;
+	M44f transform;
+};
+
+// Orders paths by name rather than by InternedString address,
+// so that the order is the same in every process.
+bool pathLess( const ScenePlug::ScenePath &a, const ScenePlug::ScenePath &b )
+{
+	return std::lexicographical_compare(
+		a.begin(), a.end(), b.begin(), b.end(),
+		[]( const InternedString &x, const InternedString &y ) { return x.string() < y.string(); }
+	);
+}
+
+// Adapts any number of meshes for use with `openvdb::tools::meshToVolume()`,
+// which converts them all in parallel into a single grid.
 struct CortexMeshAdapter
 {
 
-	CortexMeshAdapter( const MeshPrimitive *mesh, const openvdb::math::Transform *transform )
-		:	m_numFaces( mesh->numFaces() ),
-			m_numVertices( mesh->variableSize( PrimitiveVariable::Vertex ) ),
-			m_verticesPerFace( mesh->verticesPerFace()->readable() ),
-			m_vertexIds( mesh->vertexIds()->readable() ),
-			m_transform( transform )
+	CortexMeshAdapter( const vector<MeshLocation> &meshes, const openvdb::math::Transform *transform )
 	{
-		size_t offset = 0;
-		m_faceOffsets.reserve( m_numFaces );
-		for( vector<int>::const_iterator it = m_verticesPerFace.begin(), eIt = m_verticesPerFace.end(); it != eIt; ++it )
+		vector<size_t> pointOffsets;
+		pointOffsets.reserve( meshes.size() );
+		size_t numPoints = 0;
+		for( const auto &m : meshes )
 		{
-			m_faceOffsets.push_back( offset );
-			offset += *it;
+			pointOffsets.push_back( numPoints );
+			numPoints += m.mesh->variableSize( PrimitiveVariable::Vertex );
+
+			const vector<int> &verticesPerFace = m.mesh->verticesPerFace()->readable();
+			const vector<int> &vertexIds = m.mesh->vertexIds()->readable();
+			size_t offset = m_vertexIds.size();
+			for( int n : verticesPerFace )
+			{
+				m_verticesPerFace.push_back( n );
+				m_faceOffsets.push_back( offset );
+				offset += n;
+			}
+			for( int id : vertexIds )
+			{
+				m_vertexIds.push_back( id + pointOffsets.back() );
+			}
 		}
 
-		const V3fVectorData *points = mesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex );
-		m_points = &points->readable();
+		// Transform all the points into index space up front, rather than
+		// once per face they belong to.
+		m_points.resize( numPoints );
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, meshes.size() ),
+			[&meshes, &pointOffsets, transform, this]( const tbb::blocked_range<size_t> &r ) {
+				for( size_t i = r.begin(); i != r.end(); ++i )
+				{
+					const M44f &matrix = meshes[i].transform;
+					const vector<V3f> &points = meshes[i].mesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex )->readable();
+					openvdb::Vec3d *indexPoints = m_points.data() + pointOffsets[i];
+					tbb::parallel_for(
+						tbb::blocked_range<size_t>( 0, points.size(), 1000 ),
+						[&matrix, &points, indexPoints, transform]( const tbb::blocked_range<size_t> &pr ) {
+							for( size_t j = pr.begin(); j != pr.end(); ++j )
+							{
+								const V3f p = points[j] * matrix;
+								indexPoints[j] = transform->worldToIndex( openvdb::math::Vec3s( p.x, p.y, p.z ) );
+							}
+						}
+					);
+				}
+			}
+		);
 	}
 
 	size_t polygonCount() const
 	{
-		return m_numFaces;
+		return m_verticesPerFace.size();
 	}
 
 	size_t pointCount() const
 	{
-		return m_numVertices;
+		return m_points.size();
 	}
 
 	size_t vertexCount( size_t polygonIndex ) const
@@ -100,20 +159,94 @@ struct CortexMeshAdapter
 	// Return position pos in local grid index space for polygon n and vertex v
 	void getIndexSpacePoint( size_t polygonIndex, size_t polygonVertexIndex, openvdb::Vec3d &pos ) const
 	{
-		/// \todo Threaded pretransform in constructor?
-		const V3f p = (*m_points)[ m_vertexIds[ m_faceOffsets[polygonIndex] + polygonVertexIndex ] ];
-		pos = m_transform->worldToIndex( openvdb::math::Vec3s( p.x, p.y, p.z ) );
+		pos = m_points[ m_vertexIds[ m_faceOffsets[polygonIndex] + polygonVertexIndex ] ];
 	}
 
 	private :
 
-		const size_t m_numFaces;
-		const size_t m_numVertices;
-		const vector<int> &m_verticesPerFace;
-		const vector<int> &m_vertexIds;
-		vector<int> m_faceOffsets;
-		const vector<V3f> *m_points;
-		const openvdb::math::Transform *m_transform;
+		vector<int> m_verticesPerFace;
+		vector<int> m_vertexIds;
+		vector<size_t> m_faceOffsets;
+		vector<openvdb::Vec3d> m_points;
+
+};
+
+// Used with `SceneAlgo::parallelProcessLocations()` to find the meshes
+// at and below a location, along with their transforms relative to it.
+struct MeshGatherer
+{
+
+	MeshGatherer( tbb::concurrent_vector<MeshLocation> &meshes, size_t rootSize )
+		:	m_meshes( meshes ), m_rootSize( rootSize )
+	{
+	}
+
+	MeshGatherer( const MeshGatherer &parent )
+		:	m_meshes( parent.m_meshes ), m_rootSize( parent.m_rootSize ), m_transform( parent.m_transform )
+	{
+	}
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		if( path.size() > m_rootSize )
+		{
+			m_transform = scene->transformPlug()->getValue() * m_transform;
+		}
+
+		ConstObjectPtr object = scene->objectPlug()->getValue();
+		if( auto mesh = runTimeCast<const MeshPrimitive>( object.get() ) )
+		{
+			m_meshes.push_back( { path, mesh, m_transform } );
+		}
+
+		return true;
+	}
+
+	private :
+
+		tbb::concurrent_vector<MeshLocation> &m_meshes;
+		const size_t m_rootSize;
+		M44f m_transform;
+
+};
+
+// As above, but computing a hash for each location instead.
+struct MeshHasher
+{
+
+	typedef std::pair<ScenePlug::ScenePath, MurmurHash> Location;
+
+	MeshHasher( tbb::concurrent_vector<Location> &locations, size_t rootSize )
+		:	m_locations( locations ), m_rootSize( rootSize )
+	{
+	}
+
+	MeshHasher( const MeshHasher &parent )
+		:	m_locations( parent.m_locations ), m_rootSize( parent.m_rootSize )
+	{
+	}
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		MurmurHash h;
+		for( size_t i = m_rootSize; i < path.size(); ++i )
+		{
+			h.append( path[i].c_str() );
+		}
+		if( path.size() > m_rootSize )
+		{
+			scene->transformPlug()->hash( h );
+		}
+		scene->objectPlug()->hash( h );
+
+		m_locations.push_back( { path, h } );
+		return true;
+	}
+
+	private :
+
+		tbb::concurrent_vector<Location> &m_locations;
+		const size_t m_rootSize;
 
 };
 
@@ -136,6 +269,7 @@ MeshToLevelSet::MeshToLevelSet( const std::string &name )
 	addChild( new FloatPlug( "voxelSize", Plug::In, 0.1f, 0.0001f ) );
 	addChild( new FloatPlug( "exteriorBandwidth", Plug::In, 3.0f, 0.0001f ) );
 	addChild( new FloatPlug( "interiorBandwidth", Plug::In, 3.0f, 0.0001f ) );
+	addChild( new BoolPlug( "mergeDescendants" ) );
 }
 
 MeshToLevelSet::~MeshToLevelSet()
@@ -182,11 +316,29 @@ const FloatPlug *MeshToLevelSet::interiorBandwidthPlug() const
 	return getChild<FloatPlug>( g_firstPlugIndex + 3 );
 }
 
+BoolPlug *MeshToLevelSet::mergeDescendantsPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
+const BoolPlug *MeshToLevelSet::mergeDescendantsPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
 void MeshToLevelSet::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
 
-	if( input == voxelSizePlug() || input == gridPlug() )
+	if(
+		input == voxelSizePlug() ||
+		input == gridPlug() ||
+		input == exteriorBandwidthPlug() ||
+		input == interiorBandwidthPlug() ||
+		input == mergeDescendantsPlug() ||
+		input == inPlug()->transformPlug() ||
+		input == inPlug()->childNamesPlug()
+	)
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
@@ -205,14 +357,51 @@ void MeshToLevelSet::hashProcessedObject( const ScenePath &path, const Gaffer::C
 	voxelSizePlug()->hash( h );
 	exteriorBandwidthPlug()->hash ( h );
 	interiorBandwidthPlug()->hash ( h );
+
+	if( mergeDescendantsPlug()->getValue() )
+	{
+		tbb::concurrent_vector<MeshHasher::Location> locations;
+		MeshHasher hasher( locations, path.size() );
+		SceneAlgo::parallelProcessLocations( inPlug(), hasher, path );
+
+		std::sort(
+			locations.begin(), locations.end(),
+			[]( const MeshHasher::Location &a, const MeshHasher::Location &b ) { return pathLess( a.first, b.first ); }
+		);
+		for( const auto &location : locations )
+		{
+			h.append( location.second );
+		}
+	}
 }
 
 IECore::ConstObjectPtr MeshToLevelSet::computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const
 {
-	const MeshPrimitive *mesh = runTimeCast<const MeshPrimitive>( inputObject.get() );
-	if( !mesh )
+	vector<MeshLocation> meshes;
+	if( mergeDescendantsPlug()->getValue() )
 	{
-		return inputObject;
+		tbb::concurrent_vector<MeshLocation> gathered;
+		MeshGatherer gatherer( gathered, path.size() );
+		SceneAlgo::parallelProcessLocations( inPlug(), gatherer, path );
+		if( gathered.empty() )
+		{
+			return inputObject;
+		}
+
+		meshes.assign( gathered.begin(), gathered.end() );
+		std::sort(
+			meshes.begin(), meshes.end(),
+			[]( const MeshLocation &a, const MeshLocation &b ) { return pathLess( a.path, b.path ); }
+		);
+	}
+	else
+	{
+		const MeshPrimitive *mesh = runTimeCast<const MeshPrimitive>( inputObject.get() );
+		if( !mesh )
+		{
+			return inputObject;
+		}
+		meshes.push_back( { path, mesh, M44f() } );
 	}
 
 	const float voxelSize = voxelSizePlug()->getValue();
@@ -221,8 +410,10 @@ IECore::ConstObjectPtr MeshToLevelSet::computeProcessedObject( const ScenePath &
 
 	openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform( voxelSize );
 
+	Interrupter interrupter( context->canceller() );
 	openvdb::FloatGrid::Ptr grid = openvdb::tools::meshToVolume<openvdb::FloatGrid>(
-		CortexMeshAdapter( mesh, transform.get() ),
+		interrupter,
+		CortexMeshAdapter( meshes, transform.get() ),
 		*transform,
 		exteriorBandwidth, //in voxel units
 		interiorBandwidth, //in voxel units
@@ -230,6 +421,9 @@ IECore::ConstObjectPtr MeshToLevelSet::computeProcessedObject( const ScenePath &
 		//primitiveIndexGrid.get()
 	);
 
+	// If we were interrupted, the grid is incomplete and must not be returned.
+	Canceller::check( context->canceller() );
+
 	grid->setName( gridPlug()->getValue() );
 
 	VDBObjectPtr newVDBObject =  new VDBObject();
@@ -150,20 +150,21 @@ void convert(Imath::Quatd& dest, const openvdb::math::Quatd& src)
 	dest = Imath::Quatd( src[3], src[0], src[1], src[2]);
 }
 
-typedef openvdb::points::PointDataGrid::TreeType::LeafCIter LeafIter;
+// Indices of the points to be extracted from a single leaf.
+typedef std::vector<openvdb::Index> Indices;
 
 template<typename CortexType, typename VDBType, template <typename P> class StorageType = IECore::TypedData>
-void appendData(IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)
+void appendData(IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )
 {
 	auto cortexData = IECore::runTimeCast<StorageType<std::vector<CortexType> > > ( destArray );
 	auto &writable = cortexData->writable();
 
 	openvdb::points::AttributeHandle<VDBType> attributeHandle( array );
 
-	for( auto indexIter = leafIter->beginIndexOn(); indexIter; ++indexIter )
+	for( auto index : indices )
 	{
 		CortexType d;
-		convert(d, attributeHandle.get( *indexIter ));
+		convert(d, attributeHandle.get( index ));
 		writable.push_back( d );
 	}
 };
@@ -184,7 +185,7 @@ struct Functions
 		void (
 			IECore::Data *,
 			const openvdb::points::AttributeArray&,
-			LeafIter
+			const Indices &
 		)
 	> AppendFn;
 
@@ -201,42 +202,42 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<half>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<half>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<half, half>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<half, half>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<float>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<float>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<float, float>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<float, float>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<double>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<double>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<double, double>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<double, double>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<uint8_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint8_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint8_t, uint8_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<uint8_t, uint8_t>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<uint16_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint16_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint16_t, uint16_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<uint16_t, uint16_t>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<uint32_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint32_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint32_t, uint32_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<uint32_t, uint32_t>( destArray, array, indices ); }
 		)
 	},
 	// todo check this function
@@ -244,21 +245,21 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<uint8_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<uint8_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<uint8_t, int8_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<uint8_t, int8_t>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<int16_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<int16_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<int16_t, int16_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<int16_t, int16_t>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<int32_t>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<int32_t>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<int32_t, int32_t>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<int32_t, int32_t>( destArray, array, indices ); }
 		)
 	},
 
@@ -267,21 +268,21 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::Vec2i>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V2i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V2i, openvdb::Vec2i, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V2i, openvdb::Vec2i, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec2s>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V2f, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V2f, openvdb::Vec2s, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V2f, openvdb::Vec2s, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec2d>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V2d, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V2d, openvdb::Vec2d, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V2d, openvdb::Vec2d, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	// Vec3 u8, 16, int, single, double
@@ -289,42 +290,42 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::Vec3U8>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3i, openvdb::Vec3U8, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V3i, openvdb::Vec3U8, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3U16>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3i, openvdb::Vec3U16, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V3i, openvdb::Vec3U16, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3i>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3i, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3i, openvdb::Vec3i, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V3i, openvdb::Vec3i, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3s>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3f, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3f, openvdb::Vec3s, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V3f, openvdb::Vec3s, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Vec3d>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::V3d, IECore::GeometricTypedData>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::V3d, openvdb::Vec3d, IECore::GeometricTypedData>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::V3d, openvdb::Vec3d, IECore::GeometricTypedData>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<std::string>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<std::string>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<std::string, std::string>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<std::string, std::string>( destArray, array, indices ); }
 		)
 	},
 	// matrix conversion - single & double
@@ -332,14 +333,14 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::Mat4s>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::M44f>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::M44f, openvdb::Mat4s>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::M44f, openvdb::Mat4s>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::Mat4d>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::M44d>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::M44d, openvdb::Mat4d>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::M44d, openvdb::Mat4d>( destArray, array, indices ); }
 		)
 	},
 
@@ -348,14 +349,14 @@ const std::map<std::string, Functions >  converters =
 		openvdb::typeNameAsString<openvdb::math::Quats>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::Quatf>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::Quatf, openvdb::math::Quats>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::Quatf, openvdb::math::Quats>( destArray, array, indices ); }
 		)
 	},
 	{
 		openvdb::typeNameAsString<openvdb::math::Quatd>(),
 		Functions(
 			[](size_t size) -> IECore::DataPtr { return createArray<Imath::Quatd>(size); },
-			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, LeafIter leafIter)  { appendData<Imath::Quatd, openvdb::math::Quatd>( destArray, array, leafIter ); }
+			[](IECore::Data *destArray, const openvdb::points::AttributeArray& array, const Indices &indices )  { appendData<Imath::Quatd, openvdb::math::Quatd>( destArray, array, indices ); }
 		)
 	},
 };
@@ -363,7 +364,7 @@ const std::map<std::string, Functions >  converters =
 void appendPrimitiveVariableData( IECoreScene::PrimitiveVariableMap &variableMap,
 	const std::string &name,
 	const std::string &type,
-	LeafIter leafIter,
+	const Indices &indices,
 	const openvdb::points::AttributeArray &arrayData,
 	uint64_t count)
 {
@@ -387,10 +388,10 @@ void appendPrimitiveVariableData( IECoreScene::PrimitiveVariableMap &variableMap
 		primVar = primVarIt->second;
 	}
 
-	itConverter->second.m_append( primVar.data.get(), arrayData, leafIter);
+	itConverter->second.m_append( primVar.data.get(), arrayData, indices );
 }
 
-IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstPtr baseGrid, std::function<bool( const std::string & )> primitiveVariableFilter )
+IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstPtr baseGrid, std::function<bool( const std::string & )> primitiveVariableFilter, const openvdb::BBoxd *clipBound )
 {
 	openvdb::points::PointDataGrid::ConstPtr pointsGrid = openvdb::GridBase::constGrid<openvdb::points::PointDataGrid>( baseGrid );
 	if( !pointsGrid )
@@ -406,11 +407,51 @@ IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstP
 
 	IECoreScene::PrimitiveVariableMap primVars;
 
+	const openvdb::math::Transform &transform = pointsGrid->transform();
+
+	Indices indices;
 	for( auto leafIter = pointsGrid->tree().cbeginLeaf(); leafIter; ++leafIter )
 	{
+		bool clipPoints = false;
+		if( clipBound )
+		{
+			// Points may lie anywhere within their voxel, so we pad the
+			// voxel-centred node bound by half a voxel. Leaves entirely
+			// outside the clip bound are skipped without touching their
+			// attribute arrays, so they need never be loaded.
+			const openvdb::CoordBBox leafIndexBound = leafIter->getNodeBoundingBox();
+			const openvdb::BBoxd leafBound = transform.indexToWorld(
+				openvdb::BBoxd( leafIndexBound.min().asVec3d() - openvdb::Vec3d( 0.5 ), leafIndexBound.max().asVec3d() + openvdb::Vec3d( 0.5 ) )
+			);
+			if( !clipBound->hasOverlap( leafBound ) )
+			{
+				continue;
+			}
+			clipPoints = !clipBound->isInside( leafBound );
+		}
+
 		const openvdb::points::AttributeArray &array = leafIter->constAttributeArray( "P" );
 		openvdb::points::AttributeHandle<openvdb::Vec3f> positionHandle( array );
 
+		indices.clear();
+		for( auto indexIter = leafIter->beginIndexOn(); indexIter; ++indexIter )
+		{
+			openvdb::Vec3f voxelPosition = positionHandle.get( *indexIter );
+			const openvdb::Vec3d xyz = indexIter.getCoord().asVec3d();
+			openvdb::Vec3f worldPosition = transform.indexToWorld( voxelPosition + xyz );
+			if( clipPoints && !clipBound->isInside( openvdb::Vec3d( worldPosition ) ) )
+			{
+				continue;
+			}
+			indices.push_back( *indexIter );
+			points.emplace_back( worldPosition[0], worldPosition[1], worldPosition[2] );
+		}
+
+		if( indices.empty() )
+		{
+			continue;
+		}
+
 		const openvdb::points::AttributeSet &attributeSet = leafIter->attributeSet();
 		const openvdb::points::AttributeSet::Descriptor &descriptor = attributeSet.descriptor();
 
@@ -423,15 +464,7 @@ IECoreScene::PointsPrimitivePtr createPointsPrimitive( openvdb::GridBase::ConstP
 				continue;
 			}
 			const openvdb::points::AttributeArray *attributeArray = attributeSet.get( index );
-			appendPrimitiveVariableData( primVars, attributeName, descriptor.type( index ).first, leafIter, *attributeArray, count );
-		}
-
-		for( auto indexIter = leafIter->beginIndexOn(); indexIter; ++indexIter )
-		{
-			openvdb::Vec3f voxelPosition = positionHandle.get( *indexIter );
-			const openvdb::Vec3d xyz = indexIter.getCoord().asVec3d();
-			openvdb::Vec3f worldPosition = pointsGrid->transform().indexToWorld( voxelPosition + xyz );
-			points.emplace_back( worldPosition[0], worldPosition[1], worldPosition[2] );
+			appendPrimitiveVariableData( primVars, attributeName, descriptor.type( index ).first, indices, *attributeArray, count );
 		}
 	}
 
@@ -460,6 +493,9 @@ PointsGridToPoints::PointsGridToPoints( const std::string &name ) : SceneElement
 	// 'names' & 'invertNames' match PrimitiveVariableProcessor
 	addChild( new StringPlug( "names" ) );
 	addChild( new BoolPlug( "invertNames" ) );
+
+	addChild( new BoolPlug( "clip" ) );
+	addChild( new Box3fPlug( "clipBound", Plug::In, Box3f( V3f( -1 ), V3f( 1 ) ) ) );
 }
 
 PointsGridToPoints::~PointsGridToPoints()
@@ -496,11 +532,34 @@ const Gaffer::BoolPlug *PointsGridToPoints::invertNamesPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::BoolPlug *PointsGridToPoints::clipPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::BoolPlug *PointsGridToPoints::clipPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+Gaffer::Box3fPlug *PointsGridToPoints::clipBoundPlug()
+{
+	return getChild<Box3fPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::Box3fPlug *PointsGridToPoints::clipBoundPlug() const
+{
+	return getChild<Box3fPlug>( g_firstPlugIndex + 4 );
+}
+
 void PointsGridToPoints::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
 
-	if( input == gridPlug() || input == namesPlug() || input == invertNamesPlug() )
+	if(
+		input == gridPlug() || input == namesPlug() || input == invertNamesPlug() ||
+		input == clipPlug() || clipBoundPlug()->isAncestorOf( input )
+	)
 	{
 		outputs.push_back( outPlug()->objectPlug() );
 	}
@@ -518,6 +577,11 @@ void PointsGridToPoints::hashProcessedObject( const ScenePath &path, const Gaffe
 	gridPlug()->hash( h );
 	namesPlug()->hash( h );
 	invertNamesPlug()->hash ( h );
+	clipPlug()->hash( h );
+	if( clipPlug()->getValue() )
+	{
+		clipBoundPlug()->hash( h );
+	}
 }
 
 IECore::ConstObjectPtr PointsGridToPoints::computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const
@@ -546,7 +610,20 @@ IECore::ConstObjectPtr PointsGridToPoints::computeProcessedObject( const ScenePa
 		return StringAlgo::matchMultiple( primitiveVariableName, names ) != invert;
 	};
 
-	IECoreScene::PointsPrimitivePtr points =  createPointsPrimitive( grid, primitiveVariableFilter );
+	IECoreScene::PointsPrimitivePtr points;
+	if( clipPlug()->getValue() )
+	{
+		const Box3f clipBound = clipBoundPlug()->getValue();
+		const openvdb::BBoxd vdbClipBound(
+			openvdb::Vec3d( clipBound.min.x, clipBound.min.y, clipBound.min.z ),
+			openvdb::Vec3d( clipBound.max.x, clipBound.max.y, clipBound.max.z )
+		);
+		points = createPointsPrimitive( grid, primitiveVariableFilter, &vdbClipBound );
+	}
+	else
+	{
+		points = createPointsPrimitive( grid, primitiveVariableFilter, nullptr );
+	}
 
 	if ( !points )
 	{
@@ -110,19 +110,33 @@ private:
 			return;
 		}
 
-		for( typename GridType::TreeType::NodeCIter iter = grid->tree().cbeginNode(); iter; ++iter )
+		// Only the leaf level is drawn, so we visit just the leaf nodes, and
+		// only query their topology. This means that delay-loaded leaf
+		// buffers are never read just to draw the viewer proxy.
+		bool haveLeaves = false;
+		for( typename GridType::TreeType::LeafCIter iter = grid->tree().cbeginLeaf(); iter; ++iter )
 		{
-			openvdb::CoordBBox bbox;
-			iter.getBoundingBox( bbox );
-
-			// Nodes are rendered as cell-centered
-			const openvdb::Vec3d min( bbox.min().x() - 0.5, bbox.min().y() - 0.5, bbox.min().z() - 0.5 );
-			const openvdb::Vec3d max( bbox.max().x() + 0.5, bbox.max().y() + 0.5, bbox.max().z() + 0.5 );
+			addCellCenteredBox( grid.get(), iter->getNodeBoundingBox() );
+			haveLeaves = true;
+		}
 
-			addBox( grid.get(), iter.getDepth(), min, max );
+		if( !haveLeaves && !grid->tree().empty() )
+		{
+			// Grids consisting solely of tiles are drawn as their
+			// active bound.
+			addCellCenteredBox( grid.get(), grid->evalActiveVoxelBoundingBox() );
 		}
 	}
 
+	template<typename GridType>
+	void addCellCenteredBox( const GridType *grid, const openvdb::CoordBBox &bbox )
+	{
+		const openvdb::Vec3d min( bbox.min().x() - 0.5, bbox.min().y() - 0.5, bbox.min().z() - 0.5 );
+		const openvdb::Vec3d max( bbox.max().x() + 0.5, bbox.max().y() + 0.5, bbox.max().z() + 0.5 );
+
+		addBox( grid, GridType::TreeType::DEPTH - 1, min, max );
+	}
+
 	void collectPoints( openvdb::GridBase::ConstPtr baseGrid )
 	{
 